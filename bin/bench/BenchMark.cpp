@@ -21,6 +21,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <BitAllocator.h>
 #include "BenchMark.h"
 
 BenchMark::BenchMark(int argc, char **argv)
@@ -89,6 +90,54 @@ BenchMark::Result BenchMark::exec()
     printf("release() Ticks: %u (%u AVG)\r\n",
             (u32)(t2 - t1), (u32)(t2 - t1) / 128);
 
+    // Search for free chunks in a mostly allocated bitmap
+    benchBitAllocator(true);
+    benchBitAllocator(false);
+
     // Done
     return Success;
 }
+
+void BenchMark::benchBitAllocator(const bool hierarchical) const
+{
+    const Size chunkCount = 1024 * 256;
+    const Size usedCount = chunkCount - (chunkCount / 8);
+    const Size iterations = 1000;
+    const Allocator::Range range = { 0x10000000, chunkCount * PAGESIZE, sizeof(u32) };
+    Allocator::Range args = { 0, usedCount * PAGESIZE, 0 };
+    u8 *bitmap = hierarchical ? ZERO : new u8[chunkCount / 8];
+    u64 t1 = 0, t2 = 0;
+
+    // The summary bitmap is only kept for an internally allocated array
+    BitAllocator *ba = new BitAllocator(range, PAGESIZE, bitmap);
+
+    // Fill most of the range and fragment the rest, except for the last chunks
+    ba->allocateFrom(args, 0);
+
+    for (Size i = usedCount + 1; i < chunkCount - 1024; i += 2)
+    {
+        ba->allocateAt(range.address + (i * PAGESIZE));
+    }
+
+    // Repeatedly search from the start for a single chunk and a run of chunks
+    t1 = timestamp();
+    for (Size i = 0; i < iterations; i++)
+    {
+        Allocator::Range single = { 0, PAGESIZE, 0 };
+        Allocator::Range run = { 0, PAGESIZE * 16, PAGESIZE * 16 };
+
+        ba->allocateFrom(single, 0);
+        ba->allocateFrom(run, 0);
+        ba->release(single.address);
+
+        for (Size j = 0; j < 16; j++)
+            ba->release(run.address + (j * PAGESIZE));
+    }
+    t2 = timestamp();
+    printf("BitAllocator (%s) Ticks: %u (%u AVG)\r\n",
+            hierarchical ? "hierarchical" : "flat",
+            (u32)(t2 - t1), (u32)(t2 - t1) / iterations);
+
+    delete ba;
+    delete[] bitmap;
+}
@@ -51,6 +51,15 @@ class BenchMark : public POSIXApplication
      * @return Result code
      */
     virtual Result exec();
+
+  private:
+
+    /**
+     * Benchmark the search for free chunks in a BitAllocator.
+     *
+     * @param hierarchical True to use the summary bitmap, false to search the flat bitmap.
+     */
+    void benchBitAllocator(const bool hierarchical) const;
 };
 
 /**
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <FreeNOS/BootTimeline.h>
+#include <ProcessClient.h>
+#include <stdio.h>
+#include "BootChart.h"
+
+BootChart::BootChart(int argc, char **argv)
+    : POSIXApplication(argc, argv)
+{
+    parser().setDescription("Print the boot timeline");
+}
+
+BootChart::~BootChart()
+{
+}
+
+BootChart::Result BootChart::exec()
+{
+    const SystemInformation info;
+    const ProcessClient process;
+    u8 *page = new u8[PAGESIZE];
+
+    if (!info.bootTimelineAddress)
+    {
+        ERROR("boot timeline not available");
+        delete[] page;
+        return NotFound;
+    }
+
+    // Copy the timeline page from the kernel
+    const API::Result result = VMCopy(SELF, API::ReadPhys, (Address) page,
+                                      info.bootTimelineAddress, PAGESIZE);
+    if (result != API::Success)
+    {
+        ERROR("failed to read boot timeline: result = " << (int) result);
+        delete[] page;
+        return IOError;
+    }
+
+    const BootTimelineHeader *header = (const BootTimelineHeader *) page;
+    const BootEvent *events = (const BootEvent *) (header + 1);
+
+    if (header->magic != BOOTTIMELINE_MAGIC || header->count == 0 ||
+        header->count > header->maximum)
+    {
+        ERROR("invalid boot timeline");
+        delete[] page;
+        return IOError;
+    }
+
+    const u64 start = events[0].timestamp;
+    const u64 total = events[header->count - 1].timestamp - start;
+
+    printf("%10s %10s %20s %s\r\n", "KCYCLES", "DELTA", "PROCESS", "EVENT");
+
+    // Print each event with a bar relative to the total boot time
+    for (Size i = 0; i < header->count; i++)
+    {
+        const BootEvent & event = events[i];
+        const u64 offset = event.timestamp - start;
+        const u64 delta = i > 0 ? event.timestamp - events[i - 1].timestamp : 0;
+        const Size bar = total ? (Size) ((delta * BarWidth) / total) : 0;
+        char bars[BarWidth + 1];
+        String source;
+
+        if (event.pid == KERNEL_PID)
+        {
+            source = "kernel";
+        }
+        else
+        {
+            ProcessClient::Info proc;
+
+            if (process.processInfo(event.pid, proc) == ProcessClient::Success)
+                source = proc.command.split(' ').first();
+            else
+                source << "PID " << (uint) event.pid;
+        }
+
+        for (Size j = 0; j < BarWidth; j++)
+            bars[j] = j < bar ? '#' : ' ';
+        bars[BarWidth] = ZERO;
+
+        printf("%10u %10u %20s %32s |%s|\r\n",
+               (uint) (offset / 1000), (uint) (delta / 1000),
+               *source, event.name, bars);
+    }
+
+    // Print a summary
+    printf("%u events, %u kcycles from kernel entry\r\n",
+           (uint) header->count, (uint) (total / 1000));
+
+    delete[] page;
+    return Success;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BIN_BOOTCHART_BOOTCHART_H
+#define __BIN_BOOTCHART_BOOTCHART_H
+
+#include <POSIXApplication.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Print the boot timeline.
+ *
+ * Shows each boot phase recorded by the kernel and the servers with its
+ * time since kernel entry and since the previous event, in thousands of
+ * cycle counter ticks.
+ */
+class BootChart : public POSIXApplication
+{
+  private:
+
+    /** Width in characters of the bars in the chart */
+    static const Size BarWidth = 32;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param argc Argument count
+     * @param argv Argument values
+     */
+    BootChart(int argc, char **argv);
+
+    /**
+     * Destructor
+     */
+    virtual ~BootChart();
+
+    /**
+     * Execute the application.
+     *
+     * @return Result code
+     */
+    virtual Result exec();
+};
+
+/**
+ * @}
+ */
+
+#endif /* __BIN_BOOTCHART_BOOTCHART_H */
@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <BufferedFile.h>
 #include "Cat.h"
 
 Cat::Cat(int argc, char **argv)
@@ -63,8 +64,6 @@ Cat::Result Cat::exec()
 
 Cat::Result Cat::cat(const char *file) const
 {
-    char buf[1024];
-    int fd, e;
     struct stat st;
     const char *name = *(parser().name());
 
@@ -85,41 +84,39 @@ Cat::Result Cat::cat(const char *file) const
         return InvalidArgument;
     }
 
-    // Clear buffer
-    memset(buf, 0, sizeof(buf));
-
     // Attempt to open the file first
-    if ((fd = open(file, O_RDONLY)) < 0)
+    BufferedFile input(file);
+    if (input.open() != BufferedFile::Success)
     {
         printf("%s: failed to open '%s': %s\r\n",
                 name, file, strerror(errno));
         return IOError;
     }
 
-    // Read contents
+    // Stream contents in chunks to standard output
     while (1)
     {
-        e = read(fd, buf, sizeof(buf) - 1);
-        switch (e)
+        const void *chunk;
+        Size size;
+
+        if (input.next(chunk, size) != BufferedFile::Success)
+        {
+            printf("%s: failed to read '%s': %s\r\n",
+                    name, file, strerror(errno));
+            return IOError;
+        }
+
+        // End of file
+        if (size == 0)
+        {
+            return Success;
+        }
+
+        if (write(1, chunk, size) != (ssize_t) size)
         {
-            // Error occurred
-            case -1:
-                printf("%s: failed to read '%s': %s\r\n",
-                        name, file, strerror(errno));
-                close(fd);
-                return IOError;
-    
-            // End of file
-            case 0:
-                close(fd);
-                return Success;
-
-            // Output data
-            default:
-                buf[e] = 0;
-                printf("%s", buf);
-                break;
+            printf("%s: failed to write output: %s\r\n",
+                    name, strerror(errno));
+            return IOError;
         }
     }
-    return InvalidArgument;
 }
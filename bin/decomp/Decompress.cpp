@@ -72,8 +72,8 @@ Decompress::Result Decompress::decompressFile(const String inputFilename) const
     BufferedFile input(*inputFilename);
     BufferedFile output(*outputFilename);
 
-    // Read the input file
-    if (input.read() != BufferedFile::Success)
+    // Map the input file
+    if (input.map() != BufferedFile::Success)
     {
         ERROR("failed to read input file " << input.path());
         return IOError;
@@ -0,0 +1,551 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <MemoryBlock.h>
+#include "FileSystemBenchmark.h"
+
+/** Block sizes used for the throughput tests */
+static const Size blockSizes[] = { 512, 4096, 16384, 65536 };
+
+FileSystemBenchmark::FileSystemBenchmark(int argc, char **argv)
+    : POSIXApplication(argc, argv)
+    , m_size(DefaultSize)
+    , m_files(DefaultFiles)
+    , m_processes(DefaultProcesses)
+{
+    parser().setDescription("Measure file system performance");
+    parser().registerPositional("DIRECTORY", "Directory on the file system to measure");
+    parser().registerFlag('s', "size", "Bytes per file for throughput tests (--size=BYTES)");
+    parser().registerFlag('n', "files", "Number of files for metadata tests (--files=COUNT)");
+    parser().registerFlag('p', "processes", "Number of concurrent processes (--processes=COUNT)");
+    parser().registerFlag('w', "worker", "Run as worker process (--worker=INDEX)");
+}
+
+FileSystemBenchmark::~FileSystemBenchmark()
+{
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::initialize()
+{
+    const char *size = arguments().get("size");
+    const char *files = arguments().get("files");
+    const char *processes = arguments().get("processes");
+
+    if (size && atoi(size) > 0)
+        m_size = atoi(size);
+
+    if (files && atoi(files) > 0)
+        m_files = atoi(files);
+
+    if (processes && atoi(processes) > 0)
+        m_processes = atoi(processes);
+
+    return Success;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::exec()
+{
+    const char *directory = arguments().get("DIRECTORY");
+    const char *workerIndex = arguments().get("worker");
+    Result result = Success;
+    String path;
+
+    if (workerIndex)
+    {
+        return worker(directory, atoi(workerIndex));
+    }
+
+    printf("fsbench: %s: %u bytes per file, %u files, %u processes\r\n",
+           directory, (uint) m_size, (uint) m_files, (uint) m_processes);
+
+    path << directory << "/fsbench.dat";
+
+    if (createFile(*path) == Success)
+    {
+        // Throughput tests on a new file
+        for (Size i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]) && result == Success; i++)
+        {
+            result = sequentialWrite(*path, blockSizes[i]);
+            if (result == Success)
+                result = sequentialRead(*path, blockSizes[i], m_size);
+        }
+
+        for (Size i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]) && result == Success; i++)
+        {
+            result = randomWrite(*path, blockSizes[i]);
+            if (result == Success)
+                result = randomRead(*path, blockSizes[i], m_size);
+        }
+        unlink(*path);
+
+        // Metadata and concurrency tests
+        if (result == Success)
+            result = metadata(directory);
+
+        if (result == Success)
+            result = concurrent(directory);
+    }
+    else
+    {
+        Size size = 0;
+
+        // Read-only file system: measure reads of an existing file
+        printf("fsbench: %s: not writable, using existing files\r\n", directory);
+        result = findLargest(directory, path, size);
+
+        for (Size i = 0; i < sizeof(blockSizes) / sizeof(blockSizes[0]) && result == Success; i++)
+        {
+            result = sequentialRead(*path, blockSizes[i], size);
+            if (result == Success)
+                result = randomRead(*path, blockSizes[i], size);
+        }
+
+        if (result == Success)
+            result = listDirectory(directory);
+    }
+
+    summary();
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::sequentialWrite(const char *path,
+                                                                 const Size blockSize)
+{
+    u8 *buffer = new u8[blockSize];
+    Result result = Success;
+    int fd;
+
+    MemoryBlock::set(buffer, 0xaa, blockSize);
+
+    if ((fd = open(path, O_RDWR)) == -1)
+    {
+        ERROR("failed to open " << path << ": " << strerror(errno));
+        delete[] buffer;
+        return IOError;
+    }
+    ftruncate(fd, 0);
+
+    const u64 start = now();
+
+    for (Size done = 0; done < m_size; done += blockSize)
+    {
+        if (write(fd, buffer, blockSize) != (ssize_t) blockSize)
+        {
+            ERROR("failed to write " << path << ": " << strerror(errno));
+            result = IOError;
+            break;
+        }
+    }
+
+    if (result == Success)
+        report("seqwrite", blockSize, m_size, true, start);
+
+    close(fd);
+    delete[] buffer;
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::sequentialRead(const char *path,
+                                                                const Size blockSize,
+                                                                const Size size)
+{
+    u8 *buffer = new u8[blockSize];
+    Size total = 0;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) == -1)
+    {
+        ERROR("failed to open " << path << ": " << strerror(errno));
+        delete[] buffer;
+        return IOError;
+    }
+
+    const u64 start = now();
+
+    while (total < size)
+    {
+        const ssize_t num = read(fd, buffer, blockSize);
+        if (num < 0)
+        {
+            ERROR("failed to read " << path << ": " << strerror(errno));
+            close(fd);
+            delete[] buffer;
+            return IOError;
+        }
+        else if (num == 0)
+        {
+            break;
+        }
+        total += num;
+    }
+
+    report("seqread", blockSize, total, true, start);
+    close(fd);
+    delete[] buffer;
+    return Success;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::randomWrite(const char *path,
+                                                             const Size blockSize)
+{
+    const Size blocks = m_size / blockSize;
+    u8 *buffer = new u8[blockSize];
+    Result result = Success;
+    int fd;
+
+    if (blocks == 0)
+    {
+        delete[] buffer;
+        return Success;
+    }
+    MemoryBlock::set(buffer, 0x55, blockSize);
+
+    if ((fd = open(path, O_RDWR)) == -1)
+    {
+        ERROR("failed to open " << path << ": " << strerror(errno));
+        delete[] buffer;
+        return IOError;
+    }
+
+    const u64 start = now();
+
+    for (Size i = 0; i < blocks; i++)
+    {
+        const off_t offset = (random() % blocks) * blockSize;
+
+        if (pwrite(fd, buffer, blockSize, offset) != (ssize_t) blockSize)
+        {
+            ERROR("failed to write " << path << ": " << strerror(errno));
+            result = IOError;
+            break;
+        }
+    }
+
+    if (result == Success)
+        report("randwrite", blockSize, blocks * blockSize, true, start);
+
+    close(fd);
+    delete[] buffer;
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::randomRead(const char *path,
+                                                            const Size blockSize,
+                                                            const Size size)
+{
+    const Size blocks = size / blockSize;
+    u8 *buffer = new u8[blockSize];
+    Result result = Success;
+    int fd;
+
+    if (blocks == 0)
+    {
+        delete[] buffer;
+        return Success;
+    }
+
+    if ((fd = open(path, O_RDONLY)) == -1)
+    {
+        ERROR("failed to open " << path << ": " << strerror(errno));
+        delete[] buffer;
+        return IOError;
+    }
+
+    const u64 start = now();
+
+    for (Size i = 0; i < blocks; i++)
+    {
+        const off_t offset = (random() % blocks) * blockSize;
+
+        if (pread(fd, buffer, blockSize, offset) != (ssize_t) blockSize)
+        {
+            ERROR("failed to read " << path << ": " << strerror(errno));
+            result = IOError;
+            break;
+        }
+    }
+
+    if (result == Success)
+        report("randread", blockSize, blocks * blockSize, true, start);
+
+    close(fd);
+    delete[] buffer;
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::metadata(const char *directory)
+{
+    Vector<String *> paths(m_files);
+    struct stat st;
+    Result result = Success;
+    u64 start;
+
+    for (Size i = 0; i < m_files; i++)
+    {
+        String *path = new String();
+        (*path) << directory << "/fsbench." << i;
+        paths.insert(path);
+    }
+
+    // Create files
+    start = now();
+    for (Size i = 0; i < m_files && result == Success; i++)
+        result = createFile(*(*paths[i]));
+    if (result == Success)
+        report("create", 0, m_files, false, start);
+
+    // Retrieve file status
+    start = now();
+    for (Size i = 0; i < m_files && result == Success; i++)
+    {
+        if (stat(*(*paths[i]), &st) != 0)
+        {
+            ERROR("failed to stat " << *(*paths[i]) << ": " << strerror(errno));
+            result = IOError;
+        }
+    }
+    if (result == Success)
+        report("stat", 0, m_files, false, start);
+
+    // List the directory with all files present
+    if (result == Success)
+        result = listDirectory(directory);
+
+    // Remove files
+    start = now();
+    for (Size i = 0; i < m_files; i++)
+    {
+        if (unlink(*(*paths[i])) != 0 && result == Success)
+        {
+            ERROR("failed to unlink " << *(*paths[i]) << ": " << strerror(errno));
+            result = IOError;
+        }
+        delete paths[i];
+    }
+    if (result == Success)
+        report("unlink", 0, m_files, false, start);
+
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::listDirectory(const char *directory)
+{
+    Size entries = 0;
+    const u64 start = now();
+
+    for (Size i = 0; i < ListRepeat; i++)
+    {
+        DIR *dir = opendir(directory);
+        if (!dir)
+        {
+            ERROR("failed to open directory " << directory << ": " << strerror(errno));
+            return IOError;
+        }
+
+        while (readdir(dir) != ZERO)
+            entries++;
+
+        closedir(dir);
+    }
+
+    report("readdir", 0, entries, false, start);
+    return Success;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::concurrent(const char *directory)
+{
+    Vector<pid_t> pids(m_processes);
+    String size, index;
+    Result result = Success;
+    int status;
+
+    size << "--size=" << m_size;
+
+    const u64 start = now();
+
+    // Start all workers
+    for (Size i = 0; i < m_processes; i++)
+    {
+        index = "--worker=";
+        index << i;
+        const char *argv[] = { "/bin/fsbench", *index, *size, directory, ZERO };
+
+        const pid_t pid = forkexec(argv[0], argv);
+        if (pid == (pid_t) -1)
+        {
+            ERROR("failed to start worker: " << strerror(errno));
+            result = IOError;
+            break;
+        }
+        pids.insert(pid);
+    }
+
+    // Wait for all workers to complete
+    for (Size i = 0; i < pids.count(); i++)
+    {
+        if (waitpid(pids[i], &status, 0) == (pid_t) -1 || status != Success)
+        {
+            ERROR("worker " << i << " failed");
+            result = IOError;
+        }
+    }
+
+    if (result == Success)
+        report("concurrent", 4096, m_processes * m_size * 2, true, start);
+
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::worker(const char *directory, const Size index)
+{
+    const Size blockSize = 4096;
+    u8 *buffer = new u8[blockSize];
+    Result result = Success;
+    String path;
+    int fd;
+
+    path << directory << "/fsbench.worker." << index;
+    MemoryBlock::set(buffer, index, blockSize);
+
+    if (createFile(*path) != Success || (fd = open(*path, O_RDWR)) == -1)
+    {
+        delete[] buffer;
+        return IOError;
+    }
+
+    // Write the file, then read it back
+    for (Size done = 0; done < m_size && result == Success; done += blockSize)
+    {
+        if (write(fd, buffer, blockSize) != (ssize_t) blockSize)
+            result = IOError;
+    }
+
+    for (Size done = 0; done < m_size && result == Success; done += blockSize)
+    {
+        if (pread(fd, buffer, blockSize, done) != (ssize_t) blockSize)
+            result = IOError;
+    }
+
+    close(fd);
+    unlink(*path);
+    delete[] buffer;
+    return result;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::findLargest(const char *directory,
+                                                             String & path,
+                                                             Size & size) const
+{
+    struct dirent *entry;
+    struct stat st;
+    DIR *dir;
+
+    if (!(dir = opendir(directory)))
+    {
+        ERROR("failed to open directory " << directory << ": " << strerror(errno));
+        return IOError;
+    }
+
+    size = 0;
+
+    while ((entry = readdir(dir)) != ZERO)
+    {
+        String file;
+        file << directory << "/" << entry->d_name;
+
+        if (entry->d_type == DT_REG && stat(*file, &st) == 0 && (Size) st.st_size > size)
+        {
+            size = st.st_size;
+            path = file;
+        }
+    }
+    closedir(dir);
+
+    if (size == 0)
+    {
+        ERROR("no regular files found in " << directory);
+        return NotFound;
+    }
+
+    printf("fsbench: %s: %u bytes\r\n", *path, (uint) size);
+    return Success;
+}
+
+FileSystemBenchmark::Result FileSystemBenchmark::createFile(const char *path) const
+{
+    return creat(path, S_IRUSR | S_IWUSR) == 0 ? Success : IOError;
+}
+
+void FileSystemBenchmark::report(const char *test,
+                                 const Size blockSize,
+                                 const Size amount,
+                                 const bool bytes,
+                                 const u64 start)
+{
+    Measurement m;
+    m.test      = test;
+    m.blockSize = blockSize;
+    m.amount    = amount;
+    m.usec      = now() - start;
+
+    const u64 usec = m.usec ? m.usec : 1;
+
+    if (bytes)
+    {
+        printf("%s %u: %u bytes in %u usec, %u KiB/s\r\n", test, (uint) blockSize,
+               (uint) amount, (uint) m.usec, (uint) ((((u64) amount) * 1000000) / usec / 1024));
+    }
+    else
+    {
+        printf("%s: %u ops in %u usec, %u ops/s\r\n", test,
+               (uint) amount, (uint) m.usec, (uint) ((((u64) amount) * 1000000) / usec));
+    }
+
+    m_results.insert(m);
+}
+
+void FileSystemBenchmark::summary() const
+{
+    printf("# test,block,amount,usec\r\n");
+
+    for (Size i = 0; i < m_results.count(); i++)
+    {
+        const Measurement & m = m_results[i];
+
+        printf("%s,%u,%u,%u\r\n", m.test, (uint) m.blockSize,
+               (uint) m.amount, (uint) m.usec);
+    }
+}
+
+u64 FileSystemBenchmark::now() const
+{
+    struct timeval tv;
+    struct timezone tz;
+
+    gettimeofday(&tv, &tz);
+    return ((u64) tv.tv_sec * 1000000) + tv.tv_usec;
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __BIN_FSBENCH_FILESYSTEMBENCHMARK_H
+#define __BIN_FSBENCH_FILESYSTEMBENCHMARK_H
+
+#include <POSIXApplication.h>
+#include <Vector.h>
+
+/**
+ * @addtogroup bin
+ * @{
+ */
+
+/**
+ * Measure the performance of a file system.
+ *
+ * Measures sequential and random I/O throughput at various block sizes,
+ * file create, stat and unlink rates, directory listing speed and
+ * throughput of multiple concurrent processes. On read-only file systems
+ * only the read and directory listing tests are performed, using the
+ * largest file found in the directory.
+ *
+ * Results are printed while running, followed by a summary
+ * with one comma separated line per measurement.
+ */
+class FileSystemBenchmark : public POSIXApplication
+{
+  private:
+
+    /** Default number of bytes per file for throughput tests */
+    static const Size DefaultSize = 256 * 1024;
+
+    /** Default number of files for metadata tests */
+    static const Size DefaultFiles = 64;
+
+    /** Default number of concurrent processes */
+    static const Size DefaultProcesses = 4;
+
+    /** Number of times the directory is listed */
+    static const Size ListRepeat = 10;
+
+    /**
+     * A single benchmark result.
+     */
+    struct Measurement
+    {
+        const char *test;  /**@< Name of the test */
+        Size blockSize;    /**@< Block size in bytes or zero */
+        Size amount;       /**@< Number of bytes or operations */
+        u64 usec;          /**@< Time taken in microseconds */
+
+        /**
+         * Comparison operator.
+         *
+         * @param m Measurement to compare with
+         */
+        bool operator == (const Measurement & m) const
+        {
+            return test == m.test && blockSize == m.blockSize &&
+                   amount == m.amount && usec == m.usec;
+        }
+
+        /**
+         * Inequality operator.
+         *
+         * @param m Measurement to compare with
+         */
+        bool operator != (const Measurement & m) const
+        {
+            return !(*this == m);
+        }
+    };
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param argc Argument count
+     * @param argv Argument values
+     */
+    FileSystemBenchmark(int argc, char **argv);
+
+    /**
+     * Destructor
+     */
+    virtual ~FileSystemBenchmark();
+
+    /**
+     * Initialize the application.
+     *
+     * @return Result code
+     */
+    virtual Result initialize();
+
+    /**
+     * Execute the application.
+     *
+     * @return Result code
+     */
+    virtual Result exec();
+
+  private:
+
+    /**
+     * Write a file sequentially.
+     *
+     * @param path Path to the file
+     * @param blockSize Number of bytes per write
+     *
+     * @return Result code
+     */
+    Result sequentialWrite(const char *path, const Size blockSize);
+
+    /**
+     * Read a file sequentially.
+     *
+     * @param path Path to the file
+     * @param blockSize Number of bytes per read
+     * @param size Number of bytes to read
+     *
+     * @return Result code
+     */
+    Result sequentialRead(const char *path, const Size blockSize, const Size size);
+
+    /**
+     * Write blocks at random offsets in a file.
+     *
+     * @param path Path to the file
+     * @param blockSize Number of bytes per write
+     *
+     * @return Result code
+     */
+    Result randomWrite(const char *path, const Size blockSize);
+
+    /**
+     * Read blocks at random offsets in a file.
+     *
+     * @param path Path to the file
+     * @param blockSize Number of bytes per read
+     * @param size Size of the file in bytes
+     *
+     * @return Result code
+     */
+    Result randomRead(const char *path, const Size blockSize, const Size size);
+
+    /**
+     * Create, stat, list and unlink a number of files.
+     *
+     * @param directory Directory to create the files in
+     *
+     * @return Result code
+     */
+    Result metadata(const char *directory);
+
+    /**
+     * List a directory repeatedly.
+     *
+     * @param directory Directory to list
+     *
+     * @return Result code
+     */
+    Result listDirectory(const char *directory);
+
+    /**
+     * Run worker processes concurrently.
+     *
+     * @param directory Directory for the worker files
+     *
+     * @return Result code
+     */
+    Result concurrent(const char *directory);
+
+    /**
+     * Write and read back a file as a worker process.
+     *
+     * @param directory Directory for the worker file
+     * @param index Worker index
+     *
+     * @return Result code
+     */
+    Result worker(const char *directory, const Size index);
+
+    /**
+     * Find the largest regular file in a directory.
+     *
+     * @param directory Directory to search
+     * @param path On output, path to the largest file
+     * @param size On output, size of the largest file
+     *
+     * @return Result code
+     */
+    Result findLargest(const char *directory, String & path, Size & size) const;
+
+    /**
+     * Create an empty file.
+     *
+     * @param path Path to the file
+     *
+     * @return Result code
+     */
+    Result createFile(const char *path) const;
+
+    /**
+     * Record and print a measurement.
+     *
+     * @param test Name of the test
+     * @param blockSize Block size in bytes or zero
+     * @param amount Number of bytes or operations
+     * @param bytes True if amount is in bytes, false for operations
+     * @param start Timestamp in microseconds when the test started
+     */
+    void report(const char *test,
+                const Size blockSize,
+                const Size amount,
+                const bool bytes,
+                const u64 start);
+
+    /**
+     * Print the summary of all measurements.
+     */
+    void summary() const;
+
+    /**
+     * Get current time.
+     *
+     * @return Time in microseconds
+     */
+    u64 now() const;
+
+  private:
+
+    /** Number of bytes per file for throughput tests */
+    Size m_size;
+
+    /** Number of files for metadata tests */
+    Size m_files;
+
+    /** Number of concurrent processes */
+    Size m_processes;
+
+    /** Contains all measurements */
+    Vector<Measurement> m_results;
+};
+
+/**
+ * @}
+ */
+
+#endif /* __BIN_FSBENCH_FILESYSTEMBENCHMARK_H */
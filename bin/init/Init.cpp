@@ -15,11 +15,19 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <FreeNOS/User.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
+#include <MemoryBlock.h>
+#include <BufferedFile.h>
+#include <ListIterator.h>
+#ifndef __HOST__
+#include <FileSystemClient.h>
+#endif /* __HOST__ */
 #include "Init.h"
 
 Init::Init(int argc, char **argv)
@@ -27,19 +35,36 @@ Init::Init(int argc, char **argv)
 {
     parser().setDescription("Initialize system processes");
     parser().registerFlag('s', "script", "Set shell startup script");
+    parser().registerFlag('m', "manifest", "Set service manifest");
 }
 
 Init::~Init()
 {
+    for (ListIterator<Service *> i(m_services); i.hasCurrent(); i++)
+    {
+        delete i.current();
+    }
 }
 
 Init::Result Init::exec()
 {
     const char *script = arguments().get("script") ?
                          arguments().get("script") : "/etc/init.sh";
+    const char *manifest = arguments().get("manifest") ?
+                           arguments().get("manifest") : "/etc/init.conf";
     const char *av[] = { "/bin/sh", script, ZERO };
     int pid, status;
 
+    // Start services from the manifest, if any
+    if (loadServices(manifest) == Success)
+    {
+        NOTICE("Starting services: " << manifest);
+        ProcessCtl(SELF, RecordBootEvent, (Address) "init services");
+        startServices();
+    }
+
+    ProcessCtl(SELF, RecordBootEvent, (Address) "init script");
+
     NOTICE("Starting init script: " << script);
 
     // Execute the run commands file
@@ -54,3 +79,258 @@ Init::Result Init::exec()
     waitpid(pid, &status, 0);
     return Success;
 }
+
+Init::Result Init::loadServices(const char *path)
+{
+    struct stat st;
+
+    // The manifest is optional
+    if (stat(path, &st) != 0)
+    {
+        return NotFound;
+    }
+
+    BufferedFile file(path);
+    if (file.read() != BufferedFile::Success)
+    {
+        return IOError;
+    }
+
+    // Copy the contents into a null terminated string
+    char *text = new char[file.size() + 1];
+    MemoryBlock::copy(text, file.buffer(), file.size());
+    text[file.size()] = ZERO;
+
+    const String contents(text, false);
+    const List<String> lines = contents.split('\n');
+
+    // Parse each line into a service
+    for (ListIterator<String> i(lines); i.hasCurrent(); i++)
+    {
+        const List<String> fields = i.current().split(' ');
+
+        // Skip empty lines and comments
+        if (fields.count() == 0 || fields.first().startsWith("#"))
+        {
+            continue;
+        }
+        else if (fields.count() < 3)
+        {
+            ERROR("invalid line in " << path << ": " << *i.current());
+            continue;
+        }
+
+        Service *service = new Service;
+        service->started = false;
+        Size field = 0;
+
+        for (ListIterator<String> f(fields); f.hasCurrent(); f++, field++)
+        {
+            if (field == 0)
+                service->provides = f.current();
+            else if (field == 1 && f.current() != "-")
+            {
+                const List<String> requires = f.current().split(',');
+
+                for (ListIterator<String> r(requires); r.hasCurrent(); r++)
+                    service->requires.append(r.current());
+            }
+            else if (field >= 2)
+                service->command.append(f.current());
+        }
+
+        m_services.append(service);
+    }
+
+    delete[] text;
+    return Success;
+}
+
+Init::Result Init::startServices()
+{
+    while (true)
+    {
+        // Start all services of which the dependencies are ready
+        for (ListIterator<Service *> i(m_services); i.hasCurrent(); i++)
+        {
+            Service *service = i.current();
+
+            if (service->started)
+            {
+                continue;
+            }
+
+            switch (checkDependencies(service))
+            {
+                case Ready:
+                    startService(service);
+                    break;
+
+                case Failed:
+                    ERROR("not starting " << *service->command.first() <<
+                          ": dependency failed");
+                    service->started = true;
+                    break;
+
+                case Waiting:
+                    break;
+            }
+        }
+
+        // Nothing left to wait for: resolve paths not provided by any service
+        if (m_pending.count() == 0)
+        {
+            bool resolved = false;
+
+            for (ListIterator<Service *> i(m_services); i.hasCurrent(); i++)
+            {
+                if (i.current()->started)
+                    continue;
+
+                for (ListIterator<String> r(i.current()->requires); r.hasCurrent(); r++)
+                {
+                    const String & path = r.current();
+
+                    if (m_ready.contains(path) || m_failed.contains(path) || isProvided(path))
+                        continue;
+
+                    if (isMounted(path))
+                        m_ready.append(path);
+                    else
+                    {
+                        ERROR("required path " << *path << " is not provided by any service");
+                        m_failed.append(path);
+                    }
+                    resolved = true;
+                }
+            }
+
+            if (resolved)
+            {
+                continue;
+            }
+
+            // Remaining services wait for each other and can never start
+            for (ListIterator<Service *> i(m_services); i.hasCurrent(); i++)
+            {
+                Service *service = i.current();
+
+                if (service->started)
+                    continue;
+
+                ERROR("not starting " << *service->command.first() <<
+                      ": cyclic dependency");
+                service->started = true;
+
+                if (service->provides != "-")
+                    m_failed.append(service->provides);
+            }
+            break;
+        }
+
+        // Wait for the first pending path
+        const String path = m_pending.first();
+        m_pending.remove(path);
+
+        if (waitForMount(path) == Success)
+            m_ready.append(path);
+        else
+            m_failed.append(path);
+    }
+
+    return Success;
+}
+
+Init::Result Init::startService(Service *service)
+{
+    const char **argv = new const char *[service->command.count() + 1];
+    Size argc = 0;
+
+    for (ListIterator<String> i(service->command); i.hasCurrent(); i++)
+    {
+        argv[argc++] = *i.current();
+    }
+    argv[argc] = ZERO;
+
+    service->started = true;
+    const int pid = runProgram(argv[0], argv);
+    delete[] argv;
+
+    if (pid == -1)
+    {
+        ERROR("failed to start " << *service->command.first() << ": " << strerror(errno));
+
+        if (service->provides != "-")
+            m_failed.append(service->provides);
+
+        return IOError;
+    }
+
+    DEBUG("started " << *service->command.first() << " PID " << pid);
+
+    if (service->provides != "-")
+        m_pending.append(service->provides);
+
+    return Success;
+}
+
+Init::DependencyState Init::checkDependencies(const Service *service) const
+{
+    DependencyState state = Ready;
+
+    for (ListIterator<String> i(service->requires); i.hasCurrent(); i++)
+    {
+        if (m_failed.contains(i.current()))
+            return Failed;
+        else if (!m_ready.contains(i.current()))
+            state = Waiting;
+    }
+
+    return state;
+}
+
+bool Init::isProvided(const String & path) const
+{
+    for (ListIterator<Service *> i(m_services); i.hasCurrent(); i++)
+    {
+        if (i.current()->provides == path)
+            return true;
+    }
+
+    return false;
+}
+
+bool Init::isMounted(const String & path) const
+{
+#ifndef __HOST__
+    const FileSystemClient filesystem;
+    Size numberOfMounts = 0;
+    const FileSystemMount *mounts = filesystem.getFileSystems(numberOfMounts);
+
+    for (Size i = 0; mounts != NULL && i < numberOfMounts; i++)
+    {
+        if (mounts[i].path[0] && path == mounts[i].path)
+            return true;
+    }
+
+    return false;
+#else
+    return true;
+#endif /* __HOST__ */
+}
+
+Init::Result Init::waitForMount(const String & path) const
+{
+#ifndef __HOST__
+    const FileSystemClient filesystem;
+    const FileSystem::Result result = filesystem.waitFileSystem(*path);
+
+    if (result != FileSystem::Success)
+    {
+        ERROR("failed to wait for filesystem at " << *path << ": result = " << (int) result);
+        return IOError;
+    }
+#endif /* __HOST__ */
+
+    return Success;
+}
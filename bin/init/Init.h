@@ -19,6 +19,8 @@
 #define __BIN_INIT_INIT_H
 
 #include <POSIXApplication.h>
+#include <List.h>
+#include <String.h>
 
 /**
  * @addtogroup bin
@@ -27,9 +29,52 @@
 
 /**
  * Initialize system processes.
+ *
+ * Init first starts the services listed in the service manifest.
+ * Each line in the manifest contains the path which the service mounts
+ * when it is ready, a comma separated list of paths it requires (or '-')
+ * and the command to run, separated by spaces:
+ *
+ *    /console  /dev/ps2,/dev/video  /server/terminal/server
+ *
+ * A service is started as soon as all of its required paths are mounted,
+ * such that independent services run concurrently. Services which require
+ * a path that no service provides and is not mounted, or which depend on
+ * each other, are reported and not started. When all services are ready,
+ * init executes the startup script with the shell.
  */
 class Init : public POSIXApplication
 {
+  private:
+
+    /**
+     * Describes a service in the manifest.
+     */
+    struct Service
+    {
+        /** Path mounted by the service when ready or '-' for none. */
+        String provides;
+
+        /** Paths which must be mounted before starting the service. */
+        List<String> requires;
+
+        /** Program path and arguments. */
+        List<String> command;
+
+        /** True if the service is started (or has failed to start). */
+        bool started;
+    };
+
+    /**
+     * Dependency states of a service.
+     */
+    enum DependencyState
+    {
+        Ready,
+        Waiting,
+        Failed
+    };
+
   public:
 
     /**
@@ -51,6 +96,87 @@ class Init : public POSIXApplication
      * @return Result code
      */
     virtual Result exec();
+
+  private:
+
+    /**
+     * Read the service manifest.
+     *
+     * @param path Path to the manifest file
+     *
+     * @return Result code
+     */
+    Result loadServices(const char *path);
+
+    /**
+     * Start all services in dependency order.
+     *
+     * Returns when all services are started and have mounted
+     * the path they provide, or failed to do so. Required paths which
+     * can never be mounted fail instead of blocking.
+     *
+     * @return Result code
+     */
+    Result startServices();
+
+    /**
+     * Start a single service.
+     *
+     * @param service Service to start
+     *
+     * @return Result code
+     */
+    Result startService(Service *service);
+
+    /**
+     * Get the dependency state of a service.
+     *
+     * @param service Service to check
+     *
+     * @return DependencyState value
+     */
+    DependencyState checkDependencies(const Service *service) const;
+
+    /**
+     * Check if a path is provided by any service in the manifest.
+     *
+     * @param path Mount path to check
+     *
+     * @return True if provided by a service, false otherwise
+     */
+    bool isProvided(const String & path) const;
+
+    /**
+     * Check if a file system is currently mounted at the given path.
+     *
+     * @param path Mount path to check
+     *
+     * @return True if mounted, false otherwise
+     */
+    bool isMounted(const String & path) const;
+
+    /**
+     * Wait until a file system is mounted at the given path.
+     *
+     * @param path Mount path to wait for
+     *
+     * @return Result code
+     */
+    Result waitForMount(const String & path) const;
+
+  private:
+
+    /** Services from the manifest */
+    List<Service *> m_services;
+
+    /** Paths provided by started services which are not yet mounted */
+    List<String> m_pending;
+
+    /** Paths which are mounted */
+    List<String> m_ready;
+
+    /** Paths which failed to mount */
+    List<String> m_failed;
 };
 
 /**
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Types.h>
+#include <Macros.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <ProcessClient.h>
+#include "MemoryStat.h"
+
+MemoryStat::MemoryStat(int argc, char **argv)
+    : POSIXApplication(argc, argv)
+{
+    parser().setDescription("Output physical memory usage per process");
+}
+
+MemoryStat::Result MemoryStat::exec()
+{
+    const ProcessClient process;
+    String out;
+
+    // Print header
+    out << "ID    IMAGE   HEAP  STACK MAPPED  SHARE   RSVD  TOTAL (KB) CMD\r\n";
+
+    // Loop processes
+    for (ProcessID pid = 0; pid < ProcessClient::MaximumProcesses; pid++)
+    {
+        ProcessClient::Info info;
+        MemoryContext::Usage mem;
+
+        if (process.processInfo(pid, info) != ProcessClient::Success ||
+            process.memoryUsage(pid, mem) != ProcessClient::Success)
+        {
+            continue;
+        }
+
+        const Size total = mem.image + mem.heap + mem.stack +
+                           mem.mapped + mem.share;
+
+        // Output a line
+        char line[128];
+        snprintf(line, sizeof(line),
+                "%3d %7u %6u %6u %6u %6u %6u %6u      %s\r\n",
+                 pid,
+                 mem.image / 1024,
+                 mem.heap / 1024,
+                 mem.stack / 1024,
+                 mem.mapped / 1024,
+                 mem.share / 1024,
+                 mem.reserved / 1024,
+                 total / 1024,
+                 *info.command);
+        out << line;
+    }
+
+    // Output the table
+    write(1, *out, out.length());
+    return Success;
+}
@@ -1,23 +1,12 @@
 #
-# Use serial port as console.
+# System servers and drivers are started by init
+# from /etc/init.conf before running this script.
 #
-/server/serial/server &
-/bin/mount --wait=/dev/serial
-stdio /dev/serial/serial0/io /dev/serial/serial0/io
 
 #
-# System Servers and Drivers.
+# Use serial port as console.
 #
-/server/filesystem/tmp/server /tmp &
-/bin/mount --wait=/tmp
-
-/server/network/loopback/server &
-/bin/mount --wait=/network/loopback
-
-/server/network/sun8i/server &
-/bin/mount --wait=/network/sun8i
-
-/server/mpiproxy/server sun8i &
+stdio /dev/serial/serial0/io /dev/serial/serial0/io
 
 # This ensures we wait until all cores
 # are booted by the CoreServer.
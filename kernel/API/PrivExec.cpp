@@ -17,6 +17,7 @@
 
 #include <FreeNOS/System.h>
 #include <FreeNOS/ProcessManager.h>
+#include <SplitAllocator.h>
 #include <Log.h>
 #include "PrivExec.h"
 
@@ -50,6 +51,12 @@ API::Result PrivExecHandler(const PrivOperation op,
         FATAL("panic in PID " << Kernel::instance()->getProcessManager()->current()->getID());
         return API::Success;
 
+    case ZeroPages:
+        // Zero a few pages at a time, such that interrupts are not held off for long
+        if (Kernel::instance()->getAllocator()->zeroPages(4) == 0)
+            return API::NotFound;
+        return API::Success;
+
     default:
         ;
     }
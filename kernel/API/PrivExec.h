@@ -37,7 +37,8 @@ typedef enum PrivOperation
     RebootSystem   = 1,
     ShutdownSystem = 2,
     WriteConsole   = 3,
-    Panic          = 4
+    Panic          = 4,
+    ZeroPages      = 5
 }
 PrivOperation;
 
@@ -48,6 +49,7 @@ PrivOperation;
  * @param param Optional parameter value for the given operation
  *
  * @return API::Success on success and other API::ErrorCode on failure.
+ *         For ZeroPages, API::NotFound if no more pages can be zeroed.
  */
 inline API::Result PrivExec(const PrivOperation op,
                             const Address param = 0)
@@ -21,6 +21,7 @@
 #include <FreeNOS/Process.h>
 #include <FreeNOS/ProcessEvent.h>
 #include <FreeNOS/ProcessManager.h>
+#include <FreeNOS/BootTimeline.h>
 #include <Log.h>
 #include "ProcessCtl.h"
 
@@ -57,6 +58,20 @@ API::Result ProcessCtlHandler(const ProcessID procID,
         }
         return (API::Result) (API::Success | (proc->getID() << 16));
 
+    case Clone:
+        if (!(proc = procs->clone(proc)))
+        {
+            ERROR("failed to clone process");
+            return API::IOError;
+        }
+        if (procID == SELF && procs->resume(proc) != ProcessManager::Success)
+        {
+            ERROR("failed to resume PID " << proc->getID());
+            procs->remove(proc);
+            return API::IOError;
+        }
+        return (API::Result) (API::Success | (proc->getID() << 16));
+
     case KillPID:
         procs->remove(proc, addr); // Addr contains the exit status
 
@@ -135,6 +150,18 @@ API::Result ProcessCtlHandler(const ProcessID procID,
         info->id    = proc->getID();
         info->state = proc->getState();
         info->parent = proc->getParent();
+
+        // Memory usage is only collected on request, as it walks the page tables
+        if (output)
+        {
+            MemoryContext::Usage *usage = (MemoryContext::Usage *) output;
+
+            if (proc->getMemoryContext()->usage(*usage) != MemoryContext::Success)
+            {
+                ERROR("failed to retrieve memory usage for Process ID " << proc->getID());
+                return API::IOError;
+            }
+        }
         break;
 
     case WaitPID:
@@ -177,6 +204,32 @@ API::Result ProcessCtlHandler(const ProcessID procID,
         if (procs->sleep((const Timer::Info *)addr) == ProcessManager::Success)
             procs->schedule();
         break;
+
+    case RecordBootEvent:
+    {
+        const MemoryContext *mem = procs->current()->getMemoryContext();
+        const char *src = (const char *) addr;
+        char name[BOOTEVENT_NAMELEN];
+        Memory::Access access;
+        Size i;
+
+        // Copy at most BOOTEVENT_NAMELEN bytes, checking each page of the user buffer
+        for (i = 0; i < BOOTEVENT_NAMELEN - 1; i++)
+        {
+            if ((i == 0 || ((addr + i) & ~PAGEMASK) == 0) &&
+                (mem->access(addr + i, &access) != MemoryContext::Success || !(access & Memory::User)))
+            {
+                return API::AccessViolation;
+            }
+
+            if ((name[i] = src[i]) == ZERO)
+                break;
+        }
+        name[i] = ZERO;
+
+        Kernel::instance()->getBootTimeline()->record(name, proc->getID(), timestamp());
+        break;
+    }
     }
 
     return API::Success;
@@ -199,6 +252,8 @@ Log & operator << (Log &log, ProcessOperation op)
         case EnterSleep: log.append("EnterSleep"); break;
         case Schedule:  log.append("Schedule"); break;
         case Wakeup:    log.append("Wakeup"); break;
+        case RecordBootEvent: log.append("RecordBootEvent"); break;
+        case Clone:     log.append("Clone"); break;
         default:        log.append("???"); break;
     }
     return log;
@@ -53,7 +53,9 @@ typedef enum ProcessOperation
     Wakeup,
     Stop,
     Resume,
-    Reset
+    Reset,
+    RecordBootEvent,
+    Clone
 }
 ProcessOperation;
 
@@ -83,12 +85,15 @@ Log & operator << (Log &log, ProcessOperation op);
  * @param op The operation to perform.
  * @param addr Input argument address, used for program entry point for Spawn,
  *             ProcessInfo pointer for Info.
- * @param output Output argument address (optional).
+ * @param output Output argument address (optional), used for the
+ *               MemoryContext::Usage pointer for InfoPID.
  *
  * @return API::Success on success and other API::ErrorCode on failure.
  *         For WaitPID, the process exit status is stored in the upper 16-bits
- *         of this return value on success. For Spawn, the new PID is stored in
- *         the upper 16-bits.
+ *         of this return value on success. For Spawn and Clone, the new PID is
+ *         stored in the upper 16-bits. A clone of SELF starts running and returns
+ *         API::Success from its own ProcessCtl call, while a clone of another
+ *         Process remains stopped until resumed.
  */
 inline API::Result ProcessCtl(const ProcessID proc,
                               const ProcessOperation op,
@@ -116,7 +121,8 @@ inline API::Result ProcessCtl(const ProcessID proc,
  * @param op The operation to perform.
  * @param addr Input argument address, used for program entry point for Spawn,
  *             ProcessInfo pointer for Info.
- * @param output Output argument address (optional).
+ * @param output Output argument address (optional), used for the
+ *               MemoryContext::Usage pointer for InfoPID.
  *
  * @return API::Success on success and other API::ErrorCode on failure.
  *         For WaitPID, the process exit status is stored in the upper 16-bits
@@ -18,6 +18,7 @@
 #include <FreeNOS/System.h>
 #include <FreeNOS/Config.h>
 #include <FreeNOS/Kernel.h>
+#include <FreeNOS/BootTimeline.h>
 #include <SplitAllocator.h>
 #include <CoreInfo.h>
 
@@ -41,6 +42,7 @@ API::Result SystemInfoHandler(SystemInformation *info)
     info->timerCounter     = core->timerCounter;
     info->coreChannelAddress = core->coreChannelAddress;
     info->coreChannelSize    = core->coreChannelSize;
+    info->bootTimelineAddress = Kernel::instance()->getBootTimeline()->getAddress();
 
     MemoryBlock::copy(info->cmdline, coreInfo.kernelCommand, 64);
     return API::Success;
@@ -115,6 +115,9 @@ typedef struct SystemInformation
 
     /** Timer counter */
     uint timerCounter;
+
+    /** Physical address of the boot timeline page */
+    Address bootTimelineAddress;
 }
 SystemInformation;
 
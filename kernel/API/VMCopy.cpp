@@ -51,7 +51,12 @@ API::Result VMCopyHandler(const ProcessID procID,
         // Update variables
         if (how == API::ReadPhys)
             paddr = theirAddr & PAGEMASK;
-        else if (remote->lookup(theirAddr, &paddr) != MemoryContext::Success)
+        else if (how == API::Write && remote->isCopyOnWrite(theirAddr) &&
+                 remote->fault(theirAddr) != MemoryContext::Success)
+            return API::AccessViolation;
+        else if (remote->lookup(theirAddr, &paddr) != MemoryContext::Success &&
+                (remote->fault(theirAddr) != MemoryContext::Success ||
+                 remote->lookup(theirAddr, &paddr) != MemoryContext::Success))
             return API::AccessViolation;
 
         assert(!(paddr & ~PAGEMASK));
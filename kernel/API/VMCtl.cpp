@@ -49,6 +49,15 @@ API::Result VMCtlHandler(const ProcessID procID,
         case LookupVirtual:
             // Translate virtual address to physical address (page boundary)
             memResult = mem->lookup(range->virt, &range->phys);
+
+            // Reserved pages are backed on lookup, such that the caller has a physical page.
+            // Copy-on-write pages are copied first, as the caller may write to the physical page.
+            if ((memResult != MemoryContext::Success || mem->isCopyOnWrite(range->virt)) &&
+                mem->fault(range->virt) == MemoryContext::Success)
+            {
+                memResult = mem->lookup(range->virt, &range->phys);
+            }
+
             if (memResult != MemoryContext::Success)
             {
                 ERROR("failed to lookup virtual address " << (void *) range->virt <<
@@ -63,6 +72,7 @@ API::Result VMCtlHandler(const ProcessID procID,
 
         case MapContiguous:
         case MapSparse:
+        case MapLazy:
             if (!range->virt)
             {
                 memResult = mem->findFree(range->size, MemoryMap::UserPrivate, &range->virt);
@@ -76,6 +86,8 @@ API::Result VMCtlHandler(const ProcessID procID,
             }
             if (op == MapContiguous)
                 memResult = mem->mapRangeContiguous(range);
+            else if (op == MapLazy)
+                memResult = mem->mapRangeLazy(range);
             else
                 memResult = mem->mapRangeSparse(range);
 
@@ -143,10 +155,14 @@ API::Result VMCtlHandler(const ProcessID procID,
 
         case Access: {
             const MemoryContext::Result mr = mem->access(range->virt, &range->access);
-            if (mr == MemoryContext::Success)
+            if (mr == MemoryContext::Success || mem->isReserved(range->virt & PAGEMASK, &range->access))
                 ret = API::Success;
             else
                 ret = API::AccessViolation;
+
+            // Copy-on-write pages are writable, the copy is made on the first write
+            if (ret == API::Success && mem->isCopyOnWrite(range->virt))
+                range->access |= Memory::Writable;
             break;
         }
 
@@ -173,6 +189,56 @@ API::Result VMCtlHandler(const ProcessID procID,
             break;
         }
 
+        case MapShared:
+        {
+            SplitAllocator *alloc = Kernel::instance()->getAllocator();
+
+            if (!range->virt || (range->virt & ~PAGEMASK) || (range->phys & ~PAGEMASK) ||
+                range->phys < alloc->base() ||
+                range->phys + range->size > alloc->base() + alloc->size())
+            {
+                return API::InvalidArgument;
+            }
+
+            // Only pages allocated by the kernel can be shared
+            for (Size i = 0; i < range->size; i += PAGESIZE)
+            {
+                if (!alloc->isAllocated(range->phys + i))
+                {
+                    ERROR("address " << (void *)(range->phys + i) << " is not allocated");
+                    return API::InvalidArgument;
+                }
+            }
+
+            // The virtual range must be free, such that on failure only our own pages are unmapped
+            for (Size i = 0; i < range->size; i += PAGESIZE)
+            {
+                Address phys;
+
+                if (mem->lookup(range->virt + i, &phys) == MemoryContext::Success)
+                {
+                    ERROR("address " << (void *)(range->virt + i) << " is already mapped");
+                    return API::AlreadyExists;
+                }
+            }
+
+            memResult = mem->mapRangeContiguous(range);
+            if (memResult != MemoryContext::Success)
+            {
+                ERROR("failed to map shared range " << (void *)range->virt << "->" <<
+                     (void *) range->phys << ": " << (int) memResult);
+                mem->unmapRange(range);
+                return API::IOError;
+            }
+
+            // Each mapping holds a reference, dropped when the range is released
+            for (Size i = 0; i < range->size; i += PAGESIZE)
+            {
+                alloc->reference(range->phys + i);
+            }
+            break;
+        }
+
         default:
             ret = API::InvalidArgument;
             break;
@@ -45,7 +45,9 @@ typedef enum MemoryOperation
     AddMem,
     CacheClean,
     CacheInvalidate,
-    CacheCleanInvalidate
+    CacheCleanInvalidate,
+    MapShared,
+    MapLazy
 }
 MemoryOperation;
 
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include <Log.h>
+#include <MemoryBlock.h>
+#include <SplitAllocator.h>
+#include "BootTimeline.h"
+
+BootTimeline::BootTimeline(SplitAllocator *alloc)
+    : m_address(ZERO)
+    , m_header(ZERO)
+    , m_events(ZERO)
+{
+    Allocator::Range range;
+    range.address   = 0;
+    range.size      = PAGESIZE;
+    range.alignment = PAGESIZE;
+
+    if (alloc->allocate(range) != Allocator::Success)
+    {
+        ERROR("failed to allocate boot timeline page");
+        return;
+    }
+
+    m_address = range.address;
+    m_header  = (BootTimelineHeader *) alloc->toVirtual(m_address);
+    m_events  = (BootEvent *) (m_header + 1);
+
+    MemoryBlock::set(m_header, 0, PAGESIZE);
+    m_header->magic   = BOOTTIMELINE_MAGIC;
+    m_header->maximum = (PAGESIZE - sizeof(BootTimelineHeader)) / sizeof(BootEvent);
+}
+
+Address BootTimeline::getAddress() const
+{
+    return m_address;
+}
+
+void BootTimeline::record(const char *name, const u32 pid, const u64 timestamp)
+{
+    if (!m_header || m_header->count >= m_header->maximum)
+    {
+        return;
+    }
+
+    BootEvent *event = &m_events[m_header->count];
+    event->timestamp = timestamp;
+    event->pid       = pid;
+    MemoryBlock::copy(event->name, (char *) name, BOOTEVENT_NAMELEN);
+
+    m_header->count++;
+}
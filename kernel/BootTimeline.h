@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __KERNEL_BOOTTIMELINE_H
+#define __KERNEL_BOOTTIMELINE_H
+
+#include <Types.h>
+
+/**
+ * @addtogroup kernel
+ * @{
+ */
+
+/** Magic value at the start of the boot timeline page ('Boot'). */
+#define BOOTTIMELINE_MAGIC  0x746f6f42
+
+/** Maximum length of a boot event name, including the null terminator. */
+#define BOOTEVENT_NAMELEN   52
+
+/**
+ * Single event on the boot timeline.
+ */
+typedef struct BootEvent
+{
+    /** Value of the cycle counter when the event occurred. */
+    u64 timestamp;
+
+    /** Process which recorded the event, or KERNEL_PID. */
+    u32 pid;
+
+    /** Description of the event. */
+    char name[BOOTEVENT_NAMELEN];
+}
+BootEvent;
+
+/**
+ * Header of the boot timeline page, followed by the BootEvents.
+ */
+typedef struct BootTimelineHeader
+{
+    /** Must contain BOOTTIMELINE_MAGIC. */
+    u32 magic;
+
+    /** Number of recorded events. */
+    u32 count;
+
+    /** Maximum number of events. */
+    u32 maximum;
+
+    /** Reserved for alignment of the events. */
+    u32 reserved;
+}
+BootTimelineHeader;
+
+#ifdef __KERNEL__
+
+/** Forward declarations. */
+class SplitAllocator;
+
+/**
+ * Records boot phases in a page of physical memory.
+ *
+ * The kernel records its own phases directly. Processes record
+ * events with the ProcessCtl RecordBootEvent operation, such that events
+ * from multiple processes are serialized by the kernel. The page is never
+ * mapped into processes: bootchart reads it with VMCopy ReadPhys.
+ */
+class BootTimeline
+{
+  public:
+
+    /**
+     * Constructor function.
+     *
+     * @param alloc Physical memory allocator for the timeline page.
+     */
+    BootTimeline(SplitAllocator *alloc);
+
+    /**
+     * Get physical address of the timeline page.
+     *
+     * @return Physical address or ZERO if not available.
+     */
+    Address getAddress() const;
+
+    /**
+     * Append an event.
+     *
+     * Events are dropped once the timeline is full.
+     *
+     * @param name Description of the event.
+     * @param pid Process which recorded the event.
+     * @param timestamp Cycle counter value of the event.
+     */
+    void record(const char *name, const u32 pid, const u64 timestamp);
+
+  private:
+
+    /** Physical address of the timeline page. */
+    Address m_address;
+
+    /** Timeline header in the page. */
+    BootTimelineHeader *m_header;
+
+    /** Events in the page. */
+    BootEvent *m_events;
+};
+
+#endif /* __KERNEL__ */
+
+/**
+ * @}
+ */
+
+#endif /* __KERNEL_BOOTTIMELINE_H */
@@ -22,10 +22,12 @@
 #include <SplitAllocator.h>
 #include <BubbleAllocator.h>
 #include <PoolAllocator.h>
+#include <SlabAllocator.h>
 #include <IntController.h>
 #include <BootImageStorage.h>
 #include <CoreInfo.h>
 #include "Kernel.h"
+#include "BootTimeline.h"
 #include "Memory.h"
 #include "Process.h"
 #include "ProcessManager.h"
@@ -34,6 +36,8 @@ Kernel::Kernel(CoreInfo *info)
     : WeakSingleton<Kernel>(this)
     , m_interrupts(256)
 {
+    const u64 entry = timestamp();
+
     // Output log banners on the boot core
     if (info->coreId == 0)
     {
@@ -103,6 +107,11 @@ Kernel::Kernel(CoreInfo *info)
 
     // Clear interrupts table
     m_interrupts.fill(ZERO);
+
+    // Start the boot timeline
+    m_timeline = new BootTimeline(m_alloc);
+    m_timeline->record("kernel entry", KERNEL_PID, entry);
+    m_timeline->record("kernel memory ready", KERNEL_PID, timestamp());
 }
 
 Error Kernel::initializeHeap()
@@ -118,7 +127,11 @@ Error Kernel::initializeHeap()
     coreInfo.heapSize    = MegaByte(1);
 
     // Prepare allocators
+#if SLAB_HEAP
+    Size metaData = sizeof(BubbleAllocator) + sizeof(SlabAllocator);
+#else
     Size metaData = sizeof(BubbleAllocator) + sizeof(PoolAllocator);
+#endif /* SLAB_HEAP */
     Allocator *bubble, *pool;
     const Allocator::Range bubbleRange = { coreInfo.heapAddress + metaData,
                                            coreInfo.heapSize - metaData, sizeof(u32) };
@@ -128,7 +141,11 @@ Error Kernel::initializeHeap()
 
     // Setup the dynamic memory heap
     bubble = new (coreInfo.heapAddress) BubbleAllocator(bubbleRange);
+#if SLAB_HEAP
+    pool   = new (coreInfo.heapAddress + sizeof(BubbleAllocator)) SlabAllocator(bubble);
+#else
     pool   = new (coreInfo.heapAddress + sizeof(BubbleAllocator)) PoolAllocator(bubble);
+#endif /* SLAB_HEAP */
 
     // Set default allocator
     Allocator::setDefault(pool);
@@ -165,6 +182,11 @@ Timer * Kernel::getTimer()
     return m_timer;
 }
 
+BootTimeline * Kernel::getBootTimeline()
+{
+    return m_timeline;
+}
+
 void Kernel::enableIRQ(u32 irq, bool enabled)
 {
     if (m_intControl)
@@ -394,7 +416,9 @@ int Kernel::run()
     NOTICE("");
 
     // Load boot image programs
+    m_timeline->record("kernel loadBootImage", KERNEL_PID, timestamp());
     loadBootImage();
+    m_timeline->record("kernel schedule", KERNEL_PID, timestamp());
 
     // Start the scheduler
     m_procs->schedule();
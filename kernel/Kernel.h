@@ -30,6 +30,7 @@
 /** Forward declarations. */
 class API;
 class BootImageStorage;
+class BootTimeline;
 class MemoryContext;
 class Process;
 class ProcessManager;
@@ -165,6 +166,13 @@ class Kernel : public WeakSingleton<Kernel>
      */
     Timer * getTimer();
 
+    /**
+     * Get boot timeline.
+     *
+     * @return BootTimeline object pointer
+     */
+    BootTimeline * getBootTimeline();
+
     /**
      * Execute the kernel.
      */
@@ -243,6 +251,9 @@ class Kernel : public WeakSingleton<Kernel>
 
     /** Timer device. */
     Timer *m_timer;
+
+    /** Records the timestamps of boot phases. */
+    BootTimeline *m_timeline;
 };
 
 /**
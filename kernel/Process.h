@@ -168,6 +168,18 @@ class Process
      */
     virtual void reset(const Address entry) = 0;
 
+    /**
+     * Copy the user registers of another Process.
+     *
+     * Used to clone a Process. If the other Process is inside
+     * a kernel call, the clone returns from it with API::Success.
+     *
+     * @param parent Process to copy the registers from.
+     *
+     * @return Result code
+     */
+    virtual Result cloneRegisters(const Process *parent) = 0;
+
     /**
      * Allow the Process to run on the CPU.
      *
@@ -92,6 +92,60 @@ Process * ProcessManager::create(const Address entry,
     return proc;
 }
 
+Process * ProcessManager::clone(Process *parent)
+{
+    static const MemoryMap::Region regions[] = {
+        MemoryMap::UserData,
+        MemoryMap::UserHeap,
+        MemoryMap::UserStack,
+        MemoryMap::UserPrivate,
+        MemoryMap::UserArgs
+    };
+    Process *proc = create(parent->m_entry, parent->m_map, false, parent->isPrivileged());
+    if (!proc)
+    {
+        return ZERO;
+    }
+
+    MemoryContext *mem = proc->getMemoryContext();
+    Memory::Range range = proc->m_map.range(MemoryMap::UserStack);
+
+    // The clone continues on a copy of the parent stack instead
+    if (mem->releaseRange(&range) != MemoryContext::Success)
+    {
+        ERROR("failed to release user stack of PID " << proc->getID());
+        remove(proc);
+        return ZERO;
+    }
+
+    // Share anonymous user memory copy-on-write. Private mappings, such as DMA
+    // buffers and pages of other processes, are shared directly. Shared memory
+    // with other processes, including the kernel event channel, is not inherited.
+    for (Size i = 0; i < sizeof(regions) / sizeof(regions[0]); i++)
+    {
+        range = parent->m_map.range(regions[i]);
+
+        const MemoryContext::Result r = parent->getMemoryContext()->cloneRange(
+            mem, range, regions[i] != MemoryMap::UserPrivate);
+        if (r != MemoryContext::Success)
+        {
+            ERROR("failed to clone memory of PID " << parent->getID() <<
+                  " at " << (void *) range.virt << ": result = " << (int) r);
+            remove(proc);
+            return ZERO;
+        }
+    }
+
+    if (proc->cloneRegisters(parent) != Process::Success)
+    {
+        ERROR("failed to clone registers of PID " << parent->getID());
+        remove(proc);
+        return ZERO;
+    }
+
+    return proc;
+}
+
 Process * ProcessManager::get(const ProcessID id)
 {
     return m_procs.get(id);
@@ -84,6 +84,18 @@ class ProcessManager
                      const bool readyToRun = false,
                      const bool privileged = false);
 
+    /**
+     * Create a copy-on-write clone of a Process.
+     *
+     * The clone shares the user memory of the parent copy-on-write and
+     * starts with the same registers. It is created in the Stopped state.
+     *
+     * @param parent Process to clone
+     *
+     * @return Process pointer on success or ZERO on failure
+     */
+    Process * clone(Process *parent);
+
     /**
      * Retrieve a Process by it's ID.
      *
@@ -91,7 +91,15 @@ void ARMKernel::undefinedInstruction(CPUState state)
 
 void ARMKernel::prefetchAbort(CPUState state)
 {
+    Process *proc = Kernel::instance()->getProcessManager()->current();
+    ARMControl ctrl;
     ARMCore core;
+
+    // Resolve demand-zero and copy-on-write pages and retry the faulting instruction
+    if (proc && proc->getMemoryContext()->fault(ctrl.read(ARMControl::InstructionFaultAddress))
+                == MemoryContext::Success)
+        return;
+
     core.logException(&state);
 
     FATAL("core" << coreInfo.coreId << ": procId = " <<
@@ -100,7 +108,15 @@ void ARMKernel::prefetchAbort(CPUState state)
 
 void ARMKernel::dataAbort(CPUState state)
 {
+    Process *proc = Kernel::instance()->getProcessManager()->current();
+    ARMControl ctrl;
     ARMCore core;
+
+    // Resolve demand-zero and copy-on-write pages and retry the faulting instruction
+    if (proc && proc->getMemoryContext()->fault(ctrl.read(ARMControl::DataFaultAddress))
+                == MemoryContext::Success)
+        return;
+
     core.logException(&state);
 
     FATAL("core" << coreInfo.coreId << ": procId = " <<
@@ -125,6 +141,9 @@ void ARMKernel::trap(volatile CPUState state)
 
     DEBUG("coreId = " << coreInfo.coreId << " procId = " << procId << " api = " << state.r0);
 
+    // Allows the kernel call to clone the registers of the process
+    proc->setTrapState((const CPUState *) &state);
+
     // Execute the kernel call
     u32 r = Kernel::instance()->getAPI()->invoke(
         (API::Number) state.r0,
@@ -16,6 +16,7 @@
  */
 
 #include <FreeNOS/System.h>
+#include <FreeNOS/ProcessManager.h>
 #include <Log.h>
 #include <SplitAllocator.h>
 #include "ARMProcess.h"
@@ -27,6 +28,7 @@ extern u8 svcStack[PAGESIZE * 4];
 
 ARMProcess::ARMProcess(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
     : Process(id, entry, privileged, map)
+    , m_trapState(ZERO)
 {
 }
 
@@ -93,6 +95,11 @@ void ARMProcess::setCpuState(const CPUState *cpuState)
     MemoryBlock::copy(&m_cpuState, cpuState, sizeof(*cpuState));
 }
 
+void ARMProcess::setTrapState(const CPUState *trapState)
+{
+    m_trapState = trapState;
+}
+
 ARMProcess::Result ARMProcess::join(const uint result)
 {
     const Result r = Process::join(result);
@@ -114,6 +121,23 @@ void ARMProcess::reset(const Address entry)
     m_cpuState.cpsr = (m_privileged ? SYS_MODE : USR_MODE); // current program status (CPSR)
 }
 
+Process::Result ARMProcess::cloneRegisters(const Process *parent)
+{
+    const ARMProcess *p = (const ARMProcess *) parent;
+
+    // A running parent is inside the kernel call which clones it.
+    // Otherwise its registers were saved when it was switched out.
+    if (p == Kernel::instance()->getProcessManager()->current() && p->m_trapState)
+    {
+        MemoryBlock::copy(&m_cpuState, p->m_trapState, sizeof(m_cpuState));
+        m_cpuState.r0 = API::Success;
+    }
+    else
+        MemoryBlock::copy(&m_cpuState, &p->m_cpuState, sizeof(m_cpuState));
+
+    return Success;
+}
+
 void ARMProcess::execute(Process *previous)
 {
     // Activates memory context of this process
@@ -38,6 +38,13 @@ void ARM64Kernel::SyncExceptionEL0(volatile CPUState state)
     u64 ec = exception_code(state.esr);
 
     switch(ec) {
+        case 0x20: //Instruction Abort
+        case 0x24: //Data Abort
+            // Resolve demand-zero and copy-on-write pages and retry the faulting instruction
+            if (resolveFault(state.far))
+                break;
+            ERROR("Failed to access " << (void *)state.far);
+            break;
         case 0x25: //Data Abort
             ERROR("Failed to access " << (void *)state.far);
             break;
@@ -49,9 +56,21 @@ void ARM64Kernel::SyncExceptionEL0(volatile CPUState state)
     }
 }
 
+bool ARM64Kernel::resolveFault(Address addr)
+{
+    Process *proc = Kernel::instance()->getProcessManager()->current();
+
+    return proc && proc->getMemoryContext()->fault(addr) == MemoryContext::Success;
+}
+
 void ARM64Kernel::SyncExceptionEL1(volatile CPUState state)
 {
     u64 ec = exception_code(state.esr);
+
+    // Kernel access to a demand-zero page of the current process
+    if (ec == 0x25 && resolveFault(state.far))
+        return;
+
     NOTICE("Unexpected m_exception in EL1 called from EL1 ec="<<(void *)ec);
     NOTICE("ESR_EL1 = "<<(void *)state.esr);
 
@@ -113,6 +132,9 @@ void ARM64Kernel::trap(volatile CPUState &state)
     DEBUG("args = " << (void *)state.x0 << ", " << (void *)state.x1 << ", " << (void *)state.x2
             << ", " << (void *)state.x3 << "," << (void *)state.x4);
 
+    // Allows the kernel call to clone the registers of the process
+    proc->setTrapState((const CPUState *) &state);
+
     // Execute the kernel call
     u32 r = Kernel::instance()->getAPI()->invoke(
         (API::Number) state.x8,
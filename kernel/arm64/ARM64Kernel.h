@@ -54,6 +54,15 @@ class ARM64Kernel : public Kernel
      */
     static void trap(volatile CPUState &state);
 
+    /**
+     * Resolve an access to a demand-zero or copy-on-write page of the current process
+     *
+     * @param addr Faulting virtual address
+     *
+     * @return True if the page is now mapped, false otherwise
+     */
+    static bool resolveFault(Address addr);
+
     /**
      * Synchronous exceptions from EL1
      *
@@ -17,6 +17,7 @@
  */
 
 #include <FreeNOS/System.h>
+#include <FreeNOS/ProcessManager.h>
 #include <Log.h>
 #include <SplitAllocator.h>
 #include "ARM64Process.h"
@@ -28,6 +29,7 @@ extern u8 svcStack[PAGESIZE * 16];
 
 ARM64Process::ARM64Process(ProcessID id, Address entry, bool privileged, const MemoryMap &map)
     : Process(id, entry, privileged, map)
+    , m_trapState(ZERO)
 {
 }
 
@@ -94,6 +96,11 @@ void ARM64Process::setCpuState(const CPUState *cpuState)
     MemoryBlock::copy(&m_cpuState, cpuState, sizeof(*cpuState));
 }
 
+void ARM64Process::setTrapState(const CPUState *trapState)
+{
+    m_trapState = trapState;
+}
+
 ARM64Process::Result ARM64Process::join(const uint result)
 {
     const Result r = Process::join(result);
@@ -115,6 +122,23 @@ void ARM64Process::reset(const Address entry)
     m_cpuState.cpsr = (m_privileged ? 0x5 : 0x0);           // current program status (CPSR)
 }
 
+Process::Result ARM64Process::cloneRegisters(const Process *parent)
+{
+    const ARM64Process *p = (const ARM64Process *) parent;
+
+    // A running parent is inside the kernel call which clones it.
+    // Otherwise its registers were saved when it was switched out.
+    if (p == Kernel::instance()->getProcessManager()->current() && p->m_trapState)
+    {
+        MemoryBlock::copy(&m_cpuState, p->m_trapState, sizeof(m_cpuState));
+        m_cpuState.x0 = API::Success;
+    }
+    else
+        MemoryBlock::copy(&m_cpuState, &p->m_cpuState, sizeof(m_cpuState));
+
+    return Success;
+}
+
 void ARM64Process::execute(Process *previous)
 {
     DEBUG("proc " << previous->getID()  << " switch to proc " << getID() );
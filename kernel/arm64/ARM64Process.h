@@ -65,6 +65,13 @@ class ARM64Process : public Process
      */
     const CPUState * cpuState() const;
 
+    /**
+     * Set the CPU registers of the kernel call in progress.
+     *
+     * @param trapState Pointer to the registers saved by the kernel call.
+     */
+    void setTrapState(const CPUState *trapState);
+
    /**
      * Complete waiting for another Process.
      *
@@ -89,6 +96,15 @@ class ARM64Process : public Process
      */
     virtual void reset(const Address entry);
 
+    /**
+     * Copy the user registers of another Process.
+     *
+     * @param parent Process to copy the registers from.
+     *
+     * @return Result code
+     */
+    virtual Result cloneRegisters(const Process *parent);
+
     /**
      * Allow the Process to run on the CPU.
      */
@@ -98,6 +114,9 @@ class ARM64Process : public Process
 
     /** Contains all the CPU registers for this task */
     CPUState m_cpuState;
+
+    /** Registers saved by the last kernel call, only valid while running */
+    const CPUState *m_trapState;
 };
 
 
@@ -31,6 +31,16 @@
 
 extern C void executeInterrupt(CPUState state)
 {
+    // Resolve demand-zero and copy-on-write page faults before the vector is masked as an IRQ
+    if (state.vector == INTEL_PAGEFAULT)
+    {
+        Process *proc = Kernel::instance()->getProcessManager()->current();
+        IntelCore core;
+
+        if (proc && proc->getMemoryContext()->fault(core.readCR2()) == MemoryContext::Success)
+            return;
+    }
+
     Kernel::instance()->executeIntVector(state.vector, &state);
 }
 
@@ -139,6 +139,27 @@ void IntelProcess::reset(const Address entry)
     pusha->esp0 = pusha->ebp;
 }
 
+Process::Result IntelProcess::cloneRegisters(const Process *parent)
+{
+    const IntelProcess *p = (const IntelProcess *) parent;
+    CPUState *regs = (CPUState *) m_kernelStackBase - 1;
+
+    // Privileged processes run in kernel mode, so their
+    // kernel stack does not begin with the user registers
+    if (m_privileged)
+        return InvalidArgument;
+
+    // Copy the saved user registers, but keep our own kernel stack
+    MemoryBlock::copy(regs, (CPUState *) p->m_kernelStackBase - 1, sizeof(CPUState));
+    regs->regs.esp0 = m_kernelStack;
+
+    // Return from the kernel call
+    if (regs->vector == 0x90)
+        regs->regs.eax = API::Success;
+
+    return Success;
+}
+
 void IntelProcess::execute(Process *previous)
 {
     IntelProcess *p = (IntelProcess *) previous;
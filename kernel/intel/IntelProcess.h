@@ -76,6 +76,15 @@ class IntelProcess : public Process
      */
     virtual void reset(const Address entry);
 
+    /**
+     * Copy the user registers of another Process.
+     *
+     * @param parent Process to copy the registers from.
+     *
+     * @return Result code
+     */
+    virtual Result cloneRegisters(const Process *parent);
+
     /**
      * Execute the process.
      *
@@ -91,6 +91,48 @@ Allocator::Result Allocator::release(const Address addr)
     return InvalidAddress;
 }
 
+Allocator::Result Allocator::reallocate(Allocator::Range & range, const bool move)
+{
+    const Size current = range.address ? usableSize(range.address) : 0;
+    Range moved;
+    Result result;
+
+    // Memory which already has enough space stays in place
+    if (range.address && current == 0)
+        return InvalidAddress;
+    else if (range.address && range.size <= current)
+        return Success;
+    else if (range.address && !move)
+        return OutOfMemory;
+
+    // Move the contents to new memory
+    moved.address   = 0;
+    moved.size      = range.size;
+    moved.alignment = range.alignment;
+
+    if ((result = allocate(moved)) != Success)
+        return result;
+
+    if (range.address)
+    {
+        MemoryBlock::copy((void *) moved.address, (void *) range.address, current);
+        release(range.address);
+    }
+
+    range.address = moved.address;
+    return Success;
+}
+
+Size Allocator::usableSize(const Address addr) const
+{
+    return 0;
+}
+
+Size Allocator::profile(ProfileSite *sites, const Size count) const
+{
+    return 0;
+}
+
 Address Allocator::aligned(const Address addr, const Size boundary) const
 {
     Address corrected = addr;
@@ -19,6 +19,7 @@
 #define __LIBALLOC_ALLOCATOR_H
 #ifndef __ASSEMBLER__
 
+#include <FreeNOS/Config.h>
 #include <Macros.h>
 #include <Types.h>
 
@@ -69,6 +70,18 @@ class Allocator
         Size alignment;  /**< Alignment in bytes or ZERO for default alignment. */
     } Range;
 
+    /**
+     * Heap profile statistics of a single allocation site.
+     */
+    typedef struct ProfileSite
+    {
+        Address caller;  /**< Return address of the call to allocate(). */
+        Size sizeClass;  /**< Size in bytes of the objects, including overhead. */
+        Size count;      /**< Total number of allocations. */
+        Size live;       /**< Amount of memory in bytes currently allocated. */
+        Size peak;       /**< Highest amount of memory in bytes allocated at once. */
+    } ProfileSite;
+
   public:
 
     /**
@@ -165,6 +178,44 @@ class Allocator
      */
     virtual Result release(const Address addr);
 
+    /**
+     * Resize previously allocated memory.
+     *
+     * The memory is resized in place if possible. Otherwise, if moving
+     * is allowed, new memory is allocated, the contents are copied and
+     * the old memory is released. A zero address allocates new memory.
+     *
+     * @param range Contains the address of the memory and the requested
+     *              size on input. On output, contains the resized address.
+     * @param move True to allow moving the memory if it cannot be resized in place.
+     *
+     * @return Result value.
+     *
+     * @see usableSize
+     */
+    virtual Result reallocate(Range & range, const bool move = true);
+
+    /**
+     * Get the usable size of allocated memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Number of bytes which may be used at the given address,
+     *         or zero if the Allocator does not know the size.
+     */
+    virtual Size usableSize(const Address addr) const;
+
+    /**
+     * Retrieve heap profile statistics.
+     *
+     * @param sites Array to fill with statistics per allocation site.
+     * @param count Maximum number of entries to fill in the array.
+     *
+     * @return Number of entries filled, or zero if the
+     *         Allocator does not support profiling.
+     */
+    virtual Size profile(ProfileSite *sites, const Size count) const;
+
   protected:
 
     /**
@@ -199,12 +250,24 @@ class Allocator
 
 #ifndef __HOST__
 
+/**
+ * Inline attribute of the allocation operators.
+ *
+ * With HEAP_PROFILE enabled the operators are always inlined, such that
+ * the return address of allocate() identifies the caller of new().
+ */
+#if HEAP_PROFILE
+#define HEAP_PROFILE_INLINE ALWAYS_INLINE inline
+#else
+#define HEAP_PROFILE_INLINE inline
+#endif /* HEAP_PROFILE */
+
 /**
  * Allocate new memory.
  *
  * @param sz Amount of memory to allocate.
  */
-inline void * operator new(__SIZE_TYPE__ sz)
+HEAP_PROFILE_INLINE void * operator new(__SIZE_TYPE__ sz)
 {
     Allocator::Range alloc_args;
 
@@ -222,7 +285,7 @@ inline void * operator new(__SIZE_TYPE__ sz)
  *
  * @param sz Amount of memory to allocate.
  */
-inline void * operator new[](__SIZE_TYPE__ sz)
+HEAP_PROFILE_INLINE void * operator new[](__SIZE_TYPE__ sz)
 {
     Allocator::Range alloc_args;
 
@@ -255,6 +318,17 @@ inline void operator delete[] (void *mem)
     Allocator::getDefault()->release((Address)mem);
 }
 
+/**
+ * Construct an object at the given memory address.
+ *
+ * @param sz Size of the object (ignored).
+ * @param addr Memory address of the object.
+ */
+inline void * operator new(__SIZE_TYPE__ sz, void *addr)
+{
+    return addr;
+}
+
 #endif /* __HOST__ */
 
 /**
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Assert.h>
+#include <MemoryBlock.h>
+#include "HeapProfile.h"
+
+HeapProfile::HeapProfile()
+{
+    MemoryBlock::set(m_sites, 0, sizeof(m_sites));
+}
+
+Size HeapProfile::allocate(const Address caller, const Size sizeClass, const Size size)
+{
+    const Size start = ((caller >> 2) ^ sizeClass) % MaximumSites;
+
+    // Find the allocation site, or an unused entry for it
+    for (Size i = 0; i < MaximumSites; i++)
+    {
+        const Size index = (start + i) % MaximumSites;
+        Allocator::ProfileSite *site = &m_sites[index];
+
+        if (site->caller == ZERO)
+        {
+            site->caller = caller;
+            site->sizeClass = sizeClass;
+        }
+        else if (site->caller != caller || site->sizeClass != sizeClass)
+        {
+            continue;
+        }
+
+        site->count++;
+        site->live += size;
+
+        if (site->live > site->peak)
+            site->peak = site->live;
+
+        return index;
+    }
+
+    // All entries are in use: the object is not profiled
+    return Unprofiled;
+}
+
+void HeapProfile::resize(const Size site, const Size oldSize, const Size newSize)
+{
+    if (site < MaximumSites)
+    {
+        Allocator::ProfileSite *entry = &m_sites[site];
+
+        assert(entry->live >= oldSize);
+        entry->live = entry->live - oldSize + newSize;
+
+        if (entry->live > entry->peak)
+            entry->peak = entry->live;
+    }
+}
+
+Size HeapProfile::read(Allocator::ProfileSite *sites, const Size count) const
+{
+    Size filled = 0;
+
+    for (Size i = 0; i < MaximumSites && filled < count; i++)
+    {
+        if (m_sites[i].caller != ZERO)
+        {
+            sites[filled++] = m_sites[i];
+        }
+    }
+
+    return filled;
+}
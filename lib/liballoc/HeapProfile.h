@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBALLOC_HEAPPROFILE_H
+#define __LIBALLOC_HEAPPROFILE_H
+
+#include <Types.h>
+#include <Macros.h>
+#include "Allocator.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup liballoc
+ * @{
+ */
+
+/**
+ * Heap allocation statistics per allocation site.
+ *
+ * An allocation site is the combination of the return address of the call
+ * to allocate() and the object size class. Sites are stored in a fixed size
+ * hash table, such that profiling never allocates memory itself.
+ */
+class HeapProfile
+{
+  public:
+
+    /** Maximum number of allocation sites. */
+    static const Size MaximumSites = 64;
+
+    /** Site index of objects which are not profiled. */
+    static const Size Unprofiled = MaximumSites;
+
+  public:
+
+    /**
+     * Constructor
+     */
+    HeapProfile();
+
+    /**
+     * Account a new object to its allocation site.
+     *
+     * @param caller Return address of the call to allocate()
+     * @param sizeClass Size in bytes of the objects, including overhead
+     * @param size Size of the object in bytes
+     *
+     * @return Index of the allocation site, or Unprofiled if all sites are in use.
+     */
+    Size allocate(const Address caller, const Size sizeClass, const Size size);
+
+    /**
+     * Account a change in object size to its allocation site.
+     *
+     * @param site Index of the allocation site
+     * @param oldSize Previous size of the object in bytes
+     * @param newSize New size of the object in bytes, or zero when released
+     */
+    void resize(const Size site, const Size oldSize, const Size newSize);
+
+    /**
+     * Copy out the statistics of all allocation sites in use.
+     *
+     * @param sites Array of ProfileSite entries to fill
+     * @param count Maximum number of entries to fill
+     *
+     * @return Number of entries filled
+     */
+    Size read(Allocator::ProfileSite *sites, const Size count) const;
+
+  private:
+
+    /** Statistics per allocation site. Entries without caller are unused. */
+    Allocator::ProfileSite m_sites[MaximumSites];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBALLOC_HEAPPROFILE_H */
@@ -115,6 +115,11 @@ Allocator::Result PoolAllocator::allocate(Allocator::Range & args)
             ObjectPostfix *postfix = (ObjectPostfix *) (args.address + sizeof(ObjectPrefix) + inputSize);
             postfix->signature = ObjectSignature;
 
+#if HEAP_PROFILE
+            prefix->site = m_profile.allocate((Address) __builtin_return_address(0),
+                                              pool->chunkSize(), inputSize);
+#endif /* HEAP_PROFILE */
+
             args.address += sizeof(ObjectPrefix);
         }
 
@@ -131,24 +136,16 @@ Allocator::Result PoolAllocator::release(const Address addr)
 {
     const Address actualAddr = addr - sizeof(ObjectPrefix);
     const ObjectPrefix *prefix = (const ObjectPrefix *) (actualAddr);
-    ObjectPostfix *postfix = ZERO;
-
-    // Verify the object prefix signature
-    assert(prefix->signature == ObjectSignature);
-    assert(prefix->pool != NULL);
-
-    // Do a reverse memory scan to find the object postfix.
-    for (Size i = prefix->pool->chunkSize() - sizeof(u32); i > sizeof(ObjectPrefix); i -= sizeof(u32))
-    {
-        postfix = (ObjectPostfix *)(actualAddr + i);
-        if (postfix->signature == ObjectSignature)
-            break;
-    }
+    const ObjectPostfix *postfix = findPostfix(prefix);
 
     // Verify the object postfix signature
     assert(postfix != ZERO);
     assert(postfix->signature == ObjectSignature);
 
+#if HEAP_PROFILE
+    m_profile.resize(prefix->site, (Address) postfix - addr, 0);
+#endif /* HEAP_PROFILE */
+
     // Release the object
     Result result = prefix->pool->release(actualAddr);
     assert(result == Success);
@@ -162,6 +159,71 @@ Allocator::Result PoolAllocator::release(const Address addr)
     return result;
 }
 
+Allocator::Result PoolAllocator::reallocate(Allocator::Range & args, const bool move)
+{
+    const Size inputSize = aligned(args.size, sizeof(u32));
+
+    if (args.address != 0 && args.alignment == 0 && inputSize != 0)
+    {
+        const ObjectPrefix *prefix = (const ObjectPrefix *) (args.address - sizeof(ObjectPrefix));
+        ObjectPostfix *postfix = findPostfix(prefix);
+
+        assert(postfix->signature == ObjectSignature);
+
+        // Move the postfix if the object still fits in its pool
+        if (inputSize + sizeof(ObjectPrefix) + sizeof(ObjectPostfix) <= prefix->pool->chunkSize())
+        {
+#if HEAP_PROFILE
+            m_profile.resize(prefix->site, (Address) postfix - args.address, inputSize);
+#endif /* HEAP_PROFILE */
+            postfix->signature = 0;
+            postfix = (ObjectPostfix *) (args.address + inputSize);
+            postfix->signature = ObjectSignature;
+            return Success;
+        }
+    }
+
+    return Allocator::reallocate(args, move);
+}
+
+Size PoolAllocator::usableSize(const Address addr) const
+{
+    const ObjectPrefix *prefix = (const ObjectPrefix *) (addr - sizeof(ObjectPrefix));
+    const ObjectPostfix *postfix = findPostfix(prefix);
+
+    assert(postfix->signature == ObjectSignature);
+
+    return (Address) postfix - addr;
+}
+
+Size PoolAllocator::profile(ProfileSite *sites, const Size count) const
+{
+#if HEAP_PROFILE
+    return m_profile.read(sites, count);
+#else
+    return 0;
+#endif /* HEAP_PROFILE */
+}
+
+PoolAllocator::ObjectPostfix * PoolAllocator::findPostfix(const ObjectPrefix *prefix) const
+{
+    ObjectPostfix *postfix = ZERO;
+
+    // Verify the object prefix signature
+    assert(prefix->signature == ObjectSignature);
+    assert(prefix->pool != NULL);
+
+    // Do a reverse memory scan to find the object postfix.
+    for (Size i = prefix->pool->chunkSize() - sizeof(u32); i > sizeof(ObjectPrefix); i -= sizeof(u32))
+    {
+        postfix = (ObjectPostfix *)(((Address) prefix) + i);
+        if (postfix->signature == ObjectSignature)
+            break;
+    }
+
+    return postfix;
+}
+
 PoolAllocator::Pool * PoolAllocator::retrievePool(const Size inputSize)
 {
     const Size requestedSize = inputSize + sizeof(ObjectPrefix) + sizeof(ObjectPostfix);
@@ -18,10 +18,12 @@
 #ifndef __LIBALLOC_POOLALLOCATOR_H
 #define __LIBALLOC_POOLALLOCATOR_H
 
+#include <FreeNOS/Config.h>
 #include <Types.h>
 #include <Macros.h>
 #include "Allocator.h"
 #include "BitAllocator.h"
+#include "HeapProfile.h"
 
 /**
  * @addtogroup lib
@@ -41,6 +43,9 @@
  *       contains a BitArray that scans its internal array for "free bits". If the caller
  *       is unfortunate, the whole array needs to be scanned, adding overhead. The Linux kernel
  *       uses a buddy allocator, that basically combines a bit array and a linked list for optimal performance.
+ *
+ * When built with HEAP_PROFILE enabled, each allocation is accounted to its
+ * allocation site: the return address of allocate() and the object size class.
  */
 class PoolAllocator : public Allocator
 {
@@ -85,6 +90,9 @@ class PoolAllocator : public Allocator
     {
         u32 signature;  /**< Filled with a fixed value to detect corruption/overflows */
         Pool *pool;     /**< Points to the Pool instance where this object belongs to */
+#if HEAP_PROFILE
+        Size site;      /**< Index of the allocation site in m_profile */
+#endif /* HEAP_PROFILE */
     } ObjectPrefix;
 
     /**
@@ -139,8 +147,49 @@ class PoolAllocator : public Allocator
      */
     virtual Result release(const Address addr);
 
+    /**
+     * Resize previously allocated memory.
+     *
+     * Objects are resized in place while they fit in their pool.
+     *
+     * @param args Contains the address of the memory and the requested
+     *             size on input. On output, contains the resized address.
+     * @param move True to allow moving the memory if it cannot be resized in place.
+     *
+     * @return Result value.
+     */
+    virtual Result reallocate(Range & args, const bool move = true);
+
+    /**
+     * Get the usable size of allocated memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Number of bytes which may be used at the given address.
+     */
+    virtual Size usableSize(const Address addr) const;
+
+    /**
+     * Retrieve heap profile statistics.
+     *
+     * @param sites Array to fill with statistics per allocation site.
+     * @param count Maximum number of entries to fill in the array.
+     *
+     * @return Number of entries filled, or zero if HEAP_PROFILE is disabled.
+     */
+    virtual Size profile(ProfileSite *sites, const Size count) const;
+
   private:
 
+    /**
+     * Find the postfix of an object.
+     *
+     * @param prefix Prefix of the object
+     *
+     * @return ObjectPostfix pointer
+     */
+    ObjectPostfix * findPostfix(const ObjectPrefix *prefix) const;
+
     /**
      * Calculate object size given the Pool index number.
      *
@@ -199,6 +248,11 @@ class PoolAllocator : public Allocator
 
     /** Array of memory pools. Index represents the power of two. */
     Pool *m_pools[MaximumPoolSize + 1];
+
+#if HEAP_PROFILE
+    /** Heap profile statistics. */
+    HeapProfile m_profile;
+#endif /* HEAP_PROFILE */
 };
 
 /**
@@ -0,0 +1,350 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Assert.h>
+#include <Macros.h>
+#include <MemoryBlock.h>
+#include "SlabAllocator.h"
+
+SlabAllocator::SlabAllocator(Allocator *parent)
+    : m_size(0)
+    , m_used(0)
+{
+    assert(parent != NULL);
+    setParent(parent);
+    MemoryBlock::set(m_slabs, 0, sizeof(m_slabs));
+}
+
+Size SlabAllocator::size() const
+{
+    return m_size;
+}
+
+Size SlabAllocator::available() const
+{
+    assert(m_used <= m_size);
+
+    return m_size - m_used;
+}
+
+Allocator::Result SlabAllocator::allocate(Allocator::Range & args)
+{
+    const Size inputSize = aligned(args.size, sizeof(u32));
+    Size index;
+    Slab *slab;
+
+    // Verify input arguments
+    if (args.alignment != 0)
+    {
+        return InvalidAlignment;
+    }
+    else if (inputSize == 0)
+    {
+        return InvalidSize;
+    }
+
+#ifdef __ASSERT__
+    index = calculateIndex(inputSize + sizeof(ObjectPrefix) + sizeof(ObjectPostfix));
+#else
+    index = calculateIndex(inputSize + sizeof(ObjectPrefix));
+#endif /* __ASSERT__ */
+
+    if (index == 0)
+    {
+        args.address = 0;
+        return OutOfMemory;
+    }
+
+    // Take the first slab with free objects, or create one
+    if ((slab = m_slabs[index]) == ZERO && (slab = allocateSlab(index)) == ZERO)
+    {
+        args.address = 0;
+        return OutOfMemory;
+    }
+
+    // Pop the first free object
+    const Address object = slab->free;
+    slab->free = *(Address *) object;
+    slab->used++;
+    m_used += (1U << index);
+
+    // Full slabs are only found again when an object is released
+    if (slab->free == ZERO)
+    {
+        removeSlab(slab);
+    }
+
+    ObjectPrefix *prefix = (ObjectPrefix *) object;
+    prefix->slab = slab;
+
+#ifdef __ASSERT__
+    prefix->signature = ObjectSignature;
+
+    ObjectPostfix *postfix = (ObjectPostfix *) (object + sizeof(ObjectPrefix) + inputSize);
+    postfix->signature = ObjectSignature;
+#endif /* __ASSERT__ */
+
+#if HEAP_PROFILE
+    prefix->size = inputSize;
+    prefix->site = m_profile.allocate((Address) __builtin_return_address(0),
+                                      1U << index, inputSize);
+#endif /* HEAP_PROFILE */
+
+    args.address = object + sizeof(ObjectPrefix);
+    return Success;
+}
+
+Allocator::Result SlabAllocator::release(const Address addr)
+{
+    const Address object = addr - sizeof(ObjectPrefix);
+    const ObjectPrefix *prefix = (const ObjectPrefix *) object;
+    Slab *slab = prefix->slab;
+
+    assert(slab != NULL);
+
+#ifdef __ASSERT__
+    const ObjectPostfix *postfix = findPostfix(object);
+
+    // Verify the object postfix signature
+    assert(postfix != ZERO);
+    assert(postfix->signature == ObjectSignature);
+#endif /* __ASSERT__ */
+
+    assert(slab->used > 0);
+
+#if HEAP_PROFILE
+    m_profile.resize(prefix->site, prefix->size, 0);
+#endif /* HEAP_PROFILE */
+
+    // A full slab has free objects again
+    if (slab->free == ZERO)
+    {
+        insertSlab(slab);
+    }
+
+    // Push the object on the free list. This overwrites the signature,
+    // such that releasing the same object twice is detected.
+    *(Address *) object = slab->free;
+    slab->free = object;
+    slab->used--;
+    m_used -= (1U << slab->index);
+
+    // Keep the first slab of a size class, to avoid allocating it over and over
+    if (slab->used == 0 && (slab->prev != ZERO || slab->next != ZERO))
+    {
+        releaseSlab(slab);
+    }
+
+    return Success;
+}
+
+Allocator::Result SlabAllocator::reallocate(Allocator::Range & args, const bool move)
+{
+    const Size inputSize = aligned(args.size, sizeof(u32));
+
+    if (args.address != 0 && args.alignment == 0 && inputSize != 0)
+    {
+        const Address object = args.address - sizeof(ObjectPrefix);
+        ObjectPrefix *prefix = (ObjectPrefix *) object;
+
+        assert(prefix->slab != NULL);
+
+#ifdef __ASSERT__
+        // Move the postfix if the object still fits in its size class
+        if (inputSize + sizeof(ObjectPrefix) + sizeof(ObjectPostfix) <= (1U << prefix->slab->index))
+        {
+            ObjectPostfix *postfix = findPostfix(object);
+            assert(postfix->signature == ObjectSignature);
+
+#if HEAP_PROFILE
+            m_profile.resize(prefix->site, prefix->size, inputSize);
+            prefix->size = inputSize;
+#endif /* HEAP_PROFILE */
+            postfix->signature = 0;
+            postfix = (ObjectPostfix *) (args.address + inputSize);
+            postfix->signature = ObjectSignature;
+            return Success;
+        }
+#else
+        // The object may use its whole size class
+        if (inputSize + sizeof(ObjectPrefix) <= (1U << prefix->slab->index))
+        {
+#if HEAP_PROFILE
+            m_profile.resize(prefix->site, prefix->size, inputSize);
+            prefix->size = inputSize;
+#endif /* HEAP_PROFILE */
+            return Success;
+        }
+#endif /* __ASSERT__ */
+    }
+
+    return Allocator::reallocate(args, move);
+}
+
+Size SlabAllocator::usableSize(const Address addr) const
+{
+    const Address object = addr - sizeof(ObjectPrefix);
+
+#ifdef __ASSERT__
+    const ObjectPostfix *postfix = findPostfix(object);
+    assert(postfix->signature == ObjectSignature);
+
+    return (Address) postfix - addr;
+#else
+    const ObjectPrefix *prefix = (const ObjectPrefix *) object;
+
+    return (1U << prefix->slab->index) - sizeof(ObjectPrefix);
+#endif /* __ASSERT__ */
+}
+
+Size SlabAllocator::profile(ProfileSite *sites, const Size count) const
+{
+#if HEAP_PROFILE
+    return m_profile.read(sites, count);
+#else
+    return 0;
+#endif /* HEAP_PROFILE */
+}
+
+#ifdef __ASSERT__
+SlabAllocator::ObjectPostfix * SlabAllocator::findPostfix(const Address object) const
+{
+    const ObjectPrefix *prefix = (const ObjectPrefix *) object;
+    ObjectPostfix *postfix = ZERO;
+
+    // Verify the object prefix signature
+    assert(prefix->signature == ObjectSignature);
+
+    // Do a reverse memory scan to find the object postfix.
+    for (Size i = (1U << prefix->slab->index) - sizeof(u32); i > sizeof(ObjectPrefix); i -= sizeof(u32))
+    {
+        postfix = (ObjectPostfix *)(object + i);
+        if (postfix->signature == ObjectSignature)
+            break;
+    }
+
+    return postfix;
+}
+#endif /* __ASSERT__ */
+
+Size SlabAllocator::calculateIndex(const Size objectSize) const
+{
+    for (Size index = MinimumObjectSize; index <= MaximumObjectSize; index++)
+    {
+        if (objectSize <= (1U << index))
+        {
+            return index;
+        }
+    }
+
+    return 0;
+}
+
+SlabAllocator::Slab * SlabAllocator::allocateSlab(const Size index)
+{
+    const Size objectSize = 1U << index;
+    const Size slabHeader = aligned(sizeof(Slab), sizeof(ObjectPrefix));
+    Allocator::Range alloc_args;
+
+    // Allocate a single buffer for the Slab and its objects
+    alloc_args.address = 0;
+    alloc_args.alignment = sizeof(u32);
+    alloc_args.size = slabHeader + (objectSize >= MinimumSlabSize ? objectSize : MinimumSlabSize);
+
+    if (parent()->allocate(alloc_args) != Allocator::Success)
+    {
+        return ZERO;
+    }
+
+    // The parent might have returned more space than requested
+    Slab *slab = (Slab *) alloc_args.address;
+    slab->prev  = ZERO;
+    slab->next  = ZERO;
+    slab->free  = ZERO;
+    slab->index = index;
+    slab->count = (alloc_args.size - slabHeader) / objectSize;
+    slab->used  = 0;
+    slab->size  = alloc_args.size;
+
+    assert(slab->count >= 1);
+
+    // Link all objects into the free list, lowest address first
+    for (Size i = slab->count; i > 0; i--)
+    {
+        const Address object = alloc_args.address + slabHeader + ((i - 1) * objectSize);
+        *(Address *) object = slab->free;
+        slab->free = object;
+    }
+
+    m_size += slab->size;
+    m_used += slabHeader + (slab->size - slabHeader - (slab->count * objectSize));
+    insertSlab(slab);
+    return slab;
+}
+
+void SlabAllocator::releaseSlab(Slab *slab)
+{
+    const Size objectSize = 1U << slab->index;
+    const Size slabHeader = aligned(sizeof(Slab), sizeof(ObjectPrefix));
+    const Size slabSize = slab->size;
+    const Size overhead = slabHeader + (slabSize - slabHeader - (slab->count * objectSize));
+
+    removeSlab(slab);
+
+    // Keep the slab if the parent does not take memory back
+    if (parent()->release((Address) slab) != Allocator::Success)
+    {
+        insertSlab(slab);
+        return;
+    }
+
+    m_size -= slabSize;
+    m_used -= overhead;
+}
+
+void SlabAllocator::insertSlab(Slab *slab)
+{
+    slab->prev = ZERO;
+    slab->next = m_slabs[slab->index];
+
+    if (slab->next != ZERO)
+    {
+        slab->next->prev = slab;
+    }
+
+    m_slabs[slab->index] = slab;
+}
+
+void SlabAllocator::removeSlab(Slab *slab)
+{
+    if (slab->prev != ZERO)
+    {
+        slab->prev->next = slab->next;
+    }
+    else
+    {
+        m_slabs[slab->index] = slab->next;
+    }
+
+    if (slab->next != ZERO)
+    {
+        slab->next->prev = slab->prev;
+    }
+
+    slab->prev = ZERO;
+    slab->next = ZERO;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBALLOC_SLABALLOCATOR_H
+#define __LIBALLOC_SLABALLOCATOR_H
+
+#include <FreeNOS/Config.h>
+#include <Types.h>
+#include <Macros.h>
+#include "Allocator.h"
+#include "HeapProfile.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup liballoc
+ * @{
+ */
+
+/**
+ * Memory allocator which uses slabs with intrusive free lists.
+ *
+ * Objects are grouped in size classes of a power of two. Each slab
+ * holds objects of one size class and links its free objects together
+ * through their own memory. Slabs with free objects are kept on a list
+ * per size class, which makes both allocate() and release() constant time.
+ *
+ * The object signatures used to detect corruption and overflows are
+ * only written and verified when assertions are enabled.
+ *
+ * When built with HEAP_PROFILE enabled, each allocation is accounted to its
+ * allocation site, in the same way as the PoolAllocator.
+ *
+ * @see PoolAllocator
+ */
+class SlabAllocator : public Allocator
+{
+  private:
+
+    /** Minimum power of two for an object size. */
+    static const Size MinimumObjectSize = 3;
+
+    /** Maximum power of two for an object size (128MiB). */
+    static const Size MaximumObjectSize = 27;
+
+    /** Minimum payload size of a slab in bytes. */
+    static const Size MinimumSlabSize = KiloByte(16);
+
+    /** Signature value is used to detect object corruption/overflows */
+    static const u32 ObjectSignature = 0xF7312A56;
+
+    /**
+     * Contiguous block of memory holding same-sized objects.
+     */
+    typedef struct Slab
+    {
+        Slab *prev;     /**< Previous slab of this size class with free objects. */
+        Slab *next;     /**< Next slab of this size class with free objects. */
+        Address free;   /**< First free object, which points to the next free object. */
+        Size index;     /**< Size class of the objects in this slab. */
+        Size count;     /**< Total number of objects in this slab. */
+        Size used;      /**< Number of objects in use. */
+        Size size;      /**< Total size in bytes of the slab memory. */
+    } Slab;
+
+    /**
+     * This data structure is prepended in memory before each object
+     */
+    typedef struct ObjectPrefix
+    {
+        u32 signature;  /**< Filled with a fixed value to detect corruption/overflows */
+        Slab *slab;     /**< Points to the Slab where this object belongs to */
+#if HEAP_PROFILE
+        Size site;      /**< Index of the allocation site in m_profile */
+        Size size;      /**< Requested size of the object in bytes */
+#endif /* HEAP_PROFILE */
+    } ObjectPrefix;
+
+    /**
+     * Appended in memory after each object when assertions are enabled
+     */
+    typedef struct ObjectPostfix
+    {
+        u32 signature;  /**< Filled with a fixed value to detect corruption/overflows */
+    } ObjectPostfix;
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param parent Allocator for obtaining new memory to manage
+     */
+    SlabAllocator(Allocator *parent);
+
+    /**
+     * Get memory size.
+     *
+     * @return Size of memory owned by the SlabAllocator.
+     */
+    virtual Size size() const;
+
+    /**
+     * Get memory available.
+     *
+     * @return Size of memory available by the SlabAllocator.
+     */
+    virtual Size available() const;
+
+    /**
+     * Allocate memory.
+     *
+     * @param args Contains the requested size and alignment on input.
+     *             On output, contains the actual allocated address.
+     *
+     * @return Result value.
+     */
+    virtual Result allocate(Range & args);
+
+    /**
+     * Release memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Result value.
+     *
+     * @see allocate
+     */
+    virtual Result release(const Address addr);
+
+    /**
+     * Resize previously allocated memory.
+     *
+     * Objects are resized in place while they fit in their size class.
+     *
+     * @param args Contains the address of the memory and the requested
+     *             size on input. On output, contains the resized address.
+     * @param move True to allow moving the memory if it cannot be resized in place.
+     *
+     * @return Result value.
+     */
+    virtual Result reallocate(Range & args, const bool move = true);
+
+    /**
+     * Get the usable size of allocated memory.
+     *
+     * @param addr Points to memory previously returned by allocate().
+     *
+     * @return Number of bytes which may be used at the given address.
+     */
+    virtual Size usableSize(const Address addr) const;
+
+    /**
+     * Retrieve heap profile statistics.
+     *
+     * @param sites Array of ProfileSite entries to fill
+     * @param count Maximum number of entries to fill
+     *
+     * @return Number of entries filled, or zero if HEAP_PROFILE is disabled.
+     */
+    virtual Size profile(ProfileSite *sites, const Size count) const;
+
+  private:
+
+#ifdef __ASSERT__
+    /**
+     * Find the postfix of an object.
+     *
+     * @param object Address of the object prefix
+     *
+     * @return ObjectPostfix pointer
+     */
+    ObjectPostfix * findPostfix(const Address object) const;
+#endif /* __ASSERT__ */
+
+    /**
+     * Find the size class for an object.
+     *
+     * @param objectSize Size in bytes including the object prefix and postfix
+     *
+     * @return Size class index or zero if too large
+     */
+    Size calculateIndex(const Size objectSize) const;
+
+    /**
+     * Create a new Slab and add it to the free list of its size class.
+     *
+     * @param index Size class of the new Slab
+     *
+     * @return Slab pointer on success, ZERO on failure.
+     */
+    Slab * allocateSlab(const Size index);
+
+    /**
+     * Return an unused Slab to the parent.
+     *
+     * @param slab Slab pointer
+     */
+    void releaseSlab(Slab *slab);
+
+    /**
+     * Add a Slab to the list of slabs with free objects.
+     *
+     * @param slab Slab pointer
+     */
+    void insertSlab(Slab *slab);
+
+    /**
+     * Remove a Slab from the list of slabs with free objects.
+     *
+     * @param slab Slab pointer
+     */
+    void removeSlab(Slab *slab);
+
+  private:
+
+    /** Slabs with free objects per size class. Index represents the power of two. */
+    Slab *m_slabs[MaximumObjectSize + 1];
+
+    /** Total memory in bytes obtained from the parent. */
+    Size m_size;
+
+    /** Memory in bytes used by slab headers and allocated objects. */
+    Size m_used;
+
+#if HEAP_PROFILE
+    /** Heap profile statistics. */
+    HeapProfile m_profile;
+#endif /* HEAP_PROFILE */
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBALLOC_SLABALLOCATOR_H */
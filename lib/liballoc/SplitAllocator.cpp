@@ -15,6 +15,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <Assert.h>
+#include <MemoryBlock.h>
 #include "SplitAllocator.h"
 
 SplitAllocator::SplitAllocator(const Allocator::Range physRange,
@@ -24,17 +26,35 @@ SplitAllocator::SplitAllocator(const Allocator::Range physRange,
     , m_alloc(physRange, pageSize)
     , m_virtRange(virtRange)
     , m_pageSize(pageSize)
+    , m_shared(SharedTableSize)
+    , m_pageCacheCount(0)
+    , m_zeroPoolCount(0)
 {
 }
 
 Size SplitAllocator::available() const
 {
-    return m_alloc.available();
+    return m_alloc.available() + ((m_pageCacheCount + m_zeroPoolCount) * m_pageSize);
 }
 
 Allocator::Result SplitAllocator::allocate(Allocator::Range & args)
 {
-    return m_alloc.allocate(args);
+    // Single pages are served from the page cache
+    if (args.size <= m_pageSize && (args.alignment == 0 || args.alignment == m_pageSize))
+    {
+        return allocatePage(&args.address);
+    }
+
+    Result r = m_alloc.allocate(args);
+
+    // Cached pages may be needed to find a contiguous block
+    if (r == OutOfMemory && (m_pageCacheCount > 0 || m_zeroPoolCount > 0))
+    {
+        drainCache();
+        r = m_alloc.allocate(args);
+    }
+
+    return r;
 }
 
 Allocator::Result SplitAllocator::allocateSparse(const Allocator::Range & args,
@@ -69,7 +89,7 @@ Allocator::Result SplitAllocator::allocateSparse(const Allocator::Range & args,
 Allocator::Result SplitAllocator::allocate(Allocator::Range & phys,
                                            Allocator::Range & virt)
 {
-    Result r = m_alloc.allocate(phys);
+    Result r = allocate(phys);
 
     if (r == Success)
     {
@@ -81,14 +101,145 @@ Allocator::Result SplitAllocator::allocate(Allocator::Range & phys,
     return r;
 }
 
+Allocator::Result SplitAllocator::allocateZeroed(Allocator::Range & phys,
+                                                 Allocator::Range & virt)
+{
+    Result r;
+
+    if (m_zeroPoolCount > 0 && phys.size <= m_pageSize &&
+        (phys.alignment == 0 || phys.alignment == m_pageSize))
+    {
+        phys.address = m_zeroPool[--m_zeroPoolCount];
+        virt.address = toVirtual(phys.address);
+        virt.size = phys.size;
+        virt.alignment = phys.alignment;
+        return Success;
+    }
+
+    if ((r = allocate(phys, virt)) == Success)
+    {
+        MemoryBlock::set((void *) virt.address, 0, phys.size);
+    }
+
+    return r;
+}
+
+Size SplitAllocator::zeroPages(const Size count)
+{
+    Size zeroed = 0;
+    Address page;
+
+    while (zeroed < count && m_zeroPoolCount < ZeroPoolSize)
+    {
+        // Only take pages from the page cache or the BitAllocator
+        if (m_pageCacheCount == 0)
+        {
+            refillCache();
+
+            if (m_pageCacheCount == 0)
+                break;
+        }
+
+        page = m_pageCache[--m_pageCacheCount];
+        MemoryBlock::set((void *) toVirtual(page), 0, m_pageSize);
+        m_zeroPool[m_zeroPoolCount++] = page;
+        zeroed++;
+    }
+
+    return zeroed;
+}
+
 Allocator::Result SplitAllocator::allocate(const Address addr)
 {
+    const Address page = addr & ~(m_pageSize - 1);
+
+    // Take the page out of the caches, where it is already marked allocated
+    for (Size i = 0; i < m_pageCacheCount; i++)
+    {
+        if (m_pageCache[i] == page)
+        {
+            m_pageCache[i] = m_pageCache[--m_pageCacheCount];
+            return Success;
+        }
+    }
+
+    for (Size i = 0; i < m_zeroPoolCount; i++)
+    {
+        if (m_zeroPool[i] == page)
+        {
+            m_zeroPool[i] = m_zeroPool[--m_zeroPoolCount];
+            return Success;
+        }
+    }
+
     return m_alloc.allocateAt(addr);
 }
 
+Allocator::Result SplitAllocator::reference(const Address addr)
+{
+    const Address page = addr & ~(m_pageSize - 1);
+
+    if (!isAllocated(page))
+    {
+        return InvalidAddress;
+    }
+
+    m_shared.insert(page, m_shared.value(page, 0) + 1);
+    return Success;
+}
+
 Allocator::Result SplitAllocator::release(const Address addr)
 {
-    return m_alloc.release(addr);
+    const Address page = addr & ~(m_pageSize - 1);
+    const Size *shared = m_shared.get(page);
+
+    // Drop one reference if the page is still shared
+    if (shared != ZERO)
+    {
+        if (*shared > 1)
+            m_shared.insert(page, *shared - 1);
+        else
+            m_shared.remove(page);
+
+        return Success;
+    }
+
+    // A free page must not enter the page cache twice
+    if (!isAllocated(page))
+    {
+        return InvalidAddress;
+    }
+
+    // Return the oldest batch of pages to the BitAllocator when the page cache is full
+    if (m_pageCacheCount == PageCacheSize)
+    {
+        for (Size i = 0; i < PageCacheBatch; i++)
+        {
+            m_alloc.release(m_pageCache[i]);
+        }
+
+        m_pageCacheCount -= PageCacheBatch;
+
+        for (Size i = 0; i < m_pageCacheCount; i++)
+        {
+            m_pageCache[i] = m_pageCache[i + PageCacheBatch];
+        }
+    }
+
+    m_pageCache[m_pageCacheCount++] = page;
+    return Success;
+}
+
+Size SplitAllocator::getReferenceCount(const Address addr) const
+{
+    const Address page = addr & ~(m_pageSize - 1);
+
+    if (!isAllocated(page))
+    {
+        return 0;
+    }
+
+    return m_shared.value(page, 0) + 1;
 }
 
 Address SplitAllocator::toVirtual(const Address phys) const
@@ -105,5 +256,93 @@ Address SplitAllocator::toPhysical(const Address virt) const
 
 bool SplitAllocator::isAllocated(const Address page) const
 {
-    return m_alloc.isAllocated(page);
+    return m_alloc.isAllocated(page) && !isCached(page);
+}
+
+Allocator::Result SplitAllocator::allocatePage(Address *page)
+{
+    if (m_pageCacheCount == 0)
+    {
+        refillCache();
+    }
+
+    if (m_pageCacheCount > 0)
+    {
+        *page = m_pageCache[--m_pageCacheCount];
+        return Success;
+    }
+
+    // Use zeroed pages as a last resort
+    if (m_zeroPoolCount > 0)
+    {
+        *page = m_zeroPool[--m_zeroPoolCount];
+        return Success;
+    }
+
+    return OutOfMemory;
+}
+
+void SplitAllocator::refillCache()
+{
+    Range args;
+    args.address = 0;
+    args.size = m_pageSize * PageCacheBatch;
+    args.alignment = m_pageSize;
+
+    // Prefer a contiguous batch, which needs only one search. Pages are
+    // pushed in reverse, such that they are handed out in address order.
+    if (m_alloc.allocate(args) == Success)
+    {
+        for (Size i = PageCacheBatch; i > 0; i--)
+        {
+            m_pageCache[m_pageCacheCount++] = args.address + ((i - 1) * m_pageSize);
+        }
+        return;
+    }
+
+    // Fall back to individual pages
+    Address pages[PageCacheBatch];
+    Size count = 0;
+
+    args.size = m_pageSize;
+
+    while (count < PageCacheBatch && m_alloc.allocate(args) == Success)
+    {
+        pages[count++] = args.address;
+    }
+
+    while (count > 0)
+    {
+        m_pageCache[m_pageCacheCount++] = pages[--count];
+    }
+}
+
+void SplitAllocator::drainCache()
+{
+    while (m_pageCacheCount > 0)
+    {
+        m_alloc.release(m_pageCache[--m_pageCacheCount]);
+    }
+
+    while (m_zeroPoolCount > 0)
+    {
+        m_alloc.release(m_zeroPool[--m_zeroPoolCount]);
+    }
+}
+
+bool SplitAllocator::isCached(const Address page) const
+{
+    for (Size i = 0; i < m_pageCacheCount; i++)
+    {
+        if (m_pageCache[i] == page)
+            return true;
+    }
+
+    for (Size i = 0; i < m_zeroPoolCount; i++)
+    {
+        if (m_zeroPool[i] == page)
+            return true;
+    }
+
+    return false;
 }
@@ -20,6 +20,7 @@
 
 #include <Types.h>
 #include <Callback.h>
+#include <HashTable.h>
 #include "Allocator.h"
 #include "BitAllocator.h"
 
@@ -33,9 +34,30 @@
 
 /**
  * Allocator which separates kernel mapped memory at virtual and physical addresses.
+ *
+ * Pages can be shared by adding references to them. A shared page
+ * is only released when all of its references are released.
+ *
+ * Single pages are served from a small cache of free pages, which is
+ * refilled from and drained to the BitAllocator in batches. A second
+ * pool holds free pages which are already filled with zeroes.
  */
 class SplitAllocator : public Allocator
 {
+  private:
+
+    /** Number of buckets in the table of shared pages */
+    static const Size SharedTableSize = 256;
+
+    /** Maximum number of free pages in the page cache */
+    static const Size PageCacheSize = 32;
+
+    /** Number of pages moved between the page cache and the BitAllocator at once */
+    static const Size PageCacheBatch = 16;
+
+    /** Maximum number of free pages in the zeroed page pool */
+    static const Size ZeroPoolSize = 32;
+
   public:
 
     /**
@@ -90,6 +112,32 @@ class SplitAllocator : public Allocator
      */
     Result allocate(Range & phys, Range & virt);
 
+    /**
+     * Allocate physical/virtual memory filled with zeroes.
+     *
+     * Single pages are taken from the zeroed page pool if possible.
+     *
+     * @param phys Contains the requested size and alignment on input.
+     *             On output, contains the actual allocated physical address.
+     * @param virt Contains the allocated memory translated for virtual addressing.
+     *
+     * @return Result code
+     *
+     * @see zeroPages
+     */
+    Result allocateZeroed(Range & phys, Range & virt);
+
+    /**
+     * Fill the zeroed page pool.
+     *
+     * Intended to be called when the system is idle.
+     *
+     * @param count Maximum number of pages to zero.
+     *
+     * @return Number of pages added to the pool.
+     */
+    Size zeroPages(const Size count);
+
     /**
      * Allocate one physical memory page.
      *
@@ -99,9 +147,20 @@ class SplitAllocator : public Allocator
      */
     Result allocate(const Address addr);
 
+    /**
+     * Add a reference to an allocated memory page.
+     *
+     * @param addr Physical memory page address
+     *
+     * @return Result code
+     */
+    Result reference(const Address addr);
+
     /**
      * Release memory page.
      *
+     * For a shared page, only one reference is dropped.
+     *
      * @param addr Physical memory address of page to release.
      *
      * @return Result value.
@@ -110,6 +169,16 @@ class SplitAllocator : public Allocator
      */
     virtual Result release(const Address addr);
 
+    /**
+     * Get number of references to a memory page.
+     *
+     * @param addr Physical memory page address
+     *
+     * @return Zero if not allocated, one if allocated and
+     *         more than one if the page is shared.
+     */
+    Size getReferenceCount(const Address addr) const;
+
     /**
      * Convert Address to virtual pointer.
      *
@@ -135,6 +204,36 @@ class SplitAllocator : public Allocator
      */
     bool isAllocated(const Address page) const;
 
+  private:
+
+    /**
+     * Allocate a single page from the caches.
+     *
+     * @param page On output contains the physical page address.
+     *
+     * @return Result code
+     */
+    Result allocatePage(Address *page);
+
+    /**
+     * Move a batch of free pages from the BitAllocator into the page cache.
+     */
+    void refillCache();
+
+    /**
+     * Return all cached and zeroed pages to the BitAllocator.
+     */
+    void drainCache();
+
+    /**
+     * Check if a page is free in the page cache or zeroed page pool.
+     *
+     * @param page Physical page address
+     *
+     * @return True if cached, false otherwise.
+     */
+    bool isCached(const Address page) const;
+
   private:
 
     /** Physical memory allocator. */
@@ -145,6 +244,21 @@ class SplitAllocator : public Allocator
 
     /** Size of a memory page. */
     const Size m_pageSize;
+
+    /** Additional references to shared pages, by page address. */
+    HashTable<Address, Size> m_shared;
+
+    /** Free pages which are still marked allocated in the BitAllocator. */
+    Address m_pageCache[PageCacheSize];
+
+    /** Number of pages in the page cache. */
+    Size m_pageCacheCount;
+
+    /** Free pages filled with zeroes, also marked allocated in the BitAllocator. */
+    Address m_zeroPool[ZeroPoolSize];
+
+    /** Number of pages in the zeroed page pool. */
+    Size m_zeroPoolCount;
 };
 
 /**
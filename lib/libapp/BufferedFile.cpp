@@ -22,6 +22,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <errno.h>
 #include "BufferedFile.h"
 
@@ -29,15 +30,19 @@ BufferedFile::BufferedFile(const char *path)
     : m_path(path)
     , m_buffer(ZERO)
     , m_size(0)
+    , m_mapped(false)
+    , m_fd(-1)
+    , m_chunkSize(0)
+    , m_chunkIndex(0)
 {
+    m_chunks[0] = ZERO;
+    m_chunks[1] = ZERO;
 }
 
 BufferedFile::~BufferedFile()
 {
-    if (m_buffer != ZERO)
-    {
-        delete[] m_buffer;
-    }
+    release();
+    close();
 }
 
 const char * BufferedFile::path() const
@@ -66,7 +71,6 @@ BufferedFile::Result BufferedFile::read()
         ERROR("failed to stat input file " << m_path << ": " << strerror(errno));
         return NotFound;
     }
-    m_size = st.st_size;
 
     // Open the file
     if ((fp = ::open(m_path, O_RDONLY)) == -1)
@@ -76,10 +80,8 @@ BufferedFile::Result BufferedFile::read()
     }
 
     // (Re)allocate the internal buffer
-    if (m_buffer != ZERO)
-    {
-        delete[] m_buffer;
-    }
+    release();
+    m_size = st.st_size;
     m_buffer = new u8[m_size];
     assert(m_buffer != ZERO);
 
@@ -96,6 +98,105 @@ BufferedFile::Result BufferedFile::read()
     return Success;
 }
 
+BufferedFile::Result BufferedFile::map()
+{
+    struct stat st;
+    int fp;
+
+    // Retrieve file information
+    if (::stat(m_path, &st) != 0)
+    {
+        ERROR("failed to stat input file " << m_path << ": " << strerror(errno));
+        return NotFound;
+    }
+
+    // Open the file
+    if ((fp = ::open(m_path, O_RDONLY)) == -1)
+    {
+        ERROR("failed to open input file " << m_path << ": " << strerror(errno));
+        return IOError;
+    }
+
+    // Map the file contents
+    void *addr = ::mmap(ZERO, st.st_size, PROT_READ, MAP_PRIVATE, fp, 0);
+    ::close(fp);
+
+    if (addr == MAP_FAILED)
+    {
+        DEBUG("cannot map input file " << m_path << ": " << strerror(errno));
+        return read();
+    }
+
+    release();
+    m_buffer = (u8 *) addr;
+    m_size = st.st_size;
+    m_mapped = true;
+    return Success;
+}
+
+BufferedFile::Result BufferedFile::open(const Size chunkSize)
+{
+    close();
+
+    // Open the file
+    if ((m_fd = ::open(m_path, O_RDONLY)) == -1)
+    {
+        ERROR("failed to open input file " << m_path << ": " << strerror(errno));
+        return NotFound;
+    }
+
+    // Allocate chunk buffers
+    m_chunkSize  = chunkSize;
+    m_chunkIndex = 0;
+    m_chunks[0]  = new u8[chunkSize];
+    m_chunks[1]  = new u8[chunkSize];
+    assert(m_chunks[0] != ZERO);
+    assert(m_chunks[1] != ZERO);
+
+    return Success;
+}
+
+BufferedFile::Result BufferedFile::next(const void * & chunk, Size & size)
+{
+    u8 *buffer = m_chunks[m_chunkIndex];
+
+    if (m_fd == -1)
+    {
+        return IOError;
+    }
+
+    // Read the next chunk, alternating between both buffers
+    const ssize_t result = ::read(m_fd, buffer, m_chunkSize);
+    if (result < 0)
+    {
+        ERROR("failed to read input file " << m_path << ": " << strerror(errno));
+        return IOError;
+    }
+
+    m_chunkIndex ^= 1;
+    chunk = buffer;
+    size = result;
+    return Success;
+}
+
+void BufferedFile::close()
+{
+    if (m_fd != -1)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    for (Size i = 0; i < 2; i++)
+    {
+        if (m_chunks[i] != ZERO)
+        {
+            delete[] m_chunks[i];
+            m_chunks[i] = ZERO;
+        }
+    }
+}
+
 BufferedFile::Result BufferedFile::write(const void *data, const Size size) const
 {
     int fp;
@@ -119,3 +220,22 @@ BufferedFile::Result BufferedFile::write(const void *data, const Size size) cons
     ::close(fp);
     return Success;
 }
+
+void BufferedFile::release()
+{
+    if (m_buffer != ZERO)
+    {
+        if (m_mapped)
+        {
+            ::munmap(m_buffer, m_size);
+        }
+        else
+        {
+            delete[] m_buffer;
+        }
+    }
+
+    m_buffer = ZERO;
+    m_size = 0;
+    m_mapped = false;
+}
@@ -30,6 +30,10 @@
 
 /**
  * Provides a buffered abstract interface to a file.
+ *
+ * The file can be read completely into memory with read(),
+ * mapped into memory with map() or streamed in fixed-size chunks
+ * using open() and next(), which keeps memory usage bounded.
  */
 class BufferedFile
 {
@@ -45,6 +49,11 @@ class BufferedFile
         IOError,
     };
 
+  public:
+
+    /** Default number of bytes in each chunk when streaming */
+    static const Size DefaultChunkSize = 16384;
+
   public:
 
     /**
@@ -85,6 +94,43 @@ class BufferedFile
      */
     Result read();
 
+    /**
+     * Map the file read-only into memory
+     *
+     * Falls back to read() if the file cannot be mapped.
+     *
+     * @return Result code
+     */
+    Result map();
+
+    /**
+     * Open the file for streaming in chunks
+     *
+     * @param chunkSize Maximum number of bytes in each chunk
+     *
+     * @return Result code
+     */
+    Result open(const Size chunkSize = DefaultChunkSize);
+
+    /**
+     * Read the next chunk of the file
+     *
+     * Chunks are read alternately into two buffers, such that
+     * the previous chunk remains valid while reading the next chunk.
+     *
+     * @param chunk On output, points to the chunk data
+     * @param size On output, number of bytes in the chunk.
+     *             Zero if the end of the file is reached.
+     *
+     * @return Result code
+     */
+    Result next(const void * & chunk, Size & size);
+
+    /**
+     * Stop streaming and release the chunk buffers
+     */
+    void close();
+
     /**
      * Write the file (unbuffered)
      *
@@ -97,6 +143,13 @@ class BufferedFile
      */
     Result write(const void *data, const Size size) const;
 
+  private:
+
+    /**
+     * Release the file contents, if any
+     */
+    void release();
+
   private:
 
     /** Path to the file */
@@ -107,6 +160,21 @@ class BufferedFile
 
     /** Size of the file in bytes */
     Size m_size;
+
+    /** True if the contents are mapped instead of allocated */
+    bool m_mapped;
+
+    /** File descriptor when streaming or -1 */
+    int m_fd;
+
+    /** Buffers for streaming chunks */
+    u8 *m_chunks[2];
+
+    /** Size of each chunk buffer in bytes */
+    Size m_chunkSize;
+
+    /** Index of the chunk buffer to read into next */
+    Size m_chunkIndex;
 };
 
 /**
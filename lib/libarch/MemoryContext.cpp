@@ -26,21 +26,33 @@
 
 #include <FreeNOS/System.h>
 #include <SplitAllocator.h>
+#include <MemoryBlock.h>
 #include "MemoryContext.h"
 
 MemoryContext * MemoryContext::m_current = 0;
 
+u8 MemoryContext::m_addressSpaces[MaxAddressSpaces / 8];
+
+Size MemoryContext::m_addressSpaceCount = 0;
+
 MemoryContext::MemoryContext(MemoryMap *map, SplitAllocator *alloc)
     : m_alloc(alloc)
     , m_map(map)
     , m_mapRangeSparseCallback(this, &MemoryContext::mapRangeSparseCallback)
     , m_savedRange(ZERO)
     , m_numSparsePages(ZERO)
+    , m_addressSpace(0)
 {
 }
 
 MemoryContext::~MemoryContext()
 {
+    // The identifier's stale TLB entries are flushed when it is assigned again
+    if (m_addressSpace)
+    {
+        m_addressSpaces[m_addressSpace / 8] &= ~(1 << (m_addressSpace % 8));
+        m_addressSpaceCount--;
+    }
 }
 
 MemoryContext * MemoryContext::getCurrent()
@@ -48,8 +60,157 @@ MemoryContext * MemoryContext::getCurrent()
     return m_current;
 }
 
+Size MemoryContext::getAddressSpace() const
+{
+    return m_addressSpace;
+}
+
+bool MemoryContext::assignAddressSpace(const Size count)
+{
+    const Size max = count < MaxAddressSpaces ? count : MaxAddressSpaces;
+
+    // Identifier zero is never assigned
+    if (m_addressSpaceCount >= max - 1)
+        return false;
+
+    for (Size id = 1; id < max; id++)
+    {
+        if (!(m_addressSpaces[id / 8] & (1 << (id % 8))))
+        {
+            m_addressSpaces[id / 8] |= (1 << (id % 8));
+            m_addressSpaceCount++;
+            m_addressSpace = id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Size MemoryContext::largePageSize() const
+{
+    return 0;
+}
+
+MemoryContext::Result MemoryContext::mapLarge(Address virt, Address phys, Memory::Access access)
+{
+    return InvalidSize;
+}
+
+MemoryContext::Result MemoryContext::unmapLarge(Address virt)
+{
+    return InvalidAddress;
+}
+
+bool MemoryContext::isLarge(Address virt) const
+{
+    return false;
+}
+
+bool MemoryContext::hasPageTable(Address virt) const
+{
+    return true;
+}
+
+MemoryContext::Result MemoryContext::reserve(Address virt, Memory::Access access)
+{
+    return InvalidAddress;
+}
+
+bool MemoryContext::isReserved(Address virt, Memory::Access *access) const
+{
+    return false;
+}
+
+MemoryContext::Result MemoryContext::markCopyOnWrite(Address virt)
+{
+    return InvalidAddress;
+}
+
+bool MemoryContext::isCopyOnWrite(Address virt) const
+{
+    return false;
+}
+
+MemoryContext::Result MemoryContext::fault(Address virt)
+{
+    const Address page = virt & PAGEMASK;
+    Memory::Access acc;
+
+    if (isReserved(page, &acc))
+        return resolveReserved(page, acc);
+    else if (isCopyOnWrite(page))
+        return resolveCopyOnWrite(page);
+    else
+        return InvalidAddress;
+}
+
+MemoryContext::Result MemoryContext::cloneRange(MemoryContext *target,
+                                                const Memory::Range & range,
+                                                const bool copyOnWrite)
+{
+    const Address allocBase = m_alloc->base();
+    const Size allocSize = m_alloc->size();
+    Memory::Access acc;
+    Address phys;
+    Result r;
+
+    for (Size i = 0; i < range.size; i += PAGESIZE)
+    {
+        const Address addr = range.virt + i;
+        bool copy = false;
+
+        // Pages which were never accessed stay demand-zero in the target
+        if (isReserved(addr, &acc))
+        {
+            if ((r = target->reserve(addr, acc)) != Success)
+                return r;
+            continue;
+        }
+
+        if (lookup(addr, &phys) != Success || access(addr, &acc) != Success)
+            continue;
+
+        phys &= PAGEMASK;
+
+        // Only allocated memory can be shared by reference. Other pages,
+        // such as device memory, are mapped into the target unchanged.
+        if (phys < allocBase || phys >= allocBase + allocSize ||
+            !m_alloc->isAllocated(phys) || (acc & Memory::Device))
+        {
+            if ((r = target->map(addr, phys, acc)) != Success)
+                return r;
+            continue;
+        }
+
+        // Pages which are already copy-on-write are anonymous memory
+        if ((copyOnWrite && (acc & Memory::Writable)) || isCopyOnWrite(addr))
+        {
+            // Large pages are copied per page
+            if (isLarge(addr) && (r = splitLarge(addr)) != Success)
+                return r;
+
+            if ((r = markCopyOnWrite(addr)) != Success)
+                return r;
+
+            copy = true;
+        }
+
+        if ((r = target->map(addr, phys, acc)) != Success)
+            return r;
+
+        if (copy && (r = target->markCopyOnWrite(addr)) != Success)
+            return r;
+
+        m_alloc->reference(phys);
+    }
+
+    return Success;
+}
+
 MemoryContext::Result MemoryContext::mapRangeContiguous(Memory::Range *range)
 {
+    const Size large = largePageSize();
     Result r = Success;
 
     // Allocate a block of contiguous physical pages, if needed.
@@ -60,19 +221,39 @@ MemoryContext::Result MemoryContext::mapRangeContiguous(Memory::Range *range)
         alloc_args.size = range->size;
         alloc_args.alignment = PAGESIZE;
 
-        if (m_alloc->allocate(alloc_args) != Allocator::Success)
+        // Prefer physical memory which can be mapped with large pages
+        if (large && range->size >= large && !(range->virt % large))
+        {
+            alloc_args.alignment = large;
+
+            if (m_alloc->allocate(alloc_args) != Allocator::Success)
+                alloc_args.alignment = PAGESIZE;
+        }
+
+        if (alloc_args.alignment == PAGESIZE && m_alloc->allocate(alloc_args) != Allocator::Success)
             return OutOfMemory;
 
         range->phys = alloc_args.address;
     }
 
     // Insert virtual page(s)
-    for (Size i = 0; i < range->size; i += PAGESIZE)
+    for (Size i = 0; i < range->size;)
     {
+        // Use a large page if the range allows it
+        if (large && range->size - i >= large &&
+            !((range->virt + i) % large) && !((range->phys + i) % large) &&
+            mapLarge(range->virt + i, range->phys + i, range->access) == Success)
+        {
+            i += large;
+            continue;
+        }
+
         if ((r = map(range->virt + i,
                      range->phys + i,
                      range->access)) != Success)
             break;
+
+        i += PAGESIZE;
     }
 
     return r;
@@ -97,13 +278,44 @@ MemoryContext::Result MemoryContext::mapRangeSparse(Memory::Range *range)
     return Success;
 }
 
-MemoryContext::Result MemoryContext::unmapRange(Memory::Range *range)
+MemoryContext::Result MemoryContext::mapRangeLazy(Memory::Range *range)
 {
     Result r = Success;
 
     for (Size i = 0; i < range->size; i += PAGESIZE)
-        if ((r = unmap(range->virt + i)) != Success)
+    {
+        if ((r = reserve(range->virt + i, range->access)) != Success)
             break;
+    }
+
+    return r;
+}
+
+MemoryContext::Result MemoryContext::unmapRange(Memory::Range *range)
+{
+    const Size large = largePageSize();
+    Result r = splitRange(*range);
+
+    if (r != Success)
+        return r;
+
+    for (Size i = 0; i < range->size;)
+    {
+        if (large && isLarge(range->virt + i))
+        {
+            if ((r = unmapLarge(range->virt + i)) != Success)
+                break;
+
+            i += large;
+        }
+        else
+        {
+            if ((r = unmap(range->virt + i)) != Success)
+                break;
+
+            i += PAGESIZE;
+        }
+    }
 
     return r;
 }
@@ -120,14 +332,87 @@ MemoryContext::Result MemoryContext::release(Address virt)
 }
 
 MemoryContext::Result MemoryContext::findFree(Size size, MemoryMap::Region region, Address *virt) const
+{
+    const Size large = largePageSize();
+
+    // Prefer a block on a large page boundary, such that it can use large pages
+    if (large && size >= large && findFreeAligned(size, region, virt, large) == Success)
+        return Success;
+
+    return findFreeAligned(size, region, virt, PAGESIZE);
+}
+
+MemoryContext::Result MemoryContext::usage(MemoryContext::Usage & usage) const
+{
+    usage.reserved = 0;
+    usage.image    = mappedSize(MemoryMap::UserData, &usage.reserved);
+    usage.heap     = mappedSize(MemoryMap::UserHeap, &usage.reserved);
+    usage.stack    = mappedSize(MemoryMap::UserStack, &usage.reserved);
+    usage.mapped   = mappedSize(MemoryMap::UserPrivate, &usage.reserved);
+    usage.share    = mappedSize(MemoryMap::UserShare, &usage.reserved);
+
+    return Success;
+}
+
+Size MemoryContext::mappedSize(MemoryMap::Region region, Size *reserved) const
+{
+    const Memory::Range r = m_map->range(region);
+    const Size large = largePageSize();
+    Size mapped = 0;
+    Address addr = r.virt, tmp;
+    Memory::Access acc;
+
+    while (addr < r.virt + r.size)
+    {
+        // Large pages are counted at once
+        if (large && !(addr % large) && addr + large <= r.virt + r.size && isLarge(addr))
+        {
+            mapped += large;
+            addr += large;
+            continue;
+        }
+
+        // Skip the range of an absent page table
+        if (large && !isLarge(addr) && !hasPageTable(addr))
+        {
+            const Address next = addr - (addr % large) + large;
+
+            if (next <= addr)
+                break;
+
+            addr = next;
+            continue;
+        }
+
+        if (lookup(addr, &tmp) == Success)
+            mapped += PAGESIZE;
+        else if (isReserved(addr, &acc))
+            *reserved += PAGESIZE;
+
+        addr += PAGESIZE;
+    }
+
+    return mapped;
+}
+
+MemoryContext::Result MemoryContext::findFreeAligned(Size size,
+                                                     MemoryMap::Region region,
+                                                     Address *virt,
+                                                     Size alignment) const
 {
     Memory::Range r = m_map->range(region);
     Size currentSize = 0;
     Address addr = r.virt, currentAddr = r.virt, tmp;
+    Memory::Access acc;
 
     while (addr < r.virt+r.size && currentSize < size)
     {
-        if (lookup(addr, &tmp) == InvalidAddress)
+        // The block must start at the given alignment
+        if (currentSize == 0 && (addr % alignment))
+        {
+            currentAddr = addr + PAGESIZE;
+        }
+        else if (lookup(addr, &tmp) == InvalidAddress && !isReserved(addr, &acc))
         {
             currentSize += PAGESIZE;
         }
@@ -148,6 +433,127 @@ MemoryContext::Result MemoryContext::findFree(Size size, MemoryMap::Region regio
         return OutOfMemory;
 }
 
+MemoryContext::Result MemoryContext::splitLarge(Address virt)
+{
+    const Size large = largePageSize();
+    const Address base = virt - (virt % large);
+    Memory::Access acc;
+    Address phys;
+    Result r;
+
+    if ((r = lookup(base, &phys)) != Success || (r = access(base, &acc)) != Success)
+        return r;
+
+    if ((r = unmapLarge(base)) != Success)
+        return r;
+
+    // Only the first page may need to allocate a new page table
+    for (Size i = 0; i < large; i += PAGESIZE)
+    {
+        if ((r = map(base + i, phys + i, acc)) != Success)
+        {
+            if (i == 0)
+                mapLarge(base, phys, acc);
+            return r;
+        }
+    }
+
+    return Success;
+}
+
+MemoryContext::Result MemoryContext::splitRange(const Memory::Range & range)
+{
+    const Size large = largePageSize();
+    const Address last = range.virt + range.size - 1;
+    Result r = Success;
+
+    if (!large || !range.size)
+        return Success;
+
+    // Split the large page at the start of the range, if only partially inside
+    if (isLarge(range.virt) &&
+       ((range.virt % large) || (range.virt - (range.virt % large)) + large - 1 > last))
+    {
+        if ((r = splitLarge(range.virt)) != Success)
+            return r;
+    }
+
+    // Split the large page at the end of the range, if only partially inside
+    if (isLarge(last) && ((last + 1) % large) != 0)
+    {
+        r = splitLarge(last);
+    }
+
+    return r;
+}
+
+MemoryContext::Result MemoryContext::resolveReserved(Address page, Memory::Access access)
+{
+    Allocator::Range phys, vaddr;
+    Arch::Cache cache;
+    Result r;
+
+    phys.address = 0;
+    phys.size = PAGESIZE;
+    phys.alignment = PAGESIZE;
+
+    // Zero the page on first access
+    if (m_alloc->allocateZeroed(phys, vaddr) != Allocator::Success)
+        return OutOfMemory;
+
+    cache.cleanData(vaddr.address);
+
+    if ((r = map(page, phys.address, access)) != Success)
+        m_alloc->release(phys.address);
+
+    return r;
+}
+
+MemoryContext::Result MemoryContext::resolveCopyOnWrite(Address page)
+{
+    Allocator::Range phys, vaddr;
+    Memory::Access acc;
+    Address old;
+    Arch::Cache cache;
+    Result r;
+
+    if ((r = lookup(page, &old)) != Success || (r = access(page, &acc)) != Success)
+        return r;
+
+    old &= PAGEMASK;
+    acc |= Memory::Writable;
+
+    // The last reference owns the page and can simply write to it
+    if (m_alloc->getReferenceCount(old) <= 1)
+    {
+        unmap(page);
+        return map(page, old, acc);
+    }
+
+    phys.address = 0;
+    phys.size = PAGESIZE;
+    phys.alignment = PAGESIZE;
+
+    if (m_alloc->allocate(phys, vaddr) != Allocator::Success)
+        return OutOfMemory;
+
+    MemoryBlock::copy((void *) vaddr.address, (void *) m_alloc->toVirtual(old), PAGESIZE);
+    cache.cleanData(vaddr.address);
+
+    unmap(page);
+
+    if ((r = map(page, phys.address, acc)) != Success)
+    {
+        map(page, old, (Memory::Access) (acc & ~Memory::Writable));
+        markCopyOnWrite(page);
+        m_alloc->release(phys.address);
+        return r;
+    }
+
+    m_alloc->release(old);
+    return Success;
+}
+
 void MemoryContext::mapRangeSparseCallback(Address *phys)
 {
     Result r = Success;
@@ -43,6 +43,9 @@ class MemoryContext
 {
   public:
 
+    /** Maximum number of address space identifiers */
+    static const Size MaxAddressSpaces = 256;
+
     /**
      * Result codes.
      */
@@ -57,6 +60,33 @@ class MemoryContext
     }
     Result;
 
+    /**
+     * Physical memory usage per category of mappings.
+     *
+     * All values are in bytes.
+     */
+    typedef struct Usage
+    {
+        /** Program image loaded from the executable, e.g. code, bss, (ro)data */
+        Size image;
+
+        /** Heap pages */
+        Size heap;
+
+        /** Stack pages */
+        Size stack;
+
+        /** Private dynamic mappings, e.g. contiguous or mapped IO ranges */
+        Size mapped;
+
+        /** Shared memory mappings */
+        Size share;
+
+        /** Pages reserved for demand-zero mapping which are not backed yet */
+        Size reserved;
+    }
+    Usage;
+
     /**
      * Constructor.
      *
@@ -77,6 +107,16 @@ class MemoryContext
      */
     static MemoryContext * getCurrent();
 
+    /**
+     * Get the address space identifier.
+     *
+     * Address space identifiers tag the TLB entries of a MemoryContext,
+     * such that they do not need to be flushed when switching contexts.
+     *
+     * @return Address space identifier or zero if none is assigned.
+     */
+    Size getAddressSpace() const;
+
     /**
      * Initialize the MemoryContext
      *
@@ -138,9 +178,137 @@ class MemoryContext
      */
     virtual Result access(Address virt, Memory::Access *access) const = 0;
 
+    /**
+     * Get the size of a large page.
+     *
+     * @return Size of a large page in bytes or zero if not supported.
+     */
+    virtual Size largePageSize() const;
+
+    /**
+     * Map a large page of physical memory to a virtual address.
+     *
+     * @param virt Virtual address aligned to the large page size.
+     * @param phys Physical address aligned to the large page size.
+     * @param access Page entry protection flags.
+     *
+     * @return Result code.
+     */
+    virtual Result mapLarge(Address virt, Address phys, Memory::Access access);
+
+    /**
+     * Unmap a large page.
+     *
+     * @param virt Virtual address inside the large page.
+     *
+     * @return Result code
+     */
+    virtual Result unmapLarge(Address virt);
+
+    /**
+     * Check if a virtual address is mapped by a large page.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if mapped by a large page, false otherwise.
+     */
+    virtual bool isLarge(Address virt) const;
+
+    /**
+     * Check if a second level page table is present for a virtual address.
+     *
+     * A second level page table covers largePageSize() bytes. Without it,
+     * no page in that range is mapped or reserved.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if present or unknown, false otherwise.
+     */
+    virtual bool hasPageTable(Address virt) const;
+
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * The page is not backed by physical memory until it
+     * is first accessed, which is resolved by fault().
+     *
+     * @param virt Virtual address to reserve.
+     * @param access Page entry protection flags to use when mapped.
+     *
+     * @return Result code.
+     */
+    virtual Result reserve(Address virt, Memory::Access access);
+
+    /**
+     * Check if a virtual address is reserved for demand-zero mapping.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved protection flags.
+     *
+     * @return True if reserved, false otherwise.
+     */
+    virtual bool isReserved(Address virt, Memory::Access *access) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * The page is made read-only until the first write
+     * to it, which is resolved by fault().
+     *
+     * @param virt Virtual address of the page.
+     *
+     * @return Result code.
+     */
+    virtual Result markCopyOnWrite(Address virt);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    virtual bool isCopyOnWrite(Address virt) const;
+
+    /**
+     * Resolve a fault on a reserved or copy-on-write virtual address.
+     *
+     * For a reserved address a zeroed physical page is allocated and
+     * mapped at the page containing the given address. For a copy-on-write
+     * address the page is copied, unless it is no longer shared.
+     *
+     * @param virt Virtual address which caused the fault.
+     *
+     * @return Result code. InvalidAddress if the address is
+     *         neither reserved nor copy-on-write.
+     */
+    virtual Result fault(Address virt);
+
+    /**
+     * Clone a range of virtual memory into another MemoryContext.
+     *
+     * Writable pages are shared copy-on-write between both contexts
+     * and read-only pages are shared directly. Reserved pages stay
+     * reserved in the target and unmapped pages are skipped.
+     *
+     * @param target MemoryContext to receive the mappings.
+     * @param range Range of virtual memory to clone.
+     * @param copyOnWrite False to share writable pages directly. Use for
+     *                    mappings which are not anonymous memory, such as
+     *                    DMA buffers and pages of other processes.
+     *
+     * @return Result code.
+     */
+    virtual Result cloneRange(MemoryContext *target,
+                              const Memory::Range & range,
+                              const bool copyOnWrite = true);
+
     /**
      * Map a range of contiguous physical pages to virtual addresses.
      *
+     * Large pages are used for the parts of the range where both the
+     * virtual and physical addresses are aligned to the large page size.
+     *
      * @param range Range object describing the range of physical pages.
      *
      * @return Result code.
@@ -156,9 +324,25 @@ class MemoryContext
      */
     virtual Result mapRangeSparse(Memory::Range *range);
 
+    /**
+     * Reserve a range of virtual addresses for demand-zero mapping.
+     *
+     * Physical pages are allocated and zeroed on first access.
+     *
+     * @param range Range object describing the range of virtual addresses.
+     *
+     * @return Result code.
+     *
+     * @see fault
+     */
+    virtual Result mapRangeLazy(Memory::Range *range);
+
     /**
      * Unmaps a range of virtual memory.
      *
+     * Large pages which are only partially inside the range are
+     * split into small pages first.
+     *
      * @param range Range object describing the range of virtual addresses.
      *
      * @return Result code
@@ -204,6 +388,9 @@ class MemoryContext
      * This function finds a contigeous block of a given size
      * of virtual memory which is unused and then returns
      * the virtual address of the first page in the block.
+     * Pages reserved for demand-zero mapping are not free.
+     * Blocks of at least the large page size are placed on
+     * a large page boundary when possible.
      *
      * @param region Memory region to search in.
      * @param size Number of bytes requested to be free.
@@ -213,6 +400,19 @@ class MemoryContext
      */
     virtual Result findFree(Size size, MemoryMap::Region region, Address *virt) const;
 
+    /**
+     * Get the physical memory usage of this MemoryContext.
+     *
+     * Mapped pages are counted per user memory region by walking
+     * the page tables, such that the result is exact but takes
+     * time proportional to the size of the user memory regions.
+     *
+     * @param usage Usage object on output.
+     *
+     * @return Result code
+     */
+    virtual Result usage(Usage & usage) const;
+
     /**
      * Callback to provide intermediate Range object during mapRangeSparse()
      *
@@ -222,6 +422,87 @@ class MemoryContext
      */
     virtual void mapRangeSparseCallback(Address *phys);
 
+  protected:
+
+    /**
+     * Find unused memory at the given alignment.
+     *
+     * @param size Number of bytes requested to be free.
+     * @param region Memory region to search in.
+     * @param virt Virtual memory address on output.
+     * @param alignment Alignment of the first page in the block.
+     *
+     * @return Result code
+     *
+     * @see findFree
+     */
+    Result findFreeAligned(Size size,
+                           MemoryMap::Region region,
+                           Address *virt,
+                           Size alignment) const;
+
+    /**
+     * Assign a free address space identifier.
+     *
+     * Identifier zero is reserved for contexts without an identifier,
+     * which must flush the TLB when activated.
+     *
+     * @param count Number of identifiers supported by the hardware.
+     *
+     * @return True if an identifier was assigned, false if none are free.
+     */
+    bool assignAddressSpace(const Size count);
+
+    /**
+     * Count mapped memory in a memory region.
+     *
+     * @param region Memory region to count.
+     * @param reserved Incremented with the number of reserved bytes.
+     *
+     * @return Number of mapped bytes in the region.
+     */
+    Size mappedSize(MemoryMap::Region region, Size *reserved) const;
+
+    /**
+     * Replace a large page mapping by small page mappings.
+     *
+     * @param virt Virtual address inside the large page.
+     *
+     * @return Result code
+     */
+    Result splitLarge(Address virt);
+
+    /**
+     * Split large pages at the edges of a range.
+     *
+     * This ensures that every large page mapping inside the
+     * range is covered completely by the range.
+     *
+     * @param range Range of virtual memory.
+     *
+     * @return Result code
+     */
+    Result splitRange(const Memory::Range & range);
+
+    /**
+     * Map a zeroed physical page at a reserved virtual address.
+     *
+     * @param page Virtual address of the reserved page.
+     * @param access Reserved protection flags.
+     *
+     * @return Result code
+     */
+    Result resolveReserved(Address page, Memory::Access access);
+
+    /**
+     * Give a copy-on-write page a private writable copy.
+     *
+     * @param page Virtual address of the copy-on-write page.
+     *
+     * @return Result code
+     */
+    Result resolveCopyOnWrite(Address page);
+
   protected:
 
     /** Physical memory allocator */
@@ -241,6 +522,17 @@ class MemoryContext
 
     /** Number of pages allocated via mapRangeSparse Callback. */
     Size m_numSparsePages;
+
+    /** Address space identifier or zero if none is assigned. */
+    Size m_addressSpace;
+
+  private:
+
+    /** Bitmap of address space identifiers in use */
+    static u8 m_addressSpaces[MaxAddressSpaces / 8];
+
+    /** Number of address space identifiers in use */
+    static Size m_addressSpaceCount;
 };
 
 /**
@@ -39,6 +39,7 @@ u32 ARMControl::read(Register reg) const
         case TranslationTableCtrl:    return mrc(p15, 0, 2, c2,  c0);
         case DomainControl:           return mrc(p15, 0, 0, c3,  c0);
         case UserProcID:              return mrc(p15, 0, 4, c13, c0);
+        case ContextID:               return mrc(p15, 0, 1, c13, c0);
         case InstructionFaultAddress: return mrc(p15, 0, 2, c6, c0);
         case InstructionFaultStatus:  return mrc(p15, 0, 1, c5, c0);
         case DataFaultAddress:        return mrc(p15, 0, 0, c6, c0);
@@ -67,6 +68,7 @@ void ARMControl::write(Register reg, u32 value)
         case DataTLBClear:          mcr(p15, 0, 0, c8,  c6, value); break;
         case UnifiedTLBClear:       mcr(p15, 0, 0, c8,  c7, value); break;
         case UserProcID:            mcr(p15, 0, 4, c13, c0, value); break;
+        case ContextID:             mcr(p15, 0, 1, c13, c0, value); break;
         default: break;
     }
 }
@@ -69,6 +69,7 @@ class ARMControl
         DataTLBClear,
         UnifiedTLBClear,
         UserProcID,
+        ContextID,
         InstructionFaultAddress,
         InstructionFaultStatus,
         DataFaultAddress,
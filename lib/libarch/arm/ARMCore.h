@@ -164,11 +164,25 @@ inline void tlb_flush_all()
 }
 #endif /* ARMV6 */
 
+/**
+ * Invalidate the TLB entry of a page.
+ *
+ * The lower bits of the page address hold the address space identifier.
+ * Global entries of the page are invalidated for any identifier.
+ */
 #define tlb_invalidate(page) \
 ({ \
     mcr(p15, 0, 1, c8, c7, (page)); \
 })
 
+/**
+ * Invalidate all non-global TLB entries of an address space identifier.
+ */
+#define tlb_invalidate_asid(asid) \
+({ \
+    mcr(p15, 0, 2, c8, c7, (asid)); \
+})
+
 /**
  * Data Memory Barrier
  *
@@ -17,7 +17,6 @@
 
 #include <FreeNOS/System.h>
 #include <SplitAllocator.h>
-#include <MemoryBlock.h>
 #include "ARMCore.h"
 #include "ARMConstant.h"
 #include "ARMFirstTable.h"
@@ -96,6 +95,9 @@
 /* System access permissions flag */
 #define PAGE1_AP_SYS    (1 << 10)
 
+/* Not-global flag, tags the TLB entry with the address space identifier */
+#define PAGE1_NOTGLOBAL (1 << 17)
+
 /**
  * @}
  */
@@ -110,6 +112,11 @@
 #define DIRENTRY(vaddr) \
     ((vaddr) >> DIRSHIFT)
 
+bool ARMFirstTable::hasSecondTable(Address virt, SplitAllocator *alloc) const
+{
+    return getSecondTable(virt, alloc) != ZERO;
+}
+
 ARMSecondTable * ARMFirstTable::getSecondTable(Address virt, SplitAllocator *alloc) const
 {
     u32 entry = m_tables[ DIRENTRY(virt) ];
@@ -121,38 +128,89 @@ ARMSecondTable * ARMFirstTable::getSecondTable(Address virt, SplitAllocator *all
         return (ARMSecondTable *) alloc->toVirtual(entry & PAGEMASK);
 }
 
+MemoryContext::Result ARMFirstTable::getOrAllocateSecondTable(Address virt,
+                                                              SplitAllocator *alloc,
+                                                              ARMSecondTable **table)
+{
+    Arch::Cache cache;
+    Allocator::Range allocPhys, allocVirt;
+
+    // Check if the page table is present.
+    if ((*table = getSecondTable(virt, alloc)) != ZERO)
+        return MemoryContext::Success;
+
+    // Reject if already mapped as a (super)section
+    if (m_tables[ DIRENTRY(virt) ] & PAGE1_SECTION)
+        return MemoryContext::AlreadyExists;
+
+    // Allocate a new page table
+    allocPhys.address = 0;
+    allocPhys.size = sizeof(ARMSecondTable);
+    allocPhys.alignment = PAGESIZE;
+
+    if (alloc->allocateZeroed(allocPhys, allocVirt) != Allocator::Success)
+        return MemoryContext::OutOfMemory;
+
+    // Assign to the page directory. Do not assign permission flags (only for direct sections).
+    m_tables[ DIRENTRY(virt) ] = allocPhys.address | PAGE1_TABLE;
+    cache.cleanData(&m_tables[DIRENTRY(virt)]);
+    *table = getSecondTable(virt, alloc);
+    return MemoryContext::Success;
+}
+
 MemoryContext::Result ARMFirstTable::map(Address virt,
                                          Address phys,
                                          Memory::Access access,
                                          SplitAllocator *alloc)
+{
+    ARMSecondTable *table;
+    const MemoryContext::Result r = getOrAllocateSecondTable(virt, alloc, &table);
+
+    if (r != MemoryContext::Success)
+        return r;
+
+    return table->map(virt, phys, access);
+}
+
+MemoryContext::Result ARMFirstTable::reserve(Address virt,
+                                             Memory::Access access,
+                                             SplitAllocator *alloc)
+{
+    ARMSecondTable *table;
+    const MemoryContext::Result r = getOrAllocateSecondTable(virt, alloc, &table);
+
+    if (r != MemoryContext::Success)
+        return r;
+
+    return table->reserve(virt, access);
+}
+
+bool ARMFirstTable::isReserved(Address virt,
+                               Memory::Access *access,
+                               SplitAllocator *alloc) const
 {
     ARMSecondTable *table = getSecondTable(virt, alloc);
-    Arch::Cache cache;
-    Allocator::Range allocPhys, allocVirt;
 
-    // Check if the page table is present.
-    if (!table)
-    {
-        // Reject if already mapped as a (super)section
-        if (m_tables[ DIRENTRY(virt) ] & PAGE1_SECTION)
-            return MemoryContext::AlreadyExists;
+    return table != ZERO && table->isReserved(virt, access);
+}
 
-        // Allocate a new page table
-        allocPhys.address = 0;
-        allocPhys.size = sizeof(ARMSecondTable);
-        allocPhys.alignment = PAGESIZE;
+MemoryContext::Result ARMFirstTable::markCopyOnWrite(Address virt,
+                                                     SplitAllocator *alloc)
+{
+    ARMSecondTable *table = getSecondTable(virt, alloc);
 
-        if (alloc->allocate(allocPhys, allocVirt) != Allocator::Success)
-            return MemoryContext::OutOfMemory;
+    if (!table)
+        return MemoryContext::InvalidAddress;
+    else
+        return table->markCopyOnWrite(virt);
+}
 
-        MemoryBlock::set((void *)allocVirt.address, 0, PAGESIZE);
+bool ARMFirstTable::isCopyOnWrite(Address virt,
+                                  SplitAllocator *alloc) const
+{
+    ARMSecondTable *table = getSecondTable(virt, alloc);
 
-        // Assign to the page directory. Do not assign permission flags (only for direct sections).
-        m_tables[ DIRENTRY(virt) ] = allocPhys.address | PAGE1_TABLE;
-        cache.cleanData(&m_tables[DIRENTRY(virt)]);
-        table = getSecondTable(virt, alloc);
-    }
-    return table->map(virt, phys, access);
+    return table != ZERO && table->isCopyOnWrite(virt);
 }
 
 MemoryContext::Result ARMFirstTable::mapLarge(Memory::Range range,
@@ -224,18 +282,53 @@ MemoryContext::Result ARMFirstTable::access(Address virt,
 {
     ARMSecondTable *table = getSecondTable(virt, alloc);
     if (!table)
-        return MemoryContext::InvalidAddress;
+    {
+        const u32 entry = m_tables[ DIRENTRY(virt) ];
+        const u32 cache = entry & (PAGE1_TEX | PAGE1_CACHE | PAGE1_BUFFER);
+
+        if (!isLarge(virt))
+            return MemoryContext::InvalidAddress;
+
+        // Permissions
+        *access = Memory::Readable;
+
+        if (!(entry & PAGE1_NOEXEC))
+            *access |= Memory::Executable;
+
+        if (entry & PAGE1_AP_USER)
+            *access |= Memory::User;
+
+        if (!(entry & PAGE1_APX))
+            *access |= Memory::Writable;
+
+        // Caching
+        if (cache == PAGE1_DEVICE_SHARED)
+            *access |= Memory::Device;
+        else if (cache == PAGE1_UNCACHED)
+            *access |= Memory::Uncached;
+        else
+            *access |= Memory::InnerCached | Memory::OuterCached;
+
+        return MemoryContext::Success;
+    }
     else
         return table->access(virt, access);
 }
 
+bool ARMFirstTable::isLarge(Address virt) const
+{
+    const u32 entry = m_tables[ DIRENTRY(virt) ];
+
+    return !(entry & PAGE1_TABLE) && (entry & PAGE1_SECTION);
+}
+
 u32 ARMFirstTable::flags(Memory::Access access) const
 {
     u32 f = PAGE1_AP_SYS;
 
     // Permissions
     if (!(access & Memory::Executable)) f |= PAGE1_NOEXEC;
-    if ((access & Memory::User))        f |= PAGE1_AP_USER;
+    if ((access & Memory::User))        f |= PAGE1_AP_USER | PAGE1_NOTGLOBAL;
     if (!(access & Memory::Writable))   f |= PAGE1_APX;
 
     // Caching
@@ -277,12 +370,33 @@ MemoryContext::Result ARMFirstTable::releaseRange(const Memory::Range range,
         ARMSecondTable *table = getSecondTable(addr, alloc);
         if (table == ZERO)
         {
+            // Release a section, which must be completely inside the range
+            if (isLarge(addr) && !(addr & ~SECTIONMASK) &&
+                addr + MegaByte(1) <= range.virt + range.size)
+            {
+                const Address section = m_tables[ DIRENTRY(addr) ] & SECTIONMASK;
+
+                for (Size i = 0; i < MegaByte(1); i += PAGESIZE)
+                {
+                    releasePhysical(alloc, section + i);
+                }
+                unmap(addr, alloc);
+                addr += MegaByte(1) - PAGESIZE;
+                continue;
+            }
             return MemoryContext::InvalidAddress;
         }
 
         if (table->translate(addr, &phys) != MemoryContext::Success)
         {
-            return MemoryContext::InvalidAddress;
+            // Reserved pages which were never accessed have no physical page
+            Memory::Access acc;
+
+            if (!table->isReserved(addr, &acc))
+                return MemoryContext::InvalidAddress;
+
+            table->unmap(addr);
+            continue;
         }
 
         releasePhysical(alloc, phys);
@@ -310,6 +424,17 @@ MemoryContext::Result ARMFirstTable::releaseSection(const Memory::Range range,
         ARMSecondTable *table = getSecondTable(addr, alloc);
         if (!table)
         {
+            // Sections have no page table, only release the mapped pages
+            if (isLarge(addr))
+            {
+                const Address section = m_tables[ DIRENTRY(addr) ] & SECTIONMASK;
+
+                for (Size i = 0; i < MegaByte(1) && !tablesOnly; i += PAGESIZE)
+                {
+                    releasePhysical(alloc, section + i);
+                }
+                unmap(addr, alloc);
+            }
             continue;
         }
 
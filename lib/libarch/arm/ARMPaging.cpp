@@ -167,6 +167,7 @@ MemoryContext::Result ARMPaging::enableMMU()
     ));
     ctrl.write(ARMControl::TranslationTable1,    0);
     ctrl.write(ARMControl::TranslationTableCtrl, 0);
+    ctrl.write(ARMControl::ContextID, m_addressSpace);
     dsb();
     isb();
 
@@ -217,14 +218,35 @@ MemoryContext::Result ARMPaging::activate(bool initializeMMU)
         m_cache.cleanInvalidate(Cache::Unified);
 #endif /* ARMV6 */
 
+#ifdef ARMV7
+        // Take an address space identifier on first use. Drop any
+        // TLB entries left behind by its previous owner.
+        if (!m_addressSpace && assignAddressSpace(MaxAddressSpaces))
+        {
+            tlb_invalidate_asid(m_addressSpace);
+            dsb();
+        }
+
+        // Use the reserved identifier while switching, such that no
+        // entries of the new table are tagged with the previous identifier
+        ctrl.write(ARMControl::ContextID, 0);
+        isb();
+#endif /* ARMV7 */
+
         // Switch first page table and re-enable L1 caching
         ctrl.write(ARMControl::TranslationTable0, (((u32) m_firstTableAddr) |
             (1 << 3) | /* outer write-back, write-allocate */
             (1 << 6)   /* inner write-back, write-allocate */
         ));
 
-        // Flush TLB caches
-        tlb_flush_all();
+#ifdef ARMV7
+        isb();
+        ctrl.write(ARMControl::ContextID, m_addressSpace);
+#endif /* ARMV7 */
+
+        // Flush TLB caches, unless the entries are tagged by the identifier
+        if (!m_addressSpace)
+            tlb_flush_all();
 
         // Synchronize execution stream
         isb();
@@ -240,26 +262,97 @@ MemoryContext::Result ARMPaging::map(Address virt, Address phys, Memory::Access
     Result r = m_firstTable->map(virt, phys, acc, m_alloc);
 
     // Flush the TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidate(virt);
 
     // Synchronize execution stream.
     isb();
     return r;
 }
 
-MemoryContext::Result ARMPaging::unmap(Address virt)
+Size ARMPaging::largePageSize() const
+{
+    return MegaByte(1);
+}
+
+MemoryContext::Result ARMPaging::mapLarge(Address virt, Address phys, Memory::Access acc)
+{
+    const Memory::Range range = { virt, phys, MegaByte(1), acc };
+
+    // Modify page tables
+    Result r = m_firstTable->mapLarge(range, m_alloc);
+
+    // Flush the TLB to refresh the mapping
+    invalidate(virt);
+
+    // Synchronize execution stream.
+    isb();
+    return r;
+}
+
+MemoryContext::Result ARMPaging::unmapLarge(Address virt)
 {
-    // Clean the given data page in cache
+    if (!m_firstTable->isLarge(virt))
+        return InvalidAddress;
+
+    return unmap(virt);
+}
+
+bool ARMPaging::isLarge(Address virt) const
+{
+    return m_firstTable->isLarge(virt);
+}
+
+bool ARMPaging::hasPageTable(Address virt) const
+{
+    return m_firstTable->hasSecondTable(virt, m_alloc);
+}
+
+MemoryContext::Result ARMPaging::reserve(Address virt, Memory::Access acc)
+{
+    return m_firstTable->reserve(virt, acc, m_alloc);
+}
+
+bool ARMPaging::isReserved(Address virt, Memory::Access *acc) const
+{
+    return m_firstTable->isReserved(virt, acc, m_alloc);
+}
+
+MemoryContext::Result ARMPaging::markCopyOnWrite(Address virt)
+{
+    // Write back the data page before it becomes shared
     if (m_current == this)
+        m_cache.cleanAddress(Cache::Data, virt);
+
+    // Modify page tables
+    Result r = m_firstTable->markCopyOnWrite(virt, m_alloc);
+
+    // Flush TLB to refresh the mapping
+    invalidate(virt);
+
+    // Synchronize execution stream
+    isb();
+    return r;
+}
+
+bool ARMPaging::isCopyOnWrite(Address virt) const
+{
+    return m_firstTable->isCopyOnWrite(virt, m_alloc);
+}
+
+MemoryContext::Result ARMPaging::unmap(Address virt)
+{
+    Memory::Access acc;
+
+    // Clean the given data page in cache. Reserved pages have no data and
+    // cache maintenance on them would fault the page in.
+    if (m_current == this && !isReserved(virt, &acc))
         m_cache.cleanInvalidateAddress(Cache::Data, virt);
 
     // Modify page tables
     Result r = m_firstTable->unmap(virt, m_alloc);
 
     // Flush TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidate(virt);
 
     // Synchronize execution stream
     isb();
@@ -279,10 +372,40 @@ MemoryContext::Result ARMPaging::access(Address virt, Memory::Access *access) co
 MemoryContext::Result ARMPaging::releaseSection(const Memory::Range & range,
                                                 const bool tablesOnly)
 {
-    return m_firstTable->releaseSection(range, m_alloc, tablesOnly);
+    const Result r = m_firstTable->releaseSection(range, m_alloc, tablesOnly);
+
+    // Sections are too large to flush per page. Drop all entries of the
+    // address space instead, such that no stale mapping survives.
+    if (m_addressSpace)
+        tlb_invalidate_asid(m_addressSpace);
+    else if (m_current == this)
+        tlb_flush_all();
+
+    isb();
+    return r;
 }
 
 MemoryContext::Result ARMPaging::releaseRange(Memory::Range *range)
 {
-    return m_firstTable->releaseRange(*range, m_alloc);
+    Result r = splitRange(*range);
+
+    if (r != Success)
+        return r;
+
+    r = m_firstTable->releaseRange(*range, m_alloc);
+
+    // Flush TLB entries of the released pages
+    for (Size i = 0; i < range->size; i += PAGESIZE)
+        invalidate(range->virt + i);
+
+    isb();
+    return r;
+}
+
+inline void ARMPaging::invalidate(Address virt)
+{
+    if (m_current == this || m_addressSpace)
+    {
+        tlb_invalidate((virt & PAGEMASK) | m_addressSpace);
+    }
 }
@@ -95,6 +95,89 @@ class ARMPaging : public MemoryContext
      */
     virtual Result map(Address virt, Address phys, Memory::Access access);
 
+    /**
+     * Get the size of a large page.
+     *
+     * @return Size of a large page in bytes.
+     */
+    virtual Size largePageSize() const;
+
+    /**
+     * Map a large page of physical memory to a virtual address.
+     *
+     * @param virt Virtual address aligned to the large page size.
+     * @param phys Physical address aligned to the large page size.
+     * @param access Memory access flags.
+     *
+     * @return Result code
+     */
+    virtual Result mapLarge(Address virt, Address phys, Memory::Access access);
+
+    /**
+     * Unmap a large page.
+     *
+     * @param virt Virtual address inside the large page.
+     *
+     * @return Result code
+     */
+    virtual Result unmapLarge(Address virt);
+
+    /**
+     * Check if a virtual address is mapped by a large page.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if mapped by a large page, false otherwise.
+     */
+    virtual bool isLarge(Address virt) const;
+
+    /**
+     * Check if a second level page table is present for a virtual address.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if present, false otherwise.
+     */
+    virtual bool hasPageTable(Address virt) const;
+
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * @param virt Virtual address.
+     * @param access Memory access flags to use when mapped.
+     *
+     * @return Result code
+     */
+    virtual Result reserve(Address virt, Memory::Access access);
+
+    /**
+     * Check if a virtual address is reserved for demand-zero mapping.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved Memory access flags.
+     *
+     * @return True if reserved, false otherwise.
+     */
+    virtual bool isReserved(Address virt, Memory::Access *access) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * @param virt Virtual address of the page.
+     *
+     * @return Result code
+     */
+    virtual Result markCopyOnWrite(Address virt);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    virtual bool isCopyOnWrite(Address virt) const;
+
     /**
      * Unmap a virtual address.
      *
@@ -169,6 +252,16 @@ class ARMPaging : public MemoryContext
      */
     Result enableMMU();
 
+    /**
+     * Invalidate the TLB entry of a virtual address.
+     *
+     * Contexts with an address space identifier keep their TLB entries
+     * while inactive, thus these are invalidated even when not current.
+     *
+     * @param virt Virtual address to invalidate.
+     */
+    void invalidate(Address virt);
+
   private:
 
     /** Pointer to the first level page table. */
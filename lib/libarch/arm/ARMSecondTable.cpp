@@ -35,6 +35,15 @@
 #define PAGE2_NONE      (0)
 #define PAGE2_PRESENT   (1 << 1)
 
+/**
+ * Software flag for reserved entries. Bits 0 and 1 remain
+ * cleared, such that the hardware treats the entry as a fault.
+ */
+#define PAGE2_RESERVED  (1 << 2)
+
+/** Reserved entries store the Memory::Access flags in the page frame bits */
+#define PAGE2_RESERVED_SHIFT 12
+
 /**
  * @name Second Level Memory Types
  *
@@ -90,6 +99,9 @@
 /* System access permissions flag */
 #define PAGE2_AP_SYS    (1 << 4)
 
+/* Not-global flag, tags the TLB entry with the address space identifier */
+#define PAGE2_NOTGLOBAL (1 << 11)
+
 /**
  * @}
  */
@@ -116,6 +128,7 @@ MemoryContext::Result ARMSecondTable::map(Address virt,
 
     // Insert mapping
     m_pages[ TABENTRY(virt) ] = (phys & PAGEMASK) | PAGE2_PRESENT | flags(access);
+    m_copyOnWrite[ TABENTRY(virt) ] = false;
     cache.cleanData(&m_pages[TABENTRY(virt)]);
     return MemoryContext::Success;
 }
@@ -125,6 +138,7 @@ MemoryContext::Result ARMSecondTable::unmap(Address virt)
     Arch::Cache cache;
 
     m_pages[ TABENTRY(virt) ] = PAGE2_NONE;
+    m_copyOnWrite[ TABENTRY(virt) ] = false;
     cache.cleanData(&m_pages[TABENTRY(virt)]);
     return MemoryContext::Success;
 }
@@ -148,6 +162,9 @@ MemoryContext::Result ARMSecondTable::access(Address virt, Memory::Access *acces
     // Permissions
     *access = Memory::Readable;
 
+    if (!(entry & PAGE2_NOEXEC))
+        *access |= Memory::Executable;
+
     if (entry & PAGE2_AP_USER)
         *access |= Memory::User;
 
@@ -165,13 +182,54 @@ MemoryContext::Result ARMSecondTable::access(Address virt, Memory::Access *acces
     return MemoryContext::Success;
 }
 
+MemoryContext::Result ARMSecondTable::reserve(Address virt, Memory::Access access)
+{
+    Arch::Cache cache;
+
+    if (m_pages[ TABENTRY(virt) ] & PAGE2_PRESENT)
+        return MemoryContext::AlreadyExists;
+
+    m_pages[ TABENTRY(virt) ] = PAGE2_RESERVED | (access << PAGE2_RESERVED_SHIFT);
+    cache.cleanData(&m_pages[TABENTRY(virt)]);
+    return MemoryContext::Success;
+}
+
+bool ARMSecondTable::isReserved(Address virt, Memory::Access *access) const
+{
+    const u32 entry = m_pages[ TABENTRY(virt) ];
+
+    if ((entry & PAGE2_PRESENT) || !(entry & PAGE2_RESERVED))
+        return false;
+
+    *access = (Memory::Access) (entry >> PAGE2_RESERVED_SHIFT);
+    return true;
+}
+
+MemoryContext::Result ARMSecondTable::markCopyOnWrite(Address virt)
+{
+    Arch::Cache cache;
+
+    if (!(m_pages[ TABENTRY(virt) ] & PAGE2_PRESENT))
+        return MemoryContext::InvalidAddress;
+
+    m_pages[ TABENTRY(virt) ] |= PAGE2_APX;
+    m_copyOnWrite[ TABENTRY(virt) ] = true;
+    cache.cleanData(&m_pages[TABENTRY(virt)]);
+    return MemoryContext::Success;
+}
+
+bool ARMSecondTable::isCopyOnWrite(Address virt) const
+{
+    return (m_pages[ TABENTRY(virt) ] & PAGE2_PRESENT) && m_copyOnWrite[ TABENTRY(virt) ];
+}
+
 u32 ARMSecondTable::flags(Memory::Access access) const
 {
     u32 f = PAGE2_AP_SYS;
 
     // Permissions
     if (!(access & Memory::Executable)) f |= PAGE2_NOEXEC;
-    if ((access & Memory::User))        f |= PAGE2_AP_USER;
+    if ((access & Memory::User))        f |= PAGE2_AP_USER | PAGE2_NOTGLOBAL;
     if (!(access & Memory::Writable))   f |= PAGE2_APX;
 
     // Caching
@@ -82,6 +82,50 @@ class ARMSecondTable
      */
     MemoryContext::Result access(Address virt, Memory::Access *access) const;
 
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * The entry stays invalid until the first access, which
+     * is resolved by the abort handler.
+     *
+     * @param virt Virtual address.
+     * @param access Memory access flags to use when mapped.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result reserve(Address virt, Memory::Access access);
+
+    /**
+     * Check if a virtual address is reserved.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved Memory access flags.
+     *
+     * @return True if reserved, false otherwise.
+     */
+    bool isReserved(Address virt, Memory::Access *access) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * The page becomes read-only until the first write,
+     * which is resolved by the abort handler.
+     *
+     * @param virt Virtual address of the page.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result markCopyOnWrite(Address virt);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    bool isCopyOnWrite(Address virt) const;
+
   private:
 
     /**
@@ -97,6 +141,15 @@ class ARMSecondTable
 
     /** Array of second level page table entries */
     u32 m_pages[256];
+
+    /**
+     * Copy-on-write flags per entry.
+     *
+     * Short descriptors have no bits available for software. The MMU
+     * only reads the entries array, so the flags are kept after it
+     * in the same page.
+     */
+    bool m_copyOnWrite[256];
 };
 
 /**
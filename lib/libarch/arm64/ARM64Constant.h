@@ -99,12 +99,20 @@
 #define IS_PT_PAGE_TBL(entry)       (GET_PT_TYPE(entry) == PT_PAGE)
 #define IS_PT_BLOCK(entry)          (GET_PT_TYPE(entry) == PT_BLOCK)
 
+// software defined invalid descriptor, reserved for demand-zero mapping
+#define PT_RESERVED         (1<<2)  // marks a reserved entry, type remains PT_NONE
+#define PT_RESERVED_SHIFT   12      // Memory::Access flags are stored from this bit
+
+// software defined flag for read-only pages which are copied on the first write
+#define PT_COPY             (1UL<<55)
+
 // accessibility
 #define PT_KERNEL       (0<<6)      // privileged, supervisor EL1 access only (default)
 #define PT_USER         (1<<6)      // unprivileged, EL0 access allowed
 #define PT_RW           (0<<7)      // read-write (default)
 #define PT_RO           (1<<7)      // read-only
 #define PT_AF           (1<<10)     // access flag
+#define PT_NG           (1<<11)     // not global, tagged with the address space identifier
 #define PT_NX           (1UL<<54)   // no execute
 
 // shareability
@@ -149,12 +149,27 @@ namespace ARM64Control
 #define PA_RANGE(r) ((r)&0xF)       //Physical Address range supported.
 #define TGRAN4(r)   (((r)>>28)&0xF) //Indicates support for 4KB memory translation granule size.
 
-#define tlb_invalidate(virt) \
+/**
+ * Invalidate the TLB entry of a page for an address space identifier.
+ *
+ * Global entries of the page are invalidated for any identifier.
+ */
+#define tlb_invalidate(virt, asid) \
 ({ \
     asm volatile ("dsb ishst\n"\
-                  "tlbi vaae1is, %0\n" \
+                  "tlbi vae1is, %0\n" \
                   "dsb ish\n" \
-                  "isb" : : "r" (virt>>12UL) );\
+                  "isb" : : "r" (((u64)(asid) << 48) | ((virt) >> 12UL)) );\
+})
+
+/**
+ * Invalidate all non-global TLB entries of an address space identifier.
+ */
+#define tlb_invalidate_asid(asid) \
+({ \
+    asm volatile ("dsb ishst\n"\
+                  "tlbi aside1is, %0\n" \
+                  "dsb ish" : : "r" ((u64)(asid) << 48) );\
 })
 
 /**
@@ -189,9 +204,16 @@ namespace ARM64Control
 /**
  * Reads the CPU's timestamp counter.
  *
+ * Uses the virtual count of the generic timer.
+ *
  * @return 64-bit integer.
  */
-#define timestamp() 0
+inline u64 timestamp()
+{
+    u64 val;
+    asm volatile ("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+}
 
 /**
  * Reboot the system
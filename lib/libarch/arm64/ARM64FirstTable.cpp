@@ -18,7 +18,6 @@
 
 #include <FreeNOS/System.h>
 #include <SplitAllocator.h>
-#include <MemoryBlock.h>
 #include "ARM64Constant.h"
 #include "ARM64FirstTable.h"
 
@@ -59,6 +58,11 @@ u64 ARM64FirstTable::get_l2_entry(Address virt, SplitAllocator *alloc, u64 **tbl
  *
  * @return Index of the corresponding page directory entry.
  */
+bool ARM64FirstTable::hasSecondTable(Address virt, SplitAllocator *alloc) const
+{
+    return getSecondTable(virt, alloc) != ZERO;
+}
+
 ARM64SecondTable * ARM64FirstTable::getSecondTable(Address virt, SplitAllocator *alloc) const
 {
 
@@ -74,43 +78,91 @@ ARM64SecondTable * ARM64FirstTable::getSecondTable(Address virt, SplitAllocator
         return (ARM64SecondTable *) alloc->toVirtual(entry_l2 & PAGEMASK);
 }
 
+MemoryContext::Result ARM64FirstTable::getOrAllocateSecondTable(Address virt,
+                                                                SplitAllocator *alloc,
+                                                                ARM64SecondTable **table)
+{
+    Allocator::Range allocPhys, allocVirt;
+    u64 *tbl_l2;
+    unsigned int l2_idx;
+
+    // Check if the page table is present.
+    if ((*table = getSecondTable(virt, alloc)) != ZERO)
+        return MemoryContext::Success;
+
+    u64 entry_l2 = get_l2_entry(virt, alloc, &tbl_l2, &l2_idx);
+
+    // Reject if already mapped as a (super)section
+    if (IS_PT_BLOCK(entry_l2))
+        return MemoryContext::AlreadyExists;
+
+    // Allocate a new page table
+    allocPhys.address = 0;
+    allocPhys.size = sizeof(ARM64SecondTable);
+    allocPhys.alignment = PAGESIZE;
+
+    if (alloc->allocateZeroed(allocPhys, allocVirt) != Allocator::Success)
+        return MemoryContext::OutOfMemory;
+
+    // Assign to the page directory. Do not assign permission flags (only for direct sections).
+    tbl_l2[l2_idx] = allocPhys.address | PT_PAGE;
+    *table = getSecondTable(virt, alloc);
+    return MemoryContext::Success;
+}
+
 MemoryContext::Result ARM64FirstTable::map(Address virt,
                                          Address phys,
                                          Memory::Access access,
                                          SplitAllocator *alloc)
 {
-    ARM64SecondTable *table = getSecondTable(virt, alloc);
-    Arch::Cache cache;
-    Allocator::Range allocPhys, allocVirt;
+    ARM64SecondTable *table;
+    const MemoryContext::Result r = getOrAllocateSecondTable(virt, alloc, &table);
 
-    // Check if the page table is present.
-    if (!table)
-    {
-        u64 *tbl_l2;
-        unsigned int l2_idx;
+    if (r != MemoryContext::Success)
+        return r;
 
-        u64 entry_l2 = get_l2_entry(virt, alloc, &tbl_l2, &l2_idx);
+    return table->map(virt, phys, access);
+}
 
-        // Reject if already mapped as a (super)section
-        if (IS_PT_BLOCK(entry_l2))
-            return MemoryContext::AlreadyExists;
+MemoryContext::Result ARM64FirstTable::reserve(Address virt,
+                                             Memory::Access access,
+                                             SplitAllocator *alloc)
+{
+    ARM64SecondTable *table;
+    const MemoryContext::Result r = getOrAllocateSecondTable(virt, alloc, &table);
 
-        // Allocate a new page table
-        allocPhys.address = 0;
-        allocPhys.size = sizeof(ARM64SecondTable);
-        allocPhys.alignment = PAGESIZE;
+    if (r != MemoryContext::Success)
+        return r;
 
-        if (alloc->allocate(allocPhys, allocVirt) != Allocator::Success)
-            return MemoryContext::OutOfMemory;
+    return table->reserve(virt, access);
+}
 
-        MemoryBlock::set((void *)allocVirt.address, 0, PAGESIZE);
+bool ARM64FirstTable::isReserved(Address virt,
+                               Memory::Access *access,
+                               SplitAllocator *alloc) const
+{
+    ARM64SecondTable *table = getSecondTable(virt, alloc);
 
-        // Assign to the page directory. Do not assign permission flags (only for direct sections).
-        tbl_l2[l2_idx] = allocPhys.address | PT_PAGE;
-        //cache.cleanData(&m_tables[DIRENTRY(virt)]);
-        table = getSecondTable(virt, alloc);
-    }
-    return table->map(virt, phys, access);
+    return table != ZERO && table->isReserved(virt, access);
+}
+
+MemoryContext::Result ARM64FirstTable::markCopyOnWrite(Address virt,
+                                                       SplitAllocator *alloc)
+{
+    ARM64SecondTable *table = getSecondTable(virt, alloc);
+
+    if (!table)
+        return MemoryContext::InvalidAddress;
+    else
+        return table->markCopyOnWrite(virt);
+}
+
+bool ARM64FirstTable::isCopyOnWrite(Address virt,
+                                    SplitAllocator *alloc) const
+{
+    ARM64SecondTable *table = getSecondTable(virt, alloc);
+
+    return table != ZERO && table->isCopyOnWrite(virt);
 }
 
 MemoryContext::Result ARM64FirstTable::mapLarge(Memory::Range range,
@@ -129,7 +181,7 @@ MemoryContext::Result ARM64FirstTable::mapLarge(Memory::Range range,
 
         u64 entry_l2 = get_l2_entry(range.virt + i, alloc, &tbl_l2, &l2_idx);
 
-        if (IS_PT_BLOCK(entry_l2))
+        if (IS_PT_BLOCK(entry_l2) || IS_PT_PAGE_TBL(entry_l2))
             return MemoryContext::AlreadyExists;
 
         u64 val  = (range.phys + i) | PT_BLOCK | flags(range.access);
@@ -175,7 +227,7 @@ MemoryContext::Result ARM64FirstTable::translate(Address virt,
         {
             const Address offsetInSection = virt % L2_BLOCK_SIZE;
 
-            *phys = (entry_l2 & L2_BLOCK_RANGE) +
+            *phys = (entry_l2 & L2_BLOCK_MASK) +
                     ((offsetInSection / PAGESIZE) * PAGESIZE);
             return MemoryContext::Success;
         }
@@ -191,18 +243,55 @@ MemoryContext::Result ARM64FirstTable::access(Address virt,
 {
     ARM64SecondTable *table = getSecondTable(virt, alloc);
     if (!table)
-        return MemoryContext::InvalidAddress;
+    {
+        u64 *tbl_l2;
+        unsigned int l2_idx;
+
+        u64 entry_l2 = get_l2_entry(virt, alloc, &tbl_l2, &l2_idx);
+        if (!IS_PT_BLOCK(entry_l2))
+            return MemoryContext::InvalidAddress;
+
+        // Permissions
+        *access = Memory::Readable;
+
+        if (!(contain_flags(entry_l2, PT_NX)))
+            *access |= Memory::Executable;
+
+        if (contain_flags(entry_l2, PT_USER))
+            *access |= Memory::User;
+
+        if (!(contain_flags(entry_l2, PT_RO)))
+            *access |= Memory::Writable;
+
+        // Caching
+        if (contain_flags(entry_l2, (PT_OSH | PT_DEV)))
+            *access |= Memory::Device;
+        else if (contain_flags(entry_l2, PT_OSH | PT_NC))
+            *access |= Memory::Uncached;
+        else
+            *access |= Memory::InnerCached;
+
+        return MemoryContext::Success;
+    }
     else
         return table->access(virt, access);
 }
 
+bool ARM64FirstTable::isLarge(Address virt) const
+{
+    u64 *tbl_l2;
+    unsigned int l2_idx;
+
+    return IS_PT_BLOCK(get_l2_entry(virt, ZERO, &tbl_l2, &l2_idx));
+}
+
 u32 ARM64FirstTable::flags(Memory::Access access) const
 {
     u64 f = PT_KERNEL | PT_AF;
 
     // Permissions
     if (!(access & Memory::Executable)) f |= PT_NX;
-    if ((access & Memory::User))        f |= PT_USER;
+    if ((access & Memory::User))        f |= PT_USER | PT_NG;
     if (!(access & Memory::Writable))   f |= PT_RO;
 
     // Cache
@@ -244,12 +333,34 @@ MemoryContext::Result ARM64FirstTable::releaseRange(const Memory::Range range,
         ARM64SecondTable *table = getSecondTable(addr, alloc);
         if (table == ZERO)
         {
+            // Release a block, which must be completely inside the range
+            if (isLarge(addr) && !(addr & L2_BLOCK_RANGE) &&
+                addr + L2_BLOCK_SIZE <= range.virt + range.size)
+            {
+                Address block;
+                translate(addr, &block, alloc);
+
+                for (Address i = 0; i < L2_BLOCK_SIZE; i += PAGESIZE)
+                {
+                    releasePhysical(alloc, block + i);
+                }
+                unmap(addr, alloc);
+                addr += L2_BLOCK_SIZE - PAGESIZE;
+                continue;
+            }
             return MemoryContext::InvalidAddress;
         }
 
         if (table->translate(addr, &phys) != MemoryContext::Success)
         {
-            return MemoryContext::InvalidAddress;
+            // Reserved pages which were never accessed have no physical page
+            Memory::Access acc;
+
+            if (!table->isReserved(addr, &acc))
+                return MemoryContext::InvalidAddress;
+
+            table->unmap(addr);
+            continue;
         }
 
         releasePhysical(alloc, phys);
@@ -277,9 +388,20 @@ MemoryContext::Result ARM64FirstTable::releaseSection(const Memory::Range range,
         ARM64SecondTable *table = getSecondTable(addr, alloc);
         if (!table)
         {
+            // Blocks have no page table, only release the mapped pages
+            if (isLarge(addr))
+            {
+                Address block;
+                translate(addr, &block, alloc);
+
+                for (Address i = 0; i < L2_BLOCK_SIZE && !tablesOnly; i += PAGESIZE)
+                {
+                    releasePhysical(alloc, block + i);
+                }
+                unmap(addr, alloc);
+            }
             continue;
         }
-        //else, what about large 2MB block?
 
         // Release mapped pages, if requested
         if (!tablesOnly)
@@ -60,6 +60,54 @@ class ARM64FirstTable
                               Memory::Access access,
                               SplitAllocator *alloc);
 
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * @param virt Virtual address.
+     * @param access Memory access flags to use when mapped.
+     * @param alloc Physical memory allocator for extra page tables.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result reserve(Address virt,
+                                  Memory::Access access,
+                                  SplitAllocator *alloc);
+
+    /**
+     * Check if a virtual address is reserved.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved Memory access flags.
+     * @param alloc Physical memory allocator
+     *
+     * @return True if reserved, false otherwise.
+     */
+    bool isReserved(Address virt,
+                    Memory::Access *access,
+                    SplitAllocator *alloc) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * @param virt Virtual address of the page.
+     * @param alloc Physical memory allocator
+     *
+     * @return Result code
+     */
+    MemoryContext::Result markCopyOnWrite(Address virt,
+                                          SplitAllocator *alloc);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     * @param alloc Physical memory allocator
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    bool isCopyOnWrite(Address virt,
+                       SplitAllocator *alloc) const;
+
     /**
      * Map a contigous range of virtual memory to physical memory.
      *
@@ -76,6 +124,8 @@ class ARM64FirstTable
     /**
      * Remove virtual address mapping.
      *
+     * If the address is mapped by a 2 megabyte block, the whole block is removed.
+     *
      * @param virt Virtual address.
      * @param alloc Physical memory allocator
      *
@@ -110,6 +160,25 @@ class ARM64FirstTable
                                  Memory::Access *access,
                                  SplitAllocator *alloc) const;
 
+    /**
+     * Check if a virtual address is mapped by a 2 megabyte block.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if mapped by a block, false otherwise.
+     */
+    bool isLarge(Address virt) const;
+
+    /**
+     * Check if a second level page table is present for a virtual address.
+     *
+     * @param virt Virtual address to check.
+     * @param alloc Physical memory allocator
+     *
+     * @return True if present, false otherwise.
+     */
+    bool hasSecondTable(Address virt, SplitAllocator *alloc) const;
+
     /**
      * Release memory sections.
      *
@@ -158,6 +227,19 @@ class ARM64FirstTable
     ARM64SecondTable * getSecondTable(Address virt,
                                     SplitAllocator *alloc) const;
 
+    /**
+     * Retrieve or allocate the second level page table
+     *
+     * @param virt Virtual address to fetch page table for
+     * @param alloc Physical memory allocator for extra page tables
+     * @param table On output contains the second level page table
+     *
+     * @return Result code
+     */
+    MemoryContext::Result getOrAllocateSecondTable(Address virt,
+                                                   SplitAllocator *alloc,
+                                                   ARM64SecondTable **table);
+
     /**
      * Convert Memory::Access to first level page table flags.
      *
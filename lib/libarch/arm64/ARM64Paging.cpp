@@ -187,15 +187,21 @@ MemoryContext::Result ARM64Paging::activate(bool initializeMMU)
         enableMMU();
     } else {
         //m_cache.cleanInvalidate(Cache::Unified);
-        
+
+        // Take an address space identifier on first use. Drop any
+        // TLB entries left behind by its previous owner.
+        if (!m_addressSpace && assignAddressSpace(MaxAddressSpaces))
+            tlb_invalidate_asid(m_addressSpace);
+
+        // The identifier is switched together with the table
         u64 tbl = m_firstTableAddr;
         tbl += 0x1UL;
+        tbl |= (u64) m_addressSpace << 48;
         ARM64Control::write(ARM64Control::TranslationTable0, tbl);
 
-        // Flush TLB caches
-        //tlb_flush_all();
-        //FIXME: check it again
-        asm volatile ("dsb ishst\ntlbi vmalle1is\n");
+        // Flush TLB caches, unless the entries are tagged by the identifier
+        if (!m_addressSpace)
+            asm volatile ("dsb ishst\ntlbi vmalle1is\n");
 
         // Synchronize execution stream
         dsb(ish);
@@ -213,21 +219,82 @@ MemoryContext::Result ARM64Paging::map(Address virt, Address phys, Memory::Acces
     Result r = m_firstTable->map(virt, phys, acc, m_alloc);
 
     // Flush the TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidate(virt);
+
+    // Synchronize execution stream.
+    isb();
+    return r;
+}
+
+Size ARM64Paging::largePageSize() const
+{
+    return L2_BLOCK_SIZE;
+}
+
+MemoryContext::Result ARM64Paging::mapLarge(Address virt, Address phys, Memory::Access acc)
+{
+    const Memory::Range range = { virt, phys, L2_BLOCK_SIZE, acc };
+
+    // Modify page tables
+    Result r = m_firstTable->mapLarge(range, m_alloc);
+
+    // Flush the TLB to refresh the mapping
+    invalidate(virt);
 
     // Synchronize execution stream.
     isb();
     return r;
 }
 
+MemoryContext::Result ARM64Paging::unmapLarge(Address virt)
+{
+    if (!m_firstTable->isLarge(virt))
+        return InvalidAddress;
+
+    return unmap(virt);
+}
+
+bool ARM64Paging::isLarge(Address virt) const
+{
+    return m_firstTable->isLarge(virt);
+}
+
+bool ARM64Paging::hasPageTable(Address virt) const
+{
+    return m_firstTable->hasSecondTable(virt, m_alloc);
+}
+
+MemoryContext::Result ARM64Paging::reserve(Address virt, Memory::Access acc)
+{
+    return m_firstTable->reserve(virt, acc, m_alloc);
+}
+
+bool ARM64Paging::isReserved(Address virt, Memory::Access *acc) const
+{
+    return m_firstTable->isReserved(virt, acc, m_alloc);
+}
+
+MemoryContext::Result ARM64Paging::markCopyOnWrite(Address virt)
+{
+    // Modify page tables
+    Result r = m_firstTable->markCopyOnWrite(virt, m_alloc);
+    // Flush the TLB to refresh the mapping
+    invalidate(virt);
+    isb();
+    return r;
+}
+
+bool ARM64Paging::isCopyOnWrite(Address virt) const
+{
+    return m_firstTable->isCopyOnWrite(virt, m_alloc);
+}
+
 MemoryContext::Result ARM64Paging::unmap(Address virt)
 {
     // Modify page tables
     Result r = m_firstTable->unmap(virt, m_alloc);
     // Flush the TLB to refresh the mapping
-    if (m_current == this)
-        tlb_invalidate(virt);
+    invalidate(virt);
     isb();
     return r;
 }
@@ -245,10 +312,40 @@ MemoryContext::Result ARM64Paging::access(Address virt, Memory::Access *access)
 MemoryContext::Result ARM64Paging::releaseSection(const Memory::Range & range,
                                                 const bool tablesOnly)
 {
-    return m_firstTable->releaseSection(range, m_alloc, tablesOnly);
+    const Result r = m_firstTable->releaseSection(range, m_alloc, tablesOnly);
+
+    // Sections are too large to flush per page. Drop all entries of the
+    // address space instead, such that no stale mapping survives.
+    if (m_addressSpace)
+        tlb_invalidate_asid(m_addressSpace);
+    else if (m_current == this)
+        asm volatile ("dsb ishst\ntlbi vmalle1is\n");
+
+    dsb(ish);
+    isb();
+    return r;
 }
 
 MemoryContext::Result ARM64Paging::releaseRange(Memory::Range *range)
 {
-    return m_firstTable->releaseRange(*range, m_alloc);
+    Result r = splitRange(*range);
+
+    if (r != Success)
+        return r;
+
+    r = m_firstTable->releaseRange(*range, m_alloc);
+
+    // Flush TLB entries of the released pages
+    for (Size i = 0; i < range->size; i += PAGESIZE)
+        invalidate(range->virt + i);
+
+    return r;
+}
+
+inline void ARM64Paging::invalidate(Address virt)
+{
+    if (m_current == this || m_addressSpace)
+    {
+        tlb_invalidate(virt, m_addressSpace);
+    }
 }
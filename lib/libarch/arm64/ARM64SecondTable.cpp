@@ -60,7 +60,7 @@ MemoryContext::Result ARM64SecondTable::translate(Address virt, Address *phys) c
 
 MemoryContext::Result ARM64SecondTable::access(Address virt, Memory::Access *access) const
 {
-    u32 entry = m_pages[L3_IDX(virt)];
+    u64 entry = m_pages[L3_IDX(virt)];
 
     if (!IS_PT_PAGE_TBL(entry))
         return MemoryContext::InvalidAddress;
@@ -68,6 +68,9 @@ MemoryContext::Result ARM64SecondTable::access(Address virt, Memory::Access *acc
     // Permissions
     *access = Memory::Readable;
 
+    if (!(contain_flags(entry, PT_NX)))
+        *access |= Memory::Executable;
+
     if (contain_flags(entry, PT_USER))
         *access |= Memory::User;
 
@@ -85,13 +88,53 @@ MemoryContext::Result ARM64SecondTable::access(Address virt, Memory::Access *acc
     return MemoryContext::Success;
 }
 
+MemoryContext::Result ARM64SecondTable::reserve(Address virt, Memory::Access access)
+{
+    u32 idx = L3_IDX(virt);
+
+    if (IS_PT_PAGE_TBL(m_pages[idx]))
+        return MemoryContext::AlreadyExists;
+
+    m_pages[idx] = PT_RESERVED | ((u64) access << PT_RESERVED_SHIFT);
+    return MemoryContext::Success;
+}
+
+bool ARM64SecondTable::isReserved(Address virt, Memory::Access *access) const
+{
+    const u64 entry = m_pages[L3_IDX(virt)];
+
+    if (GET_PT_TYPE(entry) != PT_NONE || !(entry & PT_RESERVED))
+        return false;
+
+    *access = (Memory::Access) (entry >> PT_RESERVED_SHIFT);
+    return true;
+}
+
+MemoryContext::Result ARM64SecondTable::markCopyOnWrite(Address virt)
+{
+    u32 idx = L3_IDX(virt);
+
+    if (!IS_PT_PAGE_TBL(m_pages[idx]))
+        return MemoryContext::InvalidAddress;
+
+    m_pages[idx] |= PT_RO | PT_COPY;
+    return MemoryContext::Success;
+}
+
+bool ARM64SecondTable::isCopyOnWrite(Address virt) const
+{
+    const u64 entry = m_pages[L3_IDX(virt)];
+
+    return IS_PT_PAGE_TBL(entry) && contain_flags(entry, PT_COPY);
+}
+
 u32 ARM64SecondTable::flags(Memory::Access access) const
 {
     u64 f = PT_KERNEL | PT_AF;
 
     // Permissions
     if (!(access & Memory::Executable)) f |= PT_NX;
-    if ((access & Memory::User))        f |= PT_USER;
+    if ((access & Memory::User))        f |= PT_USER | PT_NG;
     if (!(access & Memory::Writable))   f |= PT_RO;
 
     // Cache
@@ -157,6 +157,11 @@ static API::Result hostVMCtlHandler(ProcessID procID,
             return API::Success;
         }
 
+        case MapShared:
+        {
+            return range->virt != ZERO ? API::Success : API::InvalidArgument;
+        }
+
         case Release:
         {
             if (range->virt != 0 && range->size != 0)
@@ -37,6 +37,9 @@
 /** Protected Mode. */
 #define CR0_PE          0x00000001
 
+/** Write Protect: supervisor writes honour read-only pages. */
+#define CR0_WP          0x00010000
+
 /** Paged Mode. */
 #define CR0_PG          0x80000000
 
@@ -44,6 +47,9 @@
 #define CR4_TSD         0x00000004
 #define CR4_PSE         (1 << 4)
 
+/** Page Global Enable: global pages are kept in the TLB when CR3 is loaded. */
+#define CR4_PGE         (1 << 7)
+
 /** Kernel Code Segment. */
 #define KERNEL_CS       1
 #define KERNEL_CS_SEL   0x8
@@ -93,7 +93,7 @@ inline u64 timestamp()
     asm volatile("invlpg (%0)" ::"r" (addr) : "memory")
 
 /**
- * Flushes all Translation Lookaside Buffers (TLB).
+ * Flushes all Translation Lookaside Buffers (TLB), except global pages.
  */
 #define tlb_flush_all() \
     asm volatile("mov %cr3, %eax\n" \
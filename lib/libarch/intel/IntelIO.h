@@ -88,6 +88,21 @@ class IntelIO : public IO
         return w;
     }
 
+    /**
+     * Read a long from a port.
+     *
+     * @param port The I/O port to read from.
+     *
+     * @return Long 32-bit number read from the port.
+     */
+    inline u32 inl(u16 port) const
+    {
+        u32 l;
+        port += m_portBase;
+        asm volatile ("inl %%dx, %%eax" : "=a" (l) : "d" (port));
+        return l;
+    }
+
     /**
      * Output a byte to a port.
      *
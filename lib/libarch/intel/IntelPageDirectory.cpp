@@ -16,7 +16,6 @@
  */
 
 #include <SplitAllocator.h>
-#include <MemoryBlock.h>
 #include "IntelConstant.h"
 #include "IntelPageDirectory.h"
 
@@ -38,12 +37,17 @@
 #define DIRENTRY(vaddr) \
     ((vaddr) >> DIRSHIFT)
 
+bool IntelPageDirectory::hasPageTable(Address virt, SplitAllocator *alloc) const
+{
+    return getPageTable(virt, alloc) != ZERO;
+}
+
 IntelPageTable * IntelPageDirectory::getPageTable(Address virt, SplitAllocator *alloc) const
 {
     u32 entry = m_tables[ DIRENTRY(virt) ];
 
     // Check if the page table is present.
-    if (!(entry & PAGE_PRESENT))
+    if (!(entry & PAGE_PRESENT) || (entry & PAGE_SECTION))
         return ZERO;
     else
         return (IntelPageTable *) alloc->toVirtual(entry & PAGEMASK);
@@ -61,39 +65,121 @@ MemoryContext::Result IntelPageDirectory::copy(IntelPageDirectory *directory,
     return MemoryContext::Success;
 }
 
+MemoryContext::Result IntelPageDirectory::getOrAllocatePageTable(Address virt,
+                                                                  Memory::Access access,
+                                                                  SplitAllocator *alloc,
+                                                                  IntelPageTable **table)
+{
+    Allocator::Range allocPhys, allocVirt;
+
+    // Check if the page table is present.
+    if ((*table = getPageTable(virt, alloc)) != ZERO)
+        return MemoryContext::Success;
+
+    // Reject if already mapped as a section
+    if (m_tables[ DIRENTRY(virt) ] & PAGE_SECTION)
+        return MemoryContext::AlreadyExists;
+
+    allocPhys.address = 0;
+    allocPhys.size = sizeof(IntelPageTable);
+    allocPhys.alignment = PAGESIZE;
+
+    // Allocate a new page table
+    if (alloc->allocateZeroed(allocPhys, allocVirt) != Allocator::Success)
+        return MemoryContext::OutOfMemory;
+
+    // Assign to the page directory
+    m_tables[ DIRENTRY(virt) ] = allocPhys.address | PAGE_PRESENT | PAGE_WRITE | flags(access);
+    *table = getPageTable(virt, alloc);
+    return MemoryContext::Success;
+}
+
 MemoryContext::Result IntelPageDirectory::map(Address virt,
                                               Address phys,
                                               Memory::Access access,
                                               SplitAllocator *alloc)
+{
+    IntelPageTable *table;
+    const MemoryContext::Result r = getOrAllocatePageTable(virt, access, alloc, &table);
+
+    if (r != MemoryContext::Success)
+        return r;
+
+    return table->map(virt, phys, access);
+}
+
+MemoryContext::Result IntelPageDirectory::reserve(Address virt,
+                                                  Memory::Access access,
+                                                  SplitAllocator *alloc)
+{
+    IntelPageTable *table;
+    const MemoryContext::Result r = getOrAllocatePageTable(virt, access, alloc, &table);
+
+    if (r != MemoryContext::Success)
+        return r;
+
+    return table->reserve(virt, access);
+}
+
+bool IntelPageDirectory::isReserved(Address virt,
+                                    Memory::Access *access,
+                                    SplitAllocator *alloc) const
+{
+    IntelPageTable *table = getPageTable(virt, alloc);
+
+    return table != ZERO && table->isReserved(virt, access);
+}
+
+MemoryContext::Result IntelPageDirectory::markCopyOnWrite(Address virt,
+                                                          SplitAllocator *alloc)
 {
     IntelPageTable *table = getPageTable(virt, alloc);
-    Allocator::Range allocPhys, allocVirt;
 
-    // Check if the page table is present.
     if (!table)
-    {
-        allocPhys.address = 0;
-        allocPhys.size = sizeof(IntelPageTable);
-        allocPhys.alignment = PAGESIZE;
+        return MemoryContext::InvalidAddress;
+    else
+        return table->markCopyOnWrite(virt);
+}
+
+bool IntelPageDirectory::isCopyOnWrite(Address virt,
+                                       SplitAllocator *alloc) const
+{
+    IntelPageTable *table = getPageTable(virt, alloc);
 
-        // Allocate a new page table
-        if (alloc->allocate(allocPhys, allocVirt) != Allocator::Success)
-            return MemoryContext::OutOfMemory;
+    return table != ZERO && table->isCopyOnWrite(virt);
+}
+
+MemoryContext::Result IntelPageDirectory::mapLarge(Memory::Range range,
+                                                   SplitAllocator *alloc)
+{
+    if (range.size & ~SECTIONMASK)
+        return MemoryContext::InvalidSize;
+
+    if ((range.phys & ~SECTIONMASK) || (range.virt & ~SECTIONMASK))
+        return MemoryContext::InvalidAddress;
 
-        MemoryBlock::set((void *)allocVirt.address, 0, sizeof(IntelPageTable));
+    for (Size i = 0; i < range.size; i += MegaByte(4))
+    {
+        if (m_tables[ DIRENTRY(range.virt + i) ] & PAGE_PRESENT)
+            return MemoryContext::AlreadyExists;
 
-        // Assign to the page directory
-        m_tables[ DIRENTRY(virt) ] = allocPhys.address | PAGE_PRESENT | PAGE_WRITE | flags(access);
-        table = getPageTable(virt, alloc);
+        m_tables[ DIRENTRY(range.virt + i) ] = (range.phys + i) | PAGE_PRESENT | PAGE_SECTION | flags(range.access);
     }
-    return table->map(virt, phys, access);
+    return MemoryContext::Success;
 }
 
 MemoryContext::Result IntelPageDirectory::unmap(Address virt, SplitAllocator *alloc)
 {
     IntelPageTable *table = getPageTable(virt, alloc);
     if (!table)
+    {
+        if (isLarge(virt))
+        {
+            m_tables[ DIRENTRY(virt) ] = PAGE_NONE;
+            return MemoryContext::Success;
+        }
         return MemoryContext::InvalidAddress;
+    }
     else
         return table->unmap(virt);
 }
@@ -125,11 +211,30 @@ MemoryContext::Result IntelPageDirectory::access(Address virt,
 {
     IntelPageTable *table = getPageTable(virt, alloc);
     if (!table)
-        return MemoryContext::InvalidAddress;
+    {
+        const u32 entry = m_tables[ DIRENTRY(virt) ];
+
+        if (!isLarge(virt))
+            return MemoryContext::InvalidAddress;
+
+        *access = Memory::Readable;
+
+        if (entry & PAGE_WRITE) *access |= Memory::Writable;
+        if (entry & PAGE_USER)  *access |= Memory::User;
+
+        return MemoryContext::Success;
+    }
     else
         return table->access(virt, access);
 }
 
+bool IntelPageDirectory::isLarge(Address virt) const
+{
+    const u32 entry = m_tables[ DIRENTRY(virt) ];
+
+    return (entry & PAGE_PRESENT) && (entry & PAGE_SECTION);
+}
+
 u32 IntelPageDirectory::flags(Memory::Access access) const
 {
     u32 f = 0;
@@ -171,12 +276,33 @@ MemoryContext::Result IntelPageDirectory::releaseRange(const Memory::Range range
         IntelPageTable *table = getPageTable(addr, alloc);
         if (table == ZERO)
         {
+            // Release a section, which must be completely inside the range
+            if (isLarge(addr) && !(addr & ~SECTIONMASK) &&
+                addr + MegaByte(4) <= range.virt + range.size)
+            {
+                const Address section = m_tables[ DIRENTRY(addr) ] & SECTIONMASK;
+
+                for (Size i = 0; i < MegaByte(4); i += PAGESIZE)
+                {
+                    releasePhysical(alloc, section + i);
+                }
+                m_tables[ DIRENTRY(addr) ] = PAGE_NONE;
+                addr += MegaByte(4) - PAGESIZE;
+                continue;
+            }
             return MemoryContext::InvalidAddress;
         }
 
         if (table->translate(addr, &phys) != MemoryContext::Success)
         {
-            return MemoryContext::InvalidAddress;
+            // Reserved pages which were never accessed have no physical page
+            Memory::Access acc;
+
+            if (!table->isReserved(addr, &acc))
+                return MemoryContext::InvalidAddress;
+
+            table->unmap(addr);
+            continue;
         }
 
         releasePhysical(alloc, phys);
@@ -204,6 +330,17 @@ MemoryContext::Result IntelPageDirectory::releaseSection(const Memory::Range ran
         IntelPageTable *table = getPageTable(addr, alloc);
         if (!table)
         {
+            // Sections have no page table, only release the mapped pages
+            if (isLarge(addr))
+            {
+                const Address section = m_tables[ DIRENTRY(addr) ] & SECTIONMASK;
+
+                for (Size i = 0; i < MegaByte(4) && !tablesOnly; i += PAGESIZE)
+                {
+                    releasePhysical(alloc, section + i);
+                }
+                m_tables[ DIRENTRY(addr) ] = PAGE_NONE;
+            }
             continue;
         }
 
@@ -71,9 +71,72 @@ class IntelPageDirectory
                               Memory::Access access,
                               SplitAllocator *alloc);
 
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * @param virt Virtual address.
+     * @param access Memory access flags to use when mapped.
+     * @param alloc Physical memory allocator for extra page tables.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result reserve(Address virt,
+                                  Memory::Access access,
+                                  SplitAllocator *alloc);
+
+    /**
+     * Check if a virtual address is reserved.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved Memory access flags.
+     * @param alloc Memory allocator used by the caller
+     *
+     * @return True if reserved, false otherwise.
+     */
+    bool isReserved(Address virt,
+                    Memory::Access *access,
+                    SplitAllocator *alloc) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * @param virt Virtual address of the page.
+     * @param alloc Physical memory allocator
+     *
+     * @return Result code
+     */
+    MemoryContext::Result markCopyOnWrite(Address virt,
+                                          SplitAllocator *alloc);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     * @param alloc Physical memory allocator
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    bool isCopyOnWrite(Address virt,
+                       SplitAllocator *alloc) const;
+
+    /**
+     * Map a contigous range of virtual memory to physical memory.
+     *
+     * This function can map at the granularity of 4 megabyte memory chunks.
+     *
+     * @param range Virtual to physical memory range.
+     * @param alloc Memory allocator used by the caller
+     *
+     * @return Result code
+     */
+    MemoryContext::Result mapLarge(Memory::Range range,
+                                   SplitAllocator *alloc);
+
     /**
      * Remove virtual address mapping.
      *
+     * If the address is mapped by a 4 megabyte section, the whole section is removed.
+     *
      * @param virt Virtual address.
      * @param alloc Memory allocator used by the caller
      *
@@ -108,6 +171,25 @@ class IntelPageDirectory
                                  Memory::Access *access,
                                  SplitAllocator *alloc) const;
 
+    /**
+     * Check if a virtual address is mapped by a 4 megabyte section.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if mapped by a section, false otherwise.
+     */
+    bool isLarge(Address virt) const;
+
+    /**
+     * Check if a page table is present for a virtual address.
+     *
+     * @param virt Virtual address to check.
+     * @param alloc Physical memory allocator
+     *
+     * @return True if present, false otherwise.
+     */
+    bool hasPageTable(Address virt, SplitAllocator *alloc) const;
+
     /**
      * Release memory sections.
      *
@@ -153,6 +235,21 @@ class IntelPageDirectory
      */
     IntelPageTable * getPageTable(Address virt, SplitAllocator *alloc) const;
 
+    /**
+     * Retrieve or allocate the second level page table
+     *
+     * @param virt Input virtual address to find second level page table for
+     * @param access Memory access flags for a new page directory entry
+     * @param alloc Physical memory allocator for extra page tables
+     * @param table On output contains the second level page table
+     *
+     * @return Result code
+     */
+    MemoryContext::Result getOrAllocatePageTable(Address virt,
+                                                 Memory::Access access,
+                                                 SplitAllocator *alloc,
+                                                 IntelPageTable **table);
+
     /**
      * Convert Memory::Access to page directory flags.
      *
@@ -25,6 +25,15 @@
 #define PAGE_WRITE      2
 #define PAGE_USER       4
 
+/** Software flag for non-present entries which are reserved for demand-zero mapping */
+#define PAGE_RESERVED   (1 << 9)
+
+/** Reserved entries store the Memory::Access flags in the page frame bits */
+#define RESERVED_SHIFT  12
+
+/** Software flag for present entries which are mapped read-only until copied on write */
+#define PAGE_COPY       (1 << 10)
+
 /**
  * Entry inside the page table of a given virtual address.
  *
@@ -78,6 +87,42 @@ MemoryContext::Result IntelPageTable::access(Address virt, Memory::Access *acces
     return MemoryContext::Success;
 }
 
+MemoryContext::Result IntelPageTable::reserve(Address virt, Memory::Access access)
+{
+    if (m_pages[ TABENTRY(virt) ] & PAGE_PRESENT)
+        return MemoryContext::AlreadyExists;
+
+    m_pages[ TABENTRY(virt) ] = PAGE_RESERVED | (access << RESERVED_SHIFT);
+    return MemoryContext::Success;
+}
+
+bool IntelPageTable::isReserved(Address virt, Memory::Access *access) const
+{
+    const u32 entry = m_pages[ TABENTRY(virt) ];
+
+    if ((entry & PAGE_PRESENT) || !(entry & PAGE_RESERVED))
+        return false;
+
+    *access = (Memory::Access) (entry >> RESERVED_SHIFT);
+    return true;
+}
+
+MemoryContext::Result IntelPageTable::markCopyOnWrite(Address virt)
+{
+    if (!(m_pages[ TABENTRY(virt) ] & PAGE_PRESENT))
+        return MemoryContext::InvalidAddress;
+
+    m_pages[ TABENTRY(virt) ] = (m_pages[ TABENTRY(virt) ] & ~PAGE_WRITE) | PAGE_COPY;
+    return MemoryContext::Success;
+}
+
+bool IntelPageTable::isCopyOnWrite(Address virt) const
+{
+    const u32 entry = m_pages[ TABENTRY(virt) ];
+
+    return (entry & PAGE_PRESENT) && (entry & PAGE_COPY);
+}
+
 u32 IntelPageTable::flags(Memory::Access access) const
 {
     u32 f = 0;
@@ -82,6 +82,50 @@ class IntelPageTable
      */
     MemoryContext::Result access(Address virt, Memory::Access *access) const;
 
+    /**
+     * Reserve a virtual address for demand-zero mapping.
+     *
+     * The entry stays non-present until the first access, which
+     * is resolved by the page fault handler.
+     *
+     * @param virt Virtual address.
+     * @param access Memory access flags to use when mapped.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result reserve(Address virt, Memory::Access access);
+
+    /**
+     * Check if a virtual address is reserved.
+     *
+     * @param virt Virtual address to check.
+     * @param access On output contains the reserved Memory access flags.
+     *
+     * @return True if reserved, false otherwise.
+     */
+    bool isReserved(Address virt, Memory::Access *access) const;
+
+    /**
+     * Mark a mapped page as copy-on-write.
+     *
+     * The page becomes read-only until the first write,
+     * which is resolved by the page fault handler.
+     *
+     * @param virt Virtual address of the page.
+     *
+     * @return Result code
+     */
+    MemoryContext::Result markCopyOnWrite(Address virt);
+
+    /**
+     * Check if a virtual address is mapped copy-on-write.
+     *
+     * @param virt Virtual address to check.
+     *
+     * @return True if copy-on-write, false otherwise.
+     */
+    bool isCopyOnWrite(Address virt) const;
+
   private:
 
     /**
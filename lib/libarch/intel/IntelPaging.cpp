@@ -17,6 +17,7 @@
 
 #include <SplitAllocator.h>
 #include <MemoryBlock.h>
+#include "IntelConstant.h"
 #include "IntelCore.h"
 #include "IntelPaging.h"
 
@@ -111,6 +112,73 @@ MemoryContext::Result IntelPaging::map(Address virt, Address phys, Memory::Acces
     return r;
 }
 
+Size IntelPaging::largePageSize() const
+{
+    return MegaByte(4);
+}
+
+MemoryContext::Result IntelPaging::mapLarge(Address virt, Address phys, Memory::Access acc)
+{
+    const Memory::Range range = { virt, phys, MegaByte(4), acc };
+    MemoryContext::Result r = m_pageDirectory->mapLarge(range, m_alloc);
+
+    // Flush TLB entry
+    if (r == Success && m_current == this)
+        tlb_flush(virt);
+
+    return r;
+}
+
+MemoryContext::Result IntelPaging::unmapLarge(Address virt)
+{
+    if (!m_pageDirectory->isLarge(virt))
+        return InvalidAddress;
+
+    MemoryContext::Result r = m_pageDirectory->unmap(virt, m_alloc);
+
+    // Flush TLB entry
+    if (r == Success && m_current == this)
+        tlb_flush(virt);
+
+    return r;
+}
+
+bool IntelPaging::isLarge(Address virt) const
+{
+    return m_pageDirectory->isLarge(virt);
+}
+
+bool IntelPaging::hasPageTable(Address virt) const
+{
+    return m_pageDirectory->hasPageTable(virt, m_alloc);
+}
+
+MemoryContext::Result IntelPaging::reserve(Address virt, Memory::Access acc)
+{
+    return m_pageDirectory->reserve(virt, acc, m_alloc);
+}
+
+bool IntelPaging::isReserved(Address virt, Memory::Access *acc) const
+{
+    return m_pageDirectory->isReserved(virt, acc, m_alloc);
+}
+
+MemoryContext::Result IntelPaging::markCopyOnWrite(Address virt)
+{
+    MemoryContext::Result r = m_pageDirectory->markCopyOnWrite(virt, m_alloc);
+
+    // Flush TLB entry
+    if (r == Success && m_current == this)
+        tlb_flush(virt);
+
+    return r;
+}
+
+bool IntelPaging::isCopyOnWrite(Address virt) const
+{
+    return m_pageDirectory->isCopyOnWrite(virt, m_alloc);
+}
+
 MemoryContext::Result IntelPaging::unmap(Address virt)
 {
     MemoryContext::Result r = m_pageDirectory->unmap(virt, m_alloc);
@@ -140,5 +208,19 @@ MemoryContext::Result IntelPaging::releaseSection(const Memory::Range & range,
 
 MemoryContext::Result IntelPaging::releaseRange(Memory::Range *range)
 {
-    return m_pageDirectory->releaseRange(*range, m_alloc);
+    MemoryContext::Result r = splitRange(*range);
+
+    if (r != Success)
+        return r;
+
+    r = m_pageDirectory->releaseRange(*range, m_alloc);
+
+    // Flush TLB entries of the released pages
+    if (m_current == this)
+    {
+        for (Size i = 0; i < range->size; i += PAGESIZE)
+            tlb_flush(range->virt + i);
+    }
+
+    return r;
 }
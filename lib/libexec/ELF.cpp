@@ -86,7 +86,7 @@ ELF::Result ELF::regions32(ELF::Region *regions, Size *count) const
         regions[numRegions].dataOffset = segments[numSegments].offset;
         regions[numRegions].dataSize   = segments[numSegments].fileSize;
         regions[numRegions].memorySize = segments[numSegments].memorySize;
-        regions[numRegions++].access   = Memory::User | Memory::Readable | Memory::Writable | Memory::Executable;
+        regions[numRegions++].access   = segmentAccess(segments[numSegments].flags);
     }
 
     // All done
@@ -121,7 +121,7 @@ ELF::Result ELF::regions64(ELF::Region *regions, Size *count) const
         regions[numRegions].dataOffset = segments[numSegments].offset;
         regions[numRegions].dataSize   = segments[numSegments].fileSize;
         regions[numRegions].memorySize = segments[numSegments].memorySize;
-        regions[numRegions++].access   = Memory::User | Memory::Readable | Memory::Writable | Memory::Executable;
+        regions[numRegions++].access   = segmentAccess(segments[numSegments].flags);
     }
 
     // All done
@@ -135,3 +135,17 @@ ELF::Result ELF::entry(Address *entry) const
     *entry = header->entry;
     return Success;
 }
+
+Memory::Access ELF::segmentAccess(const u32 flags)
+{
+    u32 access = Memory::User;
+
+    if (flags & ELF_SEGMENT_FLAG_READ)
+        access |= Memory::Readable;
+    if (flags & ELF_SEGMENT_FLAG_WRITE)
+        access |= Memory::Writable;
+    if (flags & ELF_SEGMENT_FLAG_EXEC)
+        access |= Memory::Executable;
+
+    return (Memory::Access) access;
+}
@@ -59,8 +59,6 @@ class ELF : public ExecutableFormat
      *              Actual number of memory regions on output.
      *
      * @return Result code.
-     *
-     * @todo Rework executables to avoid giving all mapped regions read, write and execute permissions.
      */
     virtual Result regions(Region *regions, Size *count) const;
     virtual Result regions32(Region *regions, Size *count) const;
@@ -85,6 +83,17 @@ class ELF : public ExecutableFormat
      * @return Result code
      */
     static Result detect(const u8 *image, const Size size, ExecutableFormat **fmt);
+
+  private:
+
+    /**
+     * Convert ELF segment flags to memory access permissions.
+     *
+     * @param flags ELF segment flags
+     *
+     * @return Memory access permissions for user mappings
+     */
+    static Memory::Access segmentAccess(const u32 flags);
 };
 
 /**
@@ -346,6 +346,24 @@ ELF64Header;
 /** Reserved for processor-specific semantics. */
 #define ELF_SEGMENT_HIPROC      0x7fffffff
 
+/**
+ * @}
+ */
+
+/**
+ * @name Segment flags
+ * @{
+ */
+
+/** Segment is executable. */
+#define ELF_SEGMENT_FLAG_EXEC   (1 << 0)
+
+/** Segment is writable. */
+#define ELF_SEGMENT_FLAG_WRITE  (1 << 1)
+
+/** Segment is readable. */
+#define ELF_SEGMENT_FLAG_READ   (1 << 2)
+
 /**
  * @}
  */
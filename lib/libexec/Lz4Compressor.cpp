@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ByteOrder.h>
+#include <MemoryBlock.h>
+#include "Lz4Compressor.h"
+
+Lz4Compressor::Lz4Compressor(const void *data, const Size size)
+    : m_inputData(static_cast<const u8 *>(data))
+    , m_inputSize(size)
+{
+}
+
+Size Lz4Compressor::getMaximumSize() const
+{
+    return m_inputSize + (m_inputSize / 255) + 16;
+}
+
+Lz4Compressor::Result Lz4Compressor::compressBlock(void *buffer,
+                                                   Size & size) const
+{
+    const Size hashSize = 1 << HashBits;
+    u8 *output = static_cast<u8 *>(buffer);
+    Size anchor = 0, position = 0;
+
+    if (size < getMaximumSize())
+    {
+        return InvalidArgument;
+    }
+
+    // The table contains the last position plus one for each hash value
+    u32 *table = new u32[hashSize];
+    MemoryBlock::set(table, 0, sizeof(u32) * hashSize);
+
+    // Search matches until the start of the last bytes
+    while (m_inputSize >= MatchLimit && position <= m_inputSize - MatchLimit)
+    {
+        const u32 sequence = readLe32(m_inputData + position);
+        const u32 hash = (sequence * 2654435761U) >> (32 - HashBits);
+        const Size candidate = table[hash];
+        table[hash] = position + 1;
+
+        if (candidate != 0 && position - (candidate - 1) <= MaximumOffset &&
+            readLe32(m_inputData + candidate - 1) == sequence)
+        {
+            const Size match = candidate - 1;
+            Size count = MinimumMatch;
+
+            // Extend the match, leaving the last bytes as literals
+            while (position + count < m_inputSize - LastLiterals &&
+                   m_inputData[match + count] == m_inputData[position + count])
+            {
+                count++;
+            }
+
+            output = writeSequence(output, m_inputData + anchor, position - anchor,
+                                   position - match, count);
+            position += count;
+            anchor = position;
+        }
+        else
+        {
+            position++;
+        }
+    }
+
+    // The block always ends with literals only
+    output = writeSequence(output, m_inputData + anchor, m_inputSize - anchor, 0, 0);
+    size = output - static_cast<u8 *>(buffer);
+
+    delete[] table;
+    return Success;
+}
+
+u8 * Lz4Compressor::writeSequence(u8 *output,
+                                  const u8 *literals,
+                                  const Size literalCount,
+                                  const Size matchOffset,
+                                  const Size matchCount) const
+{
+    u8 *token = output++;
+
+    // Literals count in the upper four bits of the token
+    if (literalCount >= 0xf)
+    {
+        *token = 0xf << 4;
+        output = integerEncode(output, literalCount - 0xf);
+    }
+    else
+    {
+        *token = literalCount << 4;
+    }
+
+    MemoryBlock::copy(output, literals, literalCount);
+    output += literalCount;
+
+    // The last sequence has no match
+    if (matchCount == 0)
+    {
+        return output;
+    }
+
+    writeLe16(output, matchOffset);
+    output += sizeof(u16);
+
+    // Match count minus the minimum in the lower four bits of the token
+    if (matchCount - MinimumMatch >= 0xf)
+    {
+        *token |= 0xf;
+        output = integerEncode(output, matchCount - MinimumMatch - 0xf);
+    }
+    else
+    {
+        *token |= matchCount - MinimumMatch;
+    }
+
+    return output;
+}
+
+u8 * Lz4Compressor::integerEncode(u8 *output, Size value) const
+{
+    while (value >= 0xff)
+    {
+        *output++ = 0xff;
+        value -= 0xff;
+    }
+
+    *output++ = value;
+    return output;
+}
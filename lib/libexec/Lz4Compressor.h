@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBEXEC_LZ4COMPRESSOR_H
+#define __LIB_LIBEXEC_LZ4COMPRESSOR_H
+
+#include <Types.h>
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libexec
+ * @{
+ */
+
+/**
+ * Compress data into a single LZ4 block.
+ *
+ * Produces the raw block format without a frame, which can be
+ * decompressed with Lz4Decompressor::readBlock(). The compressor uses
+ * a simple greedy search over a hash table of previous positions.
+ *
+ * @see http://www.lz4.org
+ * @see https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ */
+class Lz4Compressor
+{
+  private:
+
+    /** Minimum number of bytes in a match */
+    static const Size MinimumMatch = 4;
+
+    /** Last bytes in a block which are always literals */
+    static const Size LastLiterals = 5;
+
+    /** Last bytes in a block in which no match may start */
+    static const Size MatchLimit = 12;
+
+    /** Maximum distance of a match */
+    static const Size MaximumOffset = 65535;
+
+    /** Number of bits used for the hash table index */
+    static const Size HashBits = 12;
+
+  public:
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        InvalidArgument
+    };
+
+  public:
+
+    /**
+     * Constructor function.
+     *
+     * @param data Input data buffer
+     * @param size Size in bytes of the input buffer
+     */
+    Lz4Compressor(const void *data, const Size size);
+
+    /**
+     * Get the maximum size of the compressed data.
+     *
+     * @return Size in bytes of the worst case compressed output
+     */
+    Size getMaximumSize() const;
+
+    /**
+     * Compress the input data as a single block.
+     *
+     * @param buffer Output buffer of at least getMaximumSize() bytes.
+     * @param size Size of the output buffer on input.
+     *             On output, the number of compressed bytes.
+     *
+     * @return Result code
+     */
+    Result compressBlock(void *buffer, Size & size) const;
+
+  private:
+
+    /**
+     * Write a sequence of literals followed by a match.
+     *
+     * @param output Output buffer to write to
+     * @param literals Pointer to the literal bytes
+     * @param literalCount Number of literal bytes
+     * @param matchOffset Distance backwards to the match
+     * @param matchCount Number of matching bytes or zero for the last sequence
+     *
+     * @return Pointer to the output following the sequence
+     */
+    u8 * writeSequence(u8 *output,
+                       const u8 *literals,
+                       const Size literalCount,
+                       const Size matchOffset,
+                       const Size matchCount) const;
+
+    /**
+     * Encode an integer as a series of additional length bytes.
+     *
+     * @param output Output buffer to write to
+     * @param value Remaining value after subtracting the token value
+     *
+     * @return Pointer to the output following the encoded integer
+     */
+    u8 * integerEncode(u8 *output, Size value) const;
+
+  private:
+
+    /** Uncompressed input data */
+    const u8 *m_inputData;
+
+    /** Total size in bytes of the input data */
+    const Size m_inputSize;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBEXEC_LZ4COMPRESSOR_H */
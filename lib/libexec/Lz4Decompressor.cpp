@@ -138,6 +138,11 @@ Lz4Decompressor::Result Lz4Decompressor::read(void *buffer,
     while (copied < size && input < inputEnd)
     {
         // Fetch the next block
+        if ((Size) (inputEnd - input) < sizeof(u32))
+        {
+            ERROR("truncated block size at offset " << (Size) (input - m_inputData));
+            return IOError;
+        }
         const u32 blockSizeByte = readLe32(input);
         const u32 blockSize = blockSizeByte & ~(1 << 31);
         const bool isCompressed = blockSizeByte & (1 << 31) ? false : true;
@@ -148,17 +153,31 @@ Lz4Decompressor::Result Lz4Decompressor::read(void *buffer,
         {
             break;
         }
-        assert(blockSize <= m_blockMaximumSize);
         input += sizeof(u32);
 
+        if (blockSize > m_blockMaximumSize || blockSize > (Size) (inputEnd - input))
+        {
+            ERROR("invalid block size " << blockSize);
+            return IOError;
+        }
+
         // Decompress the block
         if (isCompressed)
         {
-            uncompSize = decompress(input, blockSize, output, size - copied);
+            const Result result = decompress(input, blockSize, output, size - copied, uncompSize);
+            if (result != Success)
+            {
+                return result;
+            }
         }
         // Return data as-is when the block is not compressed
         else
         {
+            if (blockSize > size - copied)
+            {
+                ERROR("uncompressed block of " << blockSize << " bytes overruns output");
+                return IOError;
+            }
             MemoryBlock::copy(output, input, blockSize);
             uncompSize = blockSize;
         }
@@ -176,19 +195,40 @@ Lz4Decompressor::Result Lz4Decompressor::read(void *buffer,
     return Success;
 }
 
-inline const u32 Lz4Decompressor::integerDecode(const u32 initial,
-                                                const u8 *next,
-                                                Size &byteCount) const
+Lz4Decompressor::Result Lz4Decompressor::readBlock(void *buffer,
+                                                   const Size size) const
 {
-    u32 value = initial;
+    Size uncompSize = 0;
+    const Result result = decompress(m_inputData, m_inputSize,
+                                     static_cast<u8 *>(buffer), size, uncompSize);
+    if (result != Success)
+    {
+        return result;
+    }
+
+    return uncompSize == size ? Success : IOError;
+}
+
+inline Lz4Decompressor::Result Lz4Decompressor::integerDecode(const u32 initial,
+                                                              const u8 *next,
+                                                              const u8 *end,
+                                                              u32 &value,
+                                                              Size &byteCount) const
+{
+    value = initial;
 
     if (initial < 0xf)
     {
-        return initial;
+        return Success;
     }
 
     for (byteCount = 1; ; byteCount++)
     {
+        if (next >= end)
+        {
+            return IOError;
+        }
+
         const u8 byte = *next++;
         value += byte;
 
@@ -198,13 +238,14 @@ inline const u32 Lz4Decompressor::integerDecode(const u32 initial,
         }
     }
 
-    return value;
+    return Success;
 }
 
-const u32 Lz4Decompressor::decompress(const u8 *input,
-                                      const Size inputSize,
-                                      u8 *output,
-                                      const Size outputSize) const
+Lz4Decompressor::Result Lz4Decompressor::decompress(const u8 *input,
+                                                    const Size inputSize,
+                                                    u8 *output,
+                                                    const Size outputSize,
+                                                    Size &outputCount) const
 {
     const u8 *inputEnd = input + inputSize;
     Size outputOffset = 0;
@@ -212,19 +253,30 @@ const u32 Lz4Decompressor::decompress(const u8 *input,
     // Decompress the whole block
     while (input < inputEnd && outputOffset < outputSize)
     {
-        u32 literalBytes = 0;
-        u32 matchBytes = 0;
+        Size literalBytes = 0;
+        Size matchBytes = 0;
+        u32 literalsCount, matchCount;
 
         // Read the token
         const u8 token = *input;
         input++;
 
         // Read literals count
-        const u32 literalsCount = integerDecode(token >> 4, input, literalBytes);
+        if (integerDecode(token >> 4, input, inputEnd, literalsCount, literalBytes) != Success)
+        {
+            ERROR("truncated literals count");
+            return IOError;
+        }
         input += literalBytes;
         DEBUG("token = " << token << " literalsCount = " << literalsCount << " literalBytes = " << literalBytes);
 
         // Copy literals
+        if (literalsCount > (Size) (inputEnd - input) ||
+            literalsCount > outputSize - outputOffset)
+        {
+            ERROR("literals overrun: count = " << literalsCount << " offset = " << outputOffset);
+            return IOError;
+        }
         if (literalsCount > 0)
         {
             MemoryBlock::copy(output + outputOffset, input, literalsCount);
@@ -239,14 +291,35 @@ const u32 Lz4Decompressor::decompress(const u8 *input,
         }
 
         // Read match offset
+        if ((Size) (inputEnd - input) < sizeof(u16))
+        {
+            ERROR("truncated match offset");
+            return IOError;
+        }
         const u16 off = readLe16(input);
-        assert(off <= outputOffset);
-        const u32 matchOffset = outputOffset - off;
         input += sizeof(u16);
 
+        if (off == 0 || off > outputOffset)
+        {
+            ERROR("invalid match offset " << off << " at output offset " << outputOffset);
+            return IOError;
+        }
+        const Size matchOffset = outputOffset - off;
+
         // Read match length
-        const u32 matchCount = integerDecode(token & 0xf, input, matchBytes) + 4u;
+        if (integerDecode(token & 0xf, input, inputEnd, matchCount, matchBytes) != Success)
+        {
+            ERROR("truncated match count");
+            return IOError;
+        }
         input += matchBytes;
+        matchCount += 4u;
+
+        if (matchCount > outputSize - outputOffset)
+        {
+            ERROR("match overrun: count = " << matchCount << " offset = " << outputOffset);
+            return IOError;
+        }
 
         // Copy the match from previous decoded bytes
         DEBUG("matchOffset = " << matchOffset << " matchCount = " << matchCount);
@@ -254,6 +327,6 @@ const u32 Lz4Decompressor::decompress(const u8 *input,
         outputOffset += matchCount;
     }
 
-    assert(outputOffset <= m_blockMaximumSize);
-    return outputOffset;
+    outputCount = outputOffset;
+    return Success;
 }
@@ -109,6 +109,19 @@ class Lz4Decompressor
      */
     Result read(void *buffer, const Size size) const;
 
+    /**
+     * Decompress the input as a single block without frame.
+     *
+     * Used for data compressed with Lz4Compressor::compressBlock().
+     * No initialize() is needed before calling this function.
+     *
+     * @param buffer Output buffer.
+     * @param size Number of bytes of uncompressed data in the block.
+     *
+     * @return Result code
+     */
+    Result readBlock(void *buffer, const Size size) const;
+
   private:
 
     /**
@@ -118,26 +131,32 @@ class Lz4Decompressor
      * @param inputSize Number of compressed bytes
      * @param output Output buffer to decompress to
      * @param outputSize Maximum number of bytes to decompress
+     * @param outputCount On output contains the number of bytes decompressed
      *
-     * @return Number of bytes decompressed
+     * @return Result code. IOError if the block overruns the input or output.
      */
-    const u32 decompress(const u8 *input,
-                         const Size inputSize,
-                         u8 *output,
-                         const Size outputSize) const;
+    Result decompress(const u8 *input,
+                      const Size inputSize,
+                      u8 *output,
+                      const Size outputSize,
+                      Size &outputCount) const;
 
     /**
      * Decode input data as integer (little-endian, 32-bit unsigned)
      *
      * @param initial The initial integer value to use
      * @param next Pointer to next data to decode as integer
+     * @param end End of the input data
+     * @param value On output contains the decoded integer value
      * @param byteCount On output contains the number of bytes decoded
      *
-     * @return Decoded unsigned 32-bit integer value
+     * @return Result code. IOError if the integer overruns the input.
      */
-    inline const u32 integerDecode(const u32 initial,
-                                   const u8 *next,
-                                   Size &byteCount) const;
+    inline Result integerDecode(const u32 initial,
+                                const u8 *next,
+                                const u8 *end,
+                                u32 &value,
+                                Size &byteCount) const;
 
   private:
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <MemoryBlock.h>
+#include "Lz4Decompressor.h"
+#include "ProgramImage.h"
+
+ProgramImage::ProgramImage()
+    : m_data(ZERO)
+    , m_size(0)
+    , m_entry(0)
+    , m_regionCount(0)
+{
+    MemoryBlock::set(m_shared, 0, sizeof(m_shared));
+}
+
+ProgramImage::~ProgramImage()
+{
+    if (m_data != ZERO)
+    {
+        delete[] m_data;
+    }
+
+    // Processes running the program keep their own references to the pages
+    for (Size i = 0; i < MaximumRegions; i++)
+    {
+        if (m_shared[i].size != 0)
+        {
+            VMCtl(SELF, Release, &m_shared[i]);
+        }
+    }
+}
+
+ProgramImage::Result ProgramImage::load(const u8 *file, const Size size)
+{
+    Lz4Decompressor lz4(file, size);
+
+    if (lz4.initialize() != Lz4Decompressor::Success)
+    {
+        return InvalidFormat;
+    }
+
+    // Decompress entire file into a temporary buffer
+    const Size imageSize = lz4.getUncompressedSize();
+    u8 *image = new u8[imageSize];
+    if (!image)
+    {
+        return OutOfMemory;
+    }
+
+    if (lz4.read(image, imageSize) != Lz4Decompressor::Success)
+    {
+        delete[] image;
+        return InvalidFormat;
+    }
+
+    const Result result = parse(image, imageSize);
+    delete[] image;
+    return result;
+}
+
+ProgramImage::Result ProgramImage::parse(const u8 *image, const Size size)
+{
+    ExecutableFormat *fmt;
+    Size count = MaximumRegions;
+    Size total = 0;
+
+    // Can only be loaded once
+    if (m_data != ZERO)
+    {
+        return InvalidFormat;
+    }
+
+    // Parse executable headers
+    if (ExecutableFormat::find(image, size, &fmt) != ExecutableFormat::Success)
+    {
+        return InvalidFormat;
+    }
+
+    if (fmt->entry(&m_entry) != ExecutableFormat::Success ||
+        fmt->regions(m_regions, &count) != ExecutableFormat::Success)
+    {
+        delete fmt;
+        return InvalidFormat;
+    }
+    delete fmt;
+
+    // Validate regions against the image
+    for (Size i = 0; i < count; i++)
+    {
+        if (m_regions[i].dataOffset > size ||
+            m_regions[i].dataSize > size - m_regions[i].dataOffset ||
+            m_regions[i].dataSize > m_regions[i].memorySize)
+        {
+            return InvalidFormat;
+        }
+
+        if (m_regions[i].access & Memory::Writable)
+        {
+            total += m_regions[i].dataSize;
+        }
+    }
+    m_regionCount = count;
+
+    // Prepare pages of read-only regions
+    for (Size i = 0; i < count; i++)
+    {
+        if (!(m_regions[i].access & Memory::Writable))
+        {
+            const Result result = loadShared(i, image);
+            if (result != Success)
+            {
+                return result;
+            }
+        }
+    }
+
+    // Pack the data of writable regions into a single buffer
+    m_data = new u8[total ? total : 1];
+    if (!m_data)
+    {
+        return OutOfMemory;
+    }
+
+    for (Size i = 0, offset = 0; i < count; i++)
+    {
+        if (m_regions[i].access & Memory::Writable)
+        {
+            MemoryBlock::copy(m_data + offset, image + m_regions[i].dataOffset,
+                              m_regions[i].dataSize);
+            m_regions[i].dataOffset = offset;
+            offset += m_regions[i].dataSize;
+        }
+    }
+
+    m_size += total;
+    return Success;
+}
+
+ProgramImage::Result ProgramImage::loadShared(const Size index, const u8 *image)
+{
+    ExecutableFormat::Region & region = m_regions[index];
+    Memory::Range & range = m_shared[index];
+    const Size pageOffset = region.virt & ~PAGEMASK;
+    Size size = pageOffset + region.memorySize;
+
+    if (size % PAGESIZE)
+    {
+        size += PAGESIZE - (size % PAGESIZE);
+    }
+
+    // Allocate whole pages, such that no other data shares them
+    range.virt   = ZERO;
+    range.phys   = ZERO;
+    range.size   = size;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (VMCtl(SELF, MapContiguous, &range) != API::Success)
+    {
+        MemoryBlock::set(&range, 0, sizeof(range));
+        return OutOfMemory;
+    }
+
+    if (VMCtl(SELF, LookupVirtual, &range) != API::Success)
+    {
+        VMCtl(SELF, Release, &range);
+        MemoryBlock::set(&range, 0, sizeof(range));
+        return OutOfMemory;
+    }
+
+    // Fill the pages as they must appear in the new process
+    MemoryBlock::set((void *) range.virt, 0, size);
+    MemoryBlock::copy((void *)(range.virt + pageOffset),
+                      image + region.dataOffset, region.dataSize);
+
+    // Map the pages read-only here, such that a stray write cannot modify
+    // the code of every process which shares them
+    Memory::Range readOnly = range;
+    readOnly.access = Memory::User | Memory::Readable;
+
+    if (VMCtl(SELF, UnMap, &range) != API::Success)
+    {
+        VMCtl(SELF, Release, &range);
+        MemoryBlock::set(&range, 0, sizeof(range));
+        return OutOfMemory;
+    }
+
+    if (VMCtl(SELF, MapContiguous, &readOnly) != API::Success)
+    {
+        // Restore the writable mapping, such that the pages can be released
+        VMCtl(SELF, MapContiguous, &range);
+        VMCtl(SELF, Release, &range);
+        MemoryBlock::set(&range, 0, sizeof(range));
+        return OutOfMemory;
+    }
+    range.access = readOnly.access;
+
+    region.dataOffset = 0;
+    m_size += size;
+    return Success;
+}
+
+const u8 * ProgramImage::data() const
+{
+    return m_data;
+}
+
+const Memory::Range * ProgramImage::sharedPages() const
+{
+    return m_shared;
+}
+
+Size ProgramImage::size() const
+{
+    return m_size;
+}
+
+Address ProgramImage::entry() const
+{
+    return m_entry;
+}
+
+const ExecutableFormat::Region * ProgramImage::regions() const
+{
+    return m_regions;
+}
+
+Size ProgramImage::regionCount() const
+{
+    return m_regionCount;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBEXEC_PROGRAMIMAGE_H
+#define __LIB_LIBEXEC_PROGRAMIMAGE_H
+
+#include <Types.h>
+#include <Memory.h>
+#include "ExecutableFormat.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libexec
+ * @{
+ */
+
+/**
+ * Decompressed and parsed program, ready to be spawned.
+ *
+ * Only the bytes which are loaded into memory at runtime are kept.
+ * Writable regions are packed one after another and must be copied
+ * into each new process. Read-only regions are prepared once in whole
+ * pages, which can be mapped shared into every process running the
+ * program. Symbol and debug sections of the original file are dropped
+ * after parsing.
+ */
+class ProgramImage
+{
+  public:
+
+    /** Maximum number of memory regions in a program */
+    static const Size MaximumRegions = 16;
+
+    /**
+     * Result codes
+     */
+    enum Result
+    {
+        Success,
+        InvalidFormat,
+        OutOfMemory
+    };
+
+  public:
+
+    /**
+     * Constructor
+     */
+    ProgramImage();
+
+    /**
+     * Destructor
+     */
+    ~ProgramImage();
+
+    /**
+     * Load a program from a LZ4 compressed file.
+     *
+     * @param file Contents of the program file
+     * @param size Size of the program file in bytes
+     *
+     * @return Result code
+     */
+    Result load(const u8 *file, const Size size);
+
+    /**
+     * Load a program from an uncompressed executable.
+     *
+     * @param image Uncompressed executable
+     * @param size Size of the executable in bytes
+     *
+     * @return Result code
+     */
+    Result parse(const u8 *image, const Size size);
+
+    /**
+     * Get packed data of writable regions.
+     *
+     * @return Pointer to region data. Region dataOffset fields are relative to it.
+     */
+    const u8 * data() const;
+
+    /**
+     * Get pages of read-only regions.
+     *
+     * @return Pointer to an array with one memory range per region. The range
+     *         is mapped in the current process and starts at the page of
+     *         the region virtual address. Writable regions have a zero size range.
+     */
+    const Memory::Range * sharedPages() const;
+
+    /**
+     * Get number of bytes held by this image.
+     *
+     * @return Size in bytes
+     */
+    Size size() const;
+
+    /**
+     * Get program entry point.
+     *
+     * @return Entry point address
+     */
+    Address entry() const;
+
+    /**
+     * Get memory regions.
+     *
+     * @return Pointer to array of memory regions
+     */
+    const ExecutableFormat::Region * regions() const;
+
+    /**
+     * Get number of memory regions.
+     *
+     * @return Number of regions
+     */
+    Size regionCount() const;
+
+  private:
+
+    /**
+     * Prepare the pages of a read-only region.
+     *
+     * @param index Region index
+     * @param image Uncompressed executable
+     *
+     * @return Result code
+     */
+    Result loadShared(const Size index, const u8 *image);
+
+  private:
+
+    /** Packed data of writable regions */
+    u8 *m_data;
+
+    /** Total number of bytes held by this image */
+    Size m_size;
+
+    /** Program entry point */
+    Address m_entry;
+
+    /** Memory regions of the program */
+    ExecutableFormat::Region m_regions[MaximumRegions];
+
+    /** Pages of read-only regions */
+    Memory::Range m_shared[MaximumRegions];
+
+    /** Number of valid memory regions */
+    Size m_regionCount;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBEXEC_PROGRAMIMAGE_H */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Assert.h>
+#include "ProgramImageCache.h"
+
+ProgramImageCache::ProgramImageCache(const Size maximumBytes)
+    : m_maximumBytes(maximumBytes)
+    , m_size(0)
+    , m_clock(0)
+{
+}
+
+ProgramImageCache::~ProgramImageCache()
+{
+    clear();
+}
+
+const ProgramImage * ProgramImageCache::lookup(const char *path,
+                                               const u32 inode,
+                                               const Size fileSize)
+{
+    for (Size i = 0; i < MaximumImages; i++)
+    {
+        Entry *entry = m_entries.get(i);
+
+        if (entry != ZERO && entry->path.equals(path))
+        {
+            // Discard the image if the file was replaced or modified
+            if (entry->inode != inode || entry->fileSize != fileSize)
+            {
+                remove(i);
+                return ZERO;
+            }
+
+            entry->lastUsed = ++m_clock;
+            return entry->image;
+        }
+    }
+
+    return ZERO;
+}
+
+void ProgramImageCache::insert(const char *path,
+                               const u32 inode,
+                               const Size fileSize,
+                               ProgramImage *image)
+{
+    Entry *entry = new Entry;
+    assert(entry != NULL);
+
+    // Replace any existing image for the same path
+    for (Size i = 0; i < MaximumImages; i++)
+    {
+        const Entry *e = m_entries.get(i);
+
+        if (e != ZERO && e->path.equals(path))
+        {
+            remove(i);
+        }
+    }
+
+    evict(image->size());
+
+    entry->path     = path;
+    entry->inode    = inode;
+    entry->fileSize = fileSize;
+    entry->lastUsed = ++m_clock;
+    entry->image    = image;
+
+    const bool inserted = m_entries.insert(entry);
+    assert(inserted);
+    (void) inserted;
+
+    m_size += image->size();
+}
+
+Size ProgramImageCache::count() const
+{
+    return m_entries.count();
+}
+
+Size ProgramImageCache::size() const
+{
+    return m_size;
+}
+
+void ProgramImageCache::clear()
+{
+    for (Size i = 0; i < MaximumImages; i++)
+    {
+        if (m_entries.get(i) != ZERO)
+        {
+            remove(i);
+        }
+    }
+}
+
+void ProgramImageCache::remove(const Size position)
+{
+    Entry *entry = m_entries.get(position);
+    assert(entry != ZERO);
+
+    m_size -= entry->image->size();
+    m_entries.remove(position);
+
+    delete entry->image;
+    delete entry;
+}
+
+void ProgramImageCache::evict(const Size bytes)
+{
+    while (m_entries.count() > 0 &&
+          (m_entries.count() == MaximumImages || m_size + bytes > m_maximumBytes))
+    {
+        Size oldest = 0;
+        const Entry *oldestEntry = ZERO;
+
+        for (Size i = 0; i < MaximumImages; i++)
+        {
+            const Entry *e = m_entries.get(i);
+
+            if (e != ZERO && (oldestEntry == ZERO || e->lastUsed < oldestEntry->lastUsed))
+            {
+                oldest = i;
+                oldestEntry = e;
+            }
+        }
+
+        remove(oldest);
+    }
+}
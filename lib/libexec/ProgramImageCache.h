@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBEXEC_PROGRAMIMAGECACHE_H
+#define __LIB_LIBEXEC_PROGRAMIMAGECACHE_H
+
+#include <Types.h>
+#include <Index.h>
+#include <Singleton.h>
+#include <String.h>
+#include "ProgramImage.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libexec
+ * @{
+ */
+
+/**
+ * Cache of parsed program images.
+ *
+ * Keeps the most recently spawned programs in memory, such that
+ * starting the same program again does not need to read, decompress
+ * and parse the program file. Images are identified by their path and
+ * validated against the inode number and size of the file. The least
+ * recently used image is evicted when the cache exceeds its budget.
+ */
+class ProgramImageCache : public StrictSingleton<ProgramImageCache>
+{
+  private:
+
+    /** Maximum number of cached images */
+    static const Size MaximumImages = 8;
+
+    /** Default maximum number of bytes held by the cache */
+    static const Size DefaultMaximumBytes = 1024 * 1024;
+
+    /**
+     * Cached program image.
+     */
+    struct Entry
+    {
+        /** Path of the program file */
+        String path;
+
+        /** Inode number of the program file */
+        u32 inode;
+
+        /** Size of the program file in bytes */
+        Size fileSize;
+
+        /** Last time this entry was used */
+        Size lastUsed;
+
+        /** Parsed program */
+        ProgramImage *image;
+    };
+
+  public:
+
+    /**
+     * Constructor
+     *
+     * @param maximumBytes Maximum number of bytes to keep cached
+     */
+    ProgramImageCache(const Size maximumBytes = DefaultMaximumBytes);
+
+    /**
+     * Destructor
+     */
+    ~ProgramImageCache();
+
+    /**
+     * Find a cached program image.
+     *
+     * A stale image for the same path is removed from the cache.
+     *
+     * @param path Path of the program file
+     * @param inode Current inode number of the program file
+     * @param fileSize Current size of the program file
+     *
+     * @return ProgramImage pointer or ZERO if not cached
+     */
+    const ProgramImage * lookup(const char *path, const u32 inode, const Size fileSize);
+
+    /**
+     * Add a program image to the cache.
+     *
+     * The cache takes ownership of the image. The most recently
+     * inserted image is always kept, even if it exceeds the budget.
+     * Previously returned image pointers may become invalid.
+     *
+     * @param path Path of the program file
+     * @param inode Inode number of the program file
+     * @param fileSize Size of the program file
+     * @param image Parsed program
+     */
+    void insert(const char *path, const u32 inode, const Size fileSize, ProgramImage *image);
+
+    /**
+     * Get number of cached images.
+     *
+     * @return Image count
+     */
+    Size count() const;
+
+    /**
+     * Get number of bytes held by cached images.
+     *
+     * @return Size in bytes
+     */
+    Size size() const;
+
+    /**
+     * Remove all images from the cache.
+     */
+    void clear();
+
+  private:
+
+    /**
+     * Remove a cached image.
+     *
+     * @param position Position of the entry to remove
+     */
+    void remove(const Size position);
+
+    /**
+     * Remove least recently used images until the given amount fits.
+     *
+     * @param bytes Number of bytes needed
+     */
+    void evict(const Size bytes);
+
+  private:
+
+    /** Cached images */
+    Index<Entry, MaximumImages> m_entries;
+
+    /** Maximum number of bytes to keep cached */
+    const Size m_maximumBytes;
+
+    /** Number of bytes held by cached images */
+    Size m_size;
+
+    /** Incremented on each use to order entries */
+    Size m_clock;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBEXEC_PROGRAMIMAGECACHE_H */
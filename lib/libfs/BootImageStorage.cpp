@@ -60,6 +60,29 @@ FileSystem::Result BootImageStorage::read(const u64 offset, void *buffer, const
     return FileSystem::Success;
 }
 
+FileSystem::Result BootImageStorage::physicalAddress(const u64 offset, Address & phys) const
+{
+    Memory::Range range;
+
+    if (offset >= capacity())
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    // The BootImage is mapped into our address space
+    range.virt = ((Address) m_image) + offset;
+
+    const API::Result r = VMCtl(SELF, LookupVirtual, &range);
+    if (r != API::Success)
+    {
+        ERROR("failed to lookup BootImage address using VMCtl: result = " << (int) r);
+        return FileSystem::IOError;
+    }
+
+    phys = range.phys;
+    return FileSystem::Success;
+}
+
 u64 BootImageStorage::capacity() const
 {
     return m_image->bootImageSize;
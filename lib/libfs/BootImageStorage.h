@@ -71,6 +71,16 @@ class BootImageStorage : public Storage
      */
     virtual FileSystem::Result read(const u64 offset, void *buffer, const Size size) const;
 
+    /**
+     * Retrieve the physical address of data in the boot image.
+     *
+     * @param offset Offset in the boot image.
+     * @param phys On output, the physical address of the byte at the given offset.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const u64 offset, Address & phys) const;
+
     /**
      * Retrieve maximum storage capacity.
      *
@@ -44,6 +44,16 @@ FileSystem::Result BootSymbolStorage::read(const u64 offset, void *buffer, const
     return m_bootImage.read(offset + m_segment.offset, buffer, size);
 }
 
+FileSystem::Result BootSymbolStorage::physicalAddress(const u64 offset, Address & phys) const
+{
+    if (offset >= capacity())
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    return m_bootImage.physicalAddress(offset + m_segment.offset, phys);
+}
+
 u64 BootSymbolStorage::capacity() const
 {
     return m_symbol.segmentsTotalSize;
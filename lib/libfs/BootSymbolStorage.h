@@ -67,6 +67,16 @@ class BootSymbolStorage : public Storage
      */
     virtual FileSystem::Result read(const u64 offset, void *buffer, const Size size) const;
 
+    /**
+     * Retrieve the physical address of data in the BootSymbol.
+     *
+     * @param offset Offset in the BootSymbol.
+     * @param phys On output, the physical address of the byte at the given offset.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const u64 offset, Address & phys) const;
+
     /**
      * Retrieve maximum storage capacity.
      *
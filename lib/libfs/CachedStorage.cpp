@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <Assert.h>
+#include <MemoryBlock.h>
+#include "CachedStorage.h"
+
+CachedStorage::CachedStorage(Storage *storage,
+                             const Size pageCount,
+                             const Size pageSize)
+    : m_storage(storage)
+    , m_pageCount(pageCount)
+    , m_pageSize(pageSize)
+    , m_pages(ZERO)
+    , m_run(ZERO)
+{
+}
+
+CachedStorage::~CachedStorage()
+{
+    if (m_pages != ZERO)
+    {
+        writeBack();
+
+        for (Size i = 0; i < m_pageCount; i++)
+        {
+            delete[] m_pages[i].data;
+        }
+        delete[] m_pages;
+        delete[] m_run;
+    }
+}
+
+FileSystem::Result CachedStorage::initialize()
+{
+    if (m_pages != ZERO)
+    {
+        return FileSystem::Success;
+    }
+
+    m_pages = new Page[m_pageCount];
+    assert(m_pages != NULL);
+
+    for (Size i = 0; i < m_pageCount; i++)
+    {
+        m_pages[i].offset = 0;
+        m_pages[i].data   = new u8[m_pageSize];
+        m_pages[i].valid  = false;
+        m_pages[i].dirty  = false;
+        assert(m_pages[i].data != NULL);
+    }
+
+    m_run = new u8[m_pageSize * MaximumRunPages];
+    assert(m_run != NULL);
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result CachedStorage::read(const u64 offset, void *buffer, const Size size) const
+{
+    u8 *dst = (u8 *) buffer;
+    Size done = 0;
+
+    if (m_pages == ZERO || offset + size > capacity())
+    {
+        return m_storage->read(offset, buffer, size);
+    }
+
+    while (done < size)
+    {
+        const u64 pos = offset + done;
+        const u64 base = pos - (pos % m_pageSize);
+        const Size skip = pos - base;
+        const Size num = (m_pageSize - skip) < (size - done) ?
+                         (m_pageSize - skip) : (size - done);
+        Page *page;
+
+        const FileSystem::Result result = fetch(base, true, page);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+
+        MemoryBlock::copy(dst + done, page->data + skip, num);
+        done += num;
+    }
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result CachedStorage::write(const u64 offset, void *buffer, const Size size)
+{
+    const u8 *src = (const u8 *) buffer;
+    Size done = 0;
+
+    if (m_pages == ZERO || offset + size > capacity())
+    {
+        return m_storage->write(offset, buffer, size);
+    }
+
+    while (done < size)
+    {
+        const u64 pos = offset + done;
+        const u64 base = pos - (pos % m_pageSize);
+        const Size skip = pos - base;
+        const Size num = (m_pageSize - skip) < (size - done) ?
+                         (m_pageSize - skip) : (size - done);
+        Page *page;
+
+        // Pages which are overwritten completely do not need to be read first
+        const bool partial = skip != 0 || num != pageLength(base);
+
+        const FileSystem::Result result = fetch(base, partial, page);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+
+        MemoryBlock::copy(page->data + skip, src + done, num);
+        page->dirty = true;
+        done += num;
+    }
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result CachedStorage::physicalAddress(const u64 offset, Address & phys) const
+{
+    if (m_pages != ZERO)
+    {
+        const FileSystem::Result result = writeBack();
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+    }
+
+    return m_storage->physicalAddress(offset, phys);
+}
+
+u64 CachedStorage::capacity() const
+{
+    return m_storage->capacity();
+}
+
+FileSystem::Result CachedStorage::flush()
+{
+    if (m_pages == ZERO)
+    {
+        return FileSystem::Success;
+    }
+
+    return writeBack();
+}
+
+FileSystem::Result CachedStorage::fetch(const u64 offset, const bool load, Page * & page) const
+{
+    Size index = search(offset);
+
+    // Replace the least recently used page on a miss
+    if (index == m_pageCount)
+    {
+        index = m_pageCount - 1;
+
+        if (m_pages[index].valid && m_pages[index].dirty)
+        {
+            const FileSystem::Result result = writeBack();
+            if (result != FileSystem::Success)
+            {
+                return result;
+            }
+        }
+
+        m_pages[index].valid = false;
+
+        if (load)
+        {
+            const FileSystem::Result result = m_storage->read(offset, m_pages[index].data,
+                                                              pageLength(offset));
+            if (result != FileSystem::Success)
+            {
+                return result;
+            }
+        }
+
+        m_pages[index].offset = offset;
+        m_pages[index].valid  = true;
+        m_pages[index].dirty  = false;
+    }
+
+    // Make it the most recently used page
+    if (index > 0)
+    {
+        const Page tmp = m_pages[index];
+
+        for (Size i = index; i > 0; i--)
+        {
+            m_pages[i] = m_pages[i - 1];
+        }
+        m_pages[0] = tmp;
+    }
+
+    page = &m_pages[0];
+    return FileSystem::Success;
+}
+
+Size CachedStorage::search(const u64 offset) const
+{
+    for (Size i = 0; i < m_pageCount; i++)
+    {
+        if (m_pages[i].valid && m_pages[i].offset == offset)
+        {
+            return i;
+        }
+    }
+
+    return m_pageCount;
+}
+
+FileSystem::Result CachedStorage::writeBack() const
+{
+    Page *run[MaximumRunPages];
+
+    while (true)
+    {
+        Page *first = ZERO;
+
+        // Start with the dirty page with the lowest offset
+        for (Size i = 0; i < m_pageCount; i++)
+        {
+            if (m_pages[i].valid && m_pages[i].dirty &&
+               (first == ZERO || m_pages[i].offset < first->offset))
+            {
+                first = &m_pages[i];
+            }
+        }
+
+        if (first == ZERO)
+        {
+            break;
+        }
+
+        // Combine all consecutive dirty pages
+        Size count = 0, length = 0;
+
+        for (Page *page = first; page != ZERO && count < MaximumRunPages; count++)
+        {
+            const Size len = pageLength(page->offset);
+
+            MemoryBlock::copy(m_run + length, page->data, len);
+            run[count] = page;
+            length += len;
+
+            const Size next = len == m_pageSize ? search(first->offset + length) : m_pageCount;
+            page = next != m_pageCount && m_pages[next].dirty ? &m_pages[next] : ZERO;
+        }
+
+        const FileSystem::Result result = m_storage->write(first->offset, m_run, length);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+
+        for (Size i = 0; i < count; i++)
+        {
+            run[i]->dirty = false;
+        }
+    }
+
+    return FileSystem::Success;
+}
+
+Size CachedStorage::pageLength(const u64 offset) const
+{
+    const u64 total = capacity();
+
+    return offset + m_pageSize <= total ? m_pageSize : (Size) (total - offset);
+}
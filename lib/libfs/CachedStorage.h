@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBFS_CACHEDSTORAGE_H
+#define __LIB_LIBFS_CACHEDSTORAGE_H
+
+#include <FreeNOS/Constant.h>
+#include <Types.h>
+#include "Storage.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libfs
+ * @{
+ */
+
+/**
+ * Write-back page cache on top of another Storage.
+ *
+ * Data is cached in a fixed number of pages, which are replaced in
+ * least recently used order. Writes only modify the cached pages.
+ * Dirty pages are written back when evicted or on flush(), where pages
+ * with consecutive offsets are combined into a single write.
+ *
+ * @note The underlying Storage must be initialized by the caller
+ *       and is not deleted by the CachedStorage.
+ */
+class CachedStorage : public Storage
+{
+  public:
+
+    /** Default number of pages in the cache */
+    static const Size DefaultPageCount = 64;
+
+    /** Maximum number of pages combined in a single write */
+    static const Size MaximumRunPages = 16;
+
+  private:
+
+    /**
+     * A cached page of the underlying storage.
+     */
+    struct Page
+    {
+        u64 offset; /**@< Offset of the page in the storage */
+        u8 *data;   /**@< Contents of the page */
+        bool valid; /**@< True if the page contains data */
+        bool dirty; /**@< True if the data must be written back */
+    };
+
+  public:
+
+    /**
+     * Constructor function.
+     *
+     * @param storage Underlying storage to cache.
+     * @param pageCount Number of pages in the cache.
+     * @param pageSize Size of each page in bytes.
+     */
+    CachedStorage(Storage *storage,
+                  const Size pageCount = DefaultPageCount,
+                  const Size pageSize = PAGESIZE);
+
+    /**
+     * Destructor function.
+     *
+     * Writes back all dirty pages.
+     */
+    virtual ~CachedStorage();
+
+    /**
+     * Initialize the Storage device
+     *
+     * Allocates the cache pages.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result initialize();
+
+    /**
+     * Read a contiguous set of data.
+     *
+     * @param offset Offset to start reading from.
+     * @param buffer Output buffer.
+     * @param size Number of bytes to copied.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result read(const u64 offset, void *buffer, const Size size) const;
+
+    /**
+     * Write a contiguous set of data.
+     *
+     * @param offset Offset to start writing to.
+     * @param buffer Input buffer.
+     * @param size Number of bytes to written.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result write(const u64 offset, void *buffer, const Size size);
+
+    /**
+     * Retrieve the physical address of the storage data.
+     *
+     * Dirty pages are written back first.
+     *
+     * @param offset Offset in the storage.
+     * @param phys On output, the physical address of the byte at the given offset.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const u64 offset, Address & phys) const;
+
+    /**
+     * Retrieve maximum storage capacity.
+     *
+     * @return Storage capacity.
+     */
+    virtual u64 capacity() const;
+
+    /**
+     * Write back all dirty pages.
+     *
+     * @return Result code
+     */
+    FileSystem::Result flush();
+
+  private:
+
+    /**
+     * Retrieve the cached page for the given offset.
+     *
+     * On a miss the least recently used page is replaced.
+     * The page becomes the most recently used page.
+     *
+     * @param offset Page aligned offset in the storage.
+     * @param load True to read the page contents from the storage on a miss.
+     * @param page On output, the cached page.
+     *
+     * @return Result code
+     */
+    FileSystem::Result fetch(const u64 offset, const bool load, Page * & page) const;
+
+    /**
+     * Search for a cached page.
+     *
+     * @param offset Page aligned offset in the storage.
+     *
+     * @return Index of the page or the page count if not cached.
+     */
+    Size search(const u64 offset) const;
+
+    /**
+     * Write back dirty pages in runs of consecutive offsets.
+     *
+     * @return Result code
+     */
+    FileSystem::Result writeBack() const;
+
+    /**
+     * Get the number of bytes of a page inside the storage.
+     *
+     * @param offset Page aligned offset in the storage.
+     *
+     * @return Number of bytes, less than the page size for the last page.
+     */
+    Size pageLength(const u64 offset) const;
+
+  private:
+
+    /** Underlying storage */
+    Storage *m_storage;
+
+    /** Number of pages in the cache */
+    const Size m_pageCount;
+
+    /** Size of each page in bytes */
+    const Size m_pageSize;
+
+    /** Cached pages, ordered from most to least recently used */
+    Page *m_pages;
+
+    /** Buffer to combine consecutive dirty pages into a single write */
+    u8 *m_run;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBFS_CACHEDSTORAGE_H */
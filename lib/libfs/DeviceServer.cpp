@@ -16,6 +16,7 @@
  */
 
 #include "LogLevelFile.h"
+#include "HeapProfileFile.h"
 #include "DeviceServer.h"
 
 DeviceServer::DeviceServer(const char *path)
@@ -53,6 +54,14 @@ FileSystem::Result DeviceServer::initialize()
         return logResult;
     }
 
+    // Add heap profile pseudo file
+    const FileSystem::Result heapResult = registerFile(new HeapProfileFile(getNextInode()), "heapprofile");
+    if (heapResult != FileSystem::Success)
+    {
+        ERROR("failed to register HeapProfileFile: result = " << (int) heapResult);
+        return heapResult;
+    }
+
     // Mount on the root file system
     const FileSystem::Result result = mount();
     if (result != FileSystem::Success)
@@ -28,6 +28,8 @@ File::File(const u32 inode,
     , m_gid(gid)
     , m_access(FileSystem::OwnerRWX)
     , m_size(0)
+    , m_notifying(0)
+    , m_notified(0)
 {
 }
 
@@ -59,6 +61,17 @@ FileSystem::Result File::write(IOBuffer & buffer,
     return FileSystem::NotSupported;
 }
 
+FileSystem::Result File::physicalAddress(const Size offset,
+                                         Address & phys)
+{
+    return FileSystem::NotSupported;
+}
+
+FileSystem::Result File::truncate(const Size size)
+{
+    return FileSystem::NotSupported;
+}
+
 FileSystem::Result File::status(FileSystem::FileStat &st)
 {
     st.type     = m_type;
@@ -80,3 +93,25 @@ bool File::canWrite() const
 {
     return true;
 }
+
+bool File::isNotifying(const Size status) const
+{
+    return status != 0 && (m_notifying & status) == status;
+}
+
+Size File::takeNotifications()
+{
+    const Size notified = m_notified;
+    m_notified = 0;
+    return notified;
+}
+
+void File::notifyReadable()
+{
+    m_notified |= FileSystem::Readable;
+}
+
+void File::notifyWritable()
+{
+    m_notified |= FileSystem::Writable;
+}
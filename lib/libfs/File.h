@@ -100,6 +100,36 @@ class File
                                      Size & size,
                                      const Size offset);
 
+    /**
+     * Retrieve the physical page containing file data.
+     *
+     * File systems which keep file contents in page aligned memory
+     * can implement this function to allow clients to map
+     * the file data directly into their address space. The whole
+     * page is mapped, so any bytes in the page past the end of the
+     * file must be zero.
+     *
+     * @param offset Page aligned offset inside the file.
+     * @param phys On output, the physical address of the page
+     *             which contains the file data at the given offset.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const Size offset,
+                                               Address & phys);
+
+    /**
+     * Change the size of the file.
+     *
+     * Data beyond the new size is discarded. When growing the file,
+     * the new data reads as zero bytes.
+     *
+     * @param size New size of the file in bytes.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result truncate(const Size size);
+
     /**
      * Retrieve file statistics.
      *
@@ -127,6 +157,36 @@ class File
      */
     virtual bool canWrite() const;
 
+    /**
+     * Check if the File signals the given events.
+     *
+     * Requests which wait for an event signalled by the File
+     * are only retried after the File has called notifyReadable()
+     * or notifyWritable(). Other requests are retried on every wakeup.
+     *
+     * @param status WaitStatus flags to check
+     *
+     * @return True if all given events are signalled, false otherwise
+     */
+    bool isNotifying(const Size status) const;
+
+    /**
+     * Retrieve and clear the events signalled by the File.
+     *
+     * @return WaitStatus flags signalled since the previous call
+     */
+    Size takeNotifications();
+
+    /**
+     * Signal that the File may have become readable.
+     */
+    void notifyReadable();
+
+    /**
+     * Signal that the File may have become writable.
+     */
+    void notifyWritable();
+
   protected:
 
     /** Inode number */
@@ -146,6 +206,12 @@ class File
 
     /** Size of the file, in bytes. */
     Size m_size;
+
+    /** WaitStatus flags of the events signalled by this File. */
+    Size m_notifying;
+
+    /** WaitStatus flags signalled but not yet retrieved. */
+    Size m_notified;
 };
 
 /**
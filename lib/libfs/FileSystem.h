@@ -43,7 +43,13 @@ namespace FileSystem
         WaitFile,
         MountFileSystem,
         WaitFileSystem,
-        GetFileSystems
+        GetFileSystems,
+        ReadFileVector,
+        WriteFileVector,
+        MapFile,
+        SetupRing,
+        SubmitRing,
+        TruncateFile
     };
 
     /**
@@ -131,6 +137,24 @@ namespace FileSystem
         u16 current;   /**@< Indicates the currently active status flags */
     };
 
+    /**
+     * Describes a single memory buffer for vectored I/O.
+     *
+     * @see ReadFileVector
+     * @see WriteFileVector
+     */
+    struct IOVector
+    {
+        Address address; /**@< Memory address of the buffer */
+        Size size;       /**@< Size of the buffer in bytes */
+    };
+
+    /** Maximum number of IOVector entries in a single vectored I/O request */
+    static const Size MaximumIOVectors = 16;
+
+    /** Maximum total size in bytes of all IOVector entries in a single request (1MiB) */
+    static const Size MaximumIOVectorSize = 1024 * 1024;
+
     /**
      * WaitSet status flags
      */
@@ -75,6 +75,10 @@ inline FileSystem::Result FileSystemClient::request(const ProcessID pid,
     assert(msg.pid != ROOTFS_PID);
     assert(msg.action != FileSystem::ReadFile);
     assert(msg.action != FileSystem::WriteFile);
+    assert(msg.action != FileSystem::ReadFileVector);
+    assert(msg.action != FileSystem::WriteFileVector);
+    assert(msg.action != FileSystem::MapFile);
+    assert(msg.action != FileSystem::TruncateFile);
 
     // Extend mounts table
     for (Size i = 0; i < MaximumFileSystemMounts; i++)
@@ -226,9 +230,12 @@ FileSystem::Result FileSystemClient::closeFile(const Size descriptor) const
     return FileSystem::Success;
 }
 
-FileSystem::Result FileSystemClient::readFile(const Size descriptor,
-                                              void *buf,
-                                              Size *size) const
+FileSystem::Result FileSystemClient::ioRequest(const Size descriptor,
+                                               const FileSystem::Action action,
+                                               const void *buf,
+                                               const Size vectorCount,
+                                               Size *size,
+                                               const Size offset) const
 {
     FileDescriptor::Entry *fd = FileDescriptor::instance()->getEntry(descriptor);
     if (!fd || !fd->open)
@@ -237,18 +244,38 @@ FileSystem::Result FileSystemClient::readFile(const Size descriptor,
     }
 
     FileSystemMessage msg;
-    msg.type     = ChannelMessage::Request;
-    msg.action   = FileSystem::ReadFile;
-    msg.inode    = fd->inode;
-    msg.buffer   = (char *)buf;
-    msg.size     = *size;
-    msg.offset   = fd->position;
+    msg.type        = ChannelMessage::Request;
+    msg.action      = action;
+    msg.inode       = fd->inode;
+    msg.buffer      = (char *)buf;
+    msg.size        = *size;
+    msg.offset      = offset;
+    msg.vectorCount = vectorCount;
 
     const FileSystem::Result result = request(fd->pid, msg);
     if (result == FileSystem::Success)
     {
         *size = msg.size;
-        fd->position += msg.size;
+    }
+
+    return result;
+}
+
+FileSystem::Result FileSystemClient::readFile(const Size descriptor,
+                                              void *buf,
+                                              Size *size) const
+{
+    FileDescriptor::Entry *fd = FileDescriptor::instance()->getEntry(descriptor);
+    if (!fd || !fd->open)
+    {
+        return FileSystem::NotFound;
+    }
+
+    const FileSystem::Result result = ioRequest(descriptor, FileSystem::ReadFile,
+                                                buf, ZERO, size, fd->position);
+    if (result == FileSystem::Success)
+    {
+        fd->position += *size;
     }
 
     return result;
@@ -264,24 +291,113 @@ FileSystem::Result FileSystemClient::writeFile(const Size descriptor,
         return FileSystem::NotFound;
     }
 
-    FileSystemMessage msg;
-    msg.type     = ChannelMessage::Request;
-    msg.action   = FileSystem::WriteFile;
-    msg.inode    = fd->inode;
-    msg.buffer   = (char *)buf;
-    msg.size     = *size;
-    msg.offset   = fd->position;
+    const FileSystem::Result result = ioRequest(descriptor, FileSystem::WriteFile,
+                                                buf, ZERO, size, fd->position);
+    if (result == FileSystem::Success)
+    {
+        fd->position += *size;
+    }
 
-    const FileSystem::Result result = request(fd->pid, msg);
+    return result;
+}
+
+FileSystem::Result FileSystemClient::readFile(const Size descriptor,
+                                              void *buf,
+                                              Size *size,
+                                              const Size offset) const
+{
+    return ioRequest(descriptor, FileSystem::ReadFile, buf, ZERO, size, offset);
+}
+
+FileSystem::Result FileSystemClient::writeFile(const Size descriptor,
+                                               const void *buf,
+                                               Size *size,
+                                               const Size offset) const
+{
+    return ioRequest(descriptor, FileSystem::WriteFile, buf, ZERO, size, offset);
+}
+
+FileSystem::Result FileSystemClient::readFileVector(const Size descriptor,
+                                                    const FileSystem::IOVector *vec,
+                                                    const Size count,
+                                                    Size *size) const
+{
+    FileDescriptor::Entry *fd = FileDescriptor::instance()->getEntry(descriptor);
+    if (!fd || !fd->open)
+    {
+        return FileSystem::NotFound;
+    }
+
+    if (count == 0 || count > FileSystem::MaximumIOVectors)
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    *size = 0;
+    for (Size i = 0; i < count; i++)
+    {
+        *size += vec[i].size;
+    }
+
+    const FileSystem::Result result = ioRequest(descriptor, FileSystem::ReadFileVector,
+                                                vec, count, size, fd->position);
     if (result == FileSystem::Success)
     {
-        *size = msg.size;
-        fd->position += msg.size;
+        fd->position += *size;
+    }
+
+    return result;
+}
+
+FileSystem::Result FileSystemClient::writeFileVector(const Size descriptor,
+                                                     const FileSystem::IOVector *vec,
+                                                     const Size count,
+                                                     Size *size) const
+{
+    FileDescriptor::Entry *fd = FileDescriptor::instance()->getEntry(descriptor);
+    if (!fd || !fd->open)
+    {
+        return FileSystem::NotFound;
+    }
+
+    if (count == 0 || count > FileSystem::MaximumIOVectors)
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    *size = 0;
+    for (Size i = 0; i < count; i++)
+    {
+        *size += vec[i].size;
+    }
+
+    const FileSystem::Result result = ioRequest(descriptor, FileSystem::WriteFileVector,
+                                                vec, count, size, fd->position);
+    if (result == FileSystem::Success)
+    {
+        fd->position += *size;
     }
 
     return result;
 }
 
+FileSystem::Result FileSystemClient::mapFile(const Size descriptor,
+                                             const Address virt,
+                                             const Size size,
+                                             const Size offset) const
+{
+    Size bytes = size;
+
+    return ioRequest(descriptor, FileSystem::MapFile, (const void *) virt, ZERO, &bytes, offset);
+}
+
+FileSystem::Result FileSystemClient::truncateFile(const Size descriptor,
+                                                  const Size size) const
+{
+    Size bytes = size;
+
+    return ioRequest(descriptor, FileSystem::TruncateFile, ZERO, ZERO, &bytes, 0);
+}
 
 FileSystem::Result FileSystemClient::deleteFile(const char *path) const
 {
@@ -150,6 +150,100 @@ class FileSystemClient
                                  const void *buf,
                                  Size *size) const;
 
+    /**
+     * Read a file at the given offset.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param buf Buffer for storing bytes read.
+     * @param size On input, number of bytes to read. On output, actual bytes read.
+     * @param offset Offset in the file to start reading.
+     *
+     * @return Result code
+     *
+     * @note The current position of the file descriptor is not changed.
+     */
+    FileSystem::Result readFile(const Size descriptor,
+                                void *buf,
+                                Size *size,
+                                const Size offset) const;
+
+    /**
+     * Write a file at the given offset.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param buf Input buffer for bytes to write.
+     * @param size On input, number of bytes to write. On output, actual bytes written.
+     * @param offset Offset in the file to start writing.
+     *
+     * @return Result code
+     *
+     * @note The current position of the file descriptor is not changed.
+     */
+    FileSystem::Result writeFile(const Size descriptor,
+                                 const void *buf,
+                                 Size *size,
+                                 const Size offset) const;
+
+    /**
+     * Read a file into multiple buffers using a single request.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param vec Array of buffers to fill, in order.
+     * @param count Number of entries in the vec array.
+     * @param size On output, actual bytes read.
+     *
+     * @return Result code
+     */
+    FileSystem::Result readFileVector(const Size descriptor,
+                                      const FileSystem::IOVector *vec,
+                                      const Size count,
+                                      Size *size) const;
+
+    /**
+     * Write a file from multiple buffers using a single request.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param vec Array of buffers to write, in order.
+     * @param count Number of entries in the vec array.
+     * @param size On output, actual bytes written.
+     *
+     * @return Result code
+     */
+    FileSystem::Result writeFileVector(const Size descriptor,
+                                       const FileSystem::IOVector *vec,
+                                       const Size count,
+                                       Size *size) const;
+
+    /**
+     * Map file contents read-only into our address space.
+     *
+     * The file system maps the physical pages containing the file data
+     * directly at the given virtual address, without copying.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param virt Page aligned virtual address to map the file at.
+     *             The range must be unmapped or reserved with MapLazy.
+     * @param size Number of bytes to map, must be a multiple of PAGESIZE.
+     * @param offset Page aligned offset in the file to start mapping.
+     *
+     * @return Result code. NotSupported if the file cannot be mapped directly.
+     */
+    FileSystem::Result mapFile(const Size descriptor,
+                               const Address virt,
+                               const Size size,
+                               const Size offset) const;
+
+    /**
+     * Change the size of a file.
+     *
+     * @param descriptor File descriptor number of the file
+     * @param size New size of the file in bytes
+     *
+     * @return Result code
+     */
+    FileSystem::Result truncateFile(const Size descriptor,
+                                    const Size size) const;
+
     /**
      * Remove a file from the file system.
      *
@@ -225,6 +319,25 @@ class FileSystemClient
      */
     FileSystem::Result request(const ProcessID pid, FileSystemMessage &msg) const;
 
+    /**
+     * Send a read or write request for an opened file
+     *
+     * @param descriptor File descriptor number of the file
+     * @param action Either a (vectored) read or write action
+     * @param buf Pointer to the data buffer or FileSystem::IOVector array
+     * @param vectorCount Number of FileSystem::IOVector entries or ZERO if not vectored
+     * @param size On input, number of bytes to transfer. On output, actual bytes transferred.
+     * @param offset Offset in the file to start the transfer.
+     *
+     * @return Result code
+     */
+    FileSystem::Result ioRequest(const Size descriptor,
+                                 const FileSystem::Action action,
+                                 const void *buf,
+                                 const Size vectorCount,
+                                 Size *size,
+                                 const Size offset) const;
+
     /**
      * Retrieve the ProcessID of the FileSystemMount for the given path.
      *
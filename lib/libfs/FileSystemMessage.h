@@ -46,6 +46,8 @@ typedef struct FileSystemMessage : public ChannelMessage
     Timer::Info timeout;           /**< Timeout value for the action */
     ProcessID pid;                 /**< Process identifier (used for redirection) */
     Size pathMountLength;          /**< Length of the mounted path (used for redirection) */
+    Size vectorCount;              /**< Number of FileSystem::IOVector entries in buffer (vectored I/O) */
+    bool ring;                     /**< True if the request was submitted on a FileSystemRing */
 }
 FileSystemMessage;
 
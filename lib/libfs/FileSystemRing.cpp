@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <Log.h>
+#include <ChannelClient.h>
+#include "FileDescriptor.h"
+#include "FileSystemMessage.h"
+#include "FileSystemRing.h"
+
+FileSystemRing::FileSystemRing(const ProcessID pid)
+    : m_pid(pid)
+    , m_submission(Channel::Producer, sizeof(FileSystemMessage))
+    , m_completion(Channel::Consumer, sizeof(FileSystemMessage))
+    , m_initialized(false)
+    , m_queued(0)
+    , m_pending(0)
+    , m_capacity((PAGESIZE / sizeof(FileSystemMessage)) - 2U)
+{
+}
+
+FileSystem::Result FileSystemRing::initialize()
+{
+    const SystemInformation info;
+    ProcessShares::MemoryShare share;
+
+    if (m_initialized)
+    {
+        return FileSystem::Success;
+    }
+
+    // Create shared memory mapping with the server for both channels
+    share.pid    = m_pid;
+    share.coreId = info.coreId;
+    share.tagId  = ShareTag;
+    share.range.size   = ShareSize;
+    share.range.virt   = 0;
+    share.range.phys   = 0;
+    share.range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    const API::Result shareResult = VMShare(m_pid, API::Create, &share);
+    if (shareResult != API::Success)
+    {
+        ERROR("VMShare failed for PID " << m_pid << ": result = " << (int) shareResult);
+        return shareResult == API::AlreadyExists ? FileSystem::AlreadyExists : FileSystem::IOError;
+    }
+
+    m_submission.setVirtual(share.range.virt, share.range.virt + PAGESIZE);
+    m_completion.setVirtual(share.range.virt + (PAGESIZE * 2), share.range.virt + (PAGESIZE * 3));
+
+    // Let the server attach to the shared memory mapping
+    FileSystemMessage msg;
+    msg.type   = ChannelMessage::Request;
+    msg.action = FileSystem::SetupRing;
+
+    const ChannelClient::Result result = ChannelClient::instance()->syncSendReceive(&msg, sizeof(msg), m_pid);
+    if (result != ChannelClient::Success)
+    {
+        ERROR("failed to send SetupRing to PID " << m_pid << ": result = " << (int) result);
+        return FileSystem::IpcError;
+    }
+    else if (msg.result == FileSystem::Success)
+    {
+        m_initialized = true;
+    }
+
+    return msg.result;
+}
+
+Size FileSystemRing::getPending() const
+{
+    return m_pending;
+}
+
+FileSystem::Result FileSystemRing::read(const Size descriptor,
+                                        void *buf,
+                                        const Size size,
+                                        const Size offset,
+                                        const Size identifier)
+{
+    FileSystemMessage msg;
+    msg.action      = FileSystem::ReadFile;
+    msg.identifier  = identifier;
+    msg.buffer      = (char *) buf;
+    msg.size        = size;
+    msg.offset      = offset;
+    msg.vectorCount = ZERO;
+
+    return queue(descriptor, msg);
+}
+
+FileSystem::Result FileSystemRing::write(const Size descriptor,
+                                         const void *buf,
+                                         const Size size,
+                                         const Size offset,
+                                         const Size identifier)
+{
+    FileSystemMessage msg;
+    msg.action      = FileSystem::WriteFile;
+    msg.identifier  = identifier;
+    msg.buffer      = (char *) buf;
+    msg.size        = size;
+    msg.offset      = offset;
+    msg.vectorCount = ZERO;
+
+    return queue(descriptor, msg);
+}
+
+FileSystem::Result FileSystemRing::stat(const Size descriptor,
+                                        FileSystem::FileStat *st,
+                                        const Size identifier)
+{
+    FileSystemMessage msg;
+    msg.action     = FileSystem::StatFile;
+    msg.identifier = identifier;
+    msg.buffer     = ZERO;
+    msg.size       = sizeof(*st);
+    msg.offset     = 0;
+    msg.stat       = st;
+
+    return queue(descriptor, msg);
+}
+
+FileSystem::Result FileSystemRing::queue(const Size descriptor, FileSystemMessage &msg)
+{
+    const FileDescriptor::Entry *fd = FileDescriptor::instance()->getEntry(descriptor);
+
+    if (!m_initialized)
+    {
+        return FileSystem::IOError;
+    }
+
+    if (!fd || !fd->open)
+    {
+        return FileSystem::NotFound;
+    }
+
+    // Only files of our file system server can be accessed
+    if (fd->pid != m_pid)
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    // Every request must have space for its completion
+    if (m_pending >= m_capacity)
+    {
+        return FileSystem::RetryAgain;
+    }
+
+    msg.type  = ChannelMessage::Request;
+    msg.inode = fd->inode;
+    msg.ring  = true;
+
+    if (m_submission.write(&msg) != Channel::Success)
+    {
+        return FileSystem::RetryAgain;
+    }
+
+    m_queued++;
+    m_pending++;
+    return FileSystem::Success;
+}
+
+FileSystem::Result FileSystemRing::submit()
+{
+    if (!m_initialized)
+    {
+        return FileSystem::IOError;
+    }
+
+    if (m_queued == 0)
+    {
+        return FileSystem::Success;
+    }
+
+    FileSystemMessage msg;
+    msg.type   = ChannelMessage::Request;
+    msg.action = FileSystem::SubmitRing;
+
+    const ChannelClient::Result result = ChannelClient::instance()->syncSendReceive(&msg, sizeof(msg), m_pid);
+    if (result != ChannelClient::Success)
+    {
+        ERROR("failed to send SubmitRing to PID " << m_pid << ": result = " << (int) result);
+        return FileSystem::IpcError;
+    }
+    else if (msg.result != FileSystem::Success)
+    {
+        return msg.result;
+    }
+
+    // The server reports the number of requests taken from the submission channel
+    m_queued = msg.size < m_queued ? m_queued - msg.size : 0;
+    return FileSystem::Success;
+}
+
+FileSystem::Result FileSystemRing::reap(FileSystemRing::Completion &completion)
+{
+    FileSystemMessage msg;
+
+    if (!m_initialized)
+    {
+        return FileSystem::IOError;
+    }
+
+    if (m_completion.read(&msg) != Channel::Success)
+    {
+        return FileSystem::NotFound;
+    }
+
+    completion.identifier = msg.identifier;
+    completion.result     = msg.result;
+    completion.size       = msg.size;
+
+    if (m_pending > 0)
+    {
+        m_pending--;
+    }
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result FileSystemRing::wait(FileSystemRing::Completion &completion)
+{
+    if (m_pending == 0)
+    {
+        return FileSystem::NotFound;
+    }
+
+    const FileSystem::Result result = submit();
+    if (result != FileSystem::Success)
+    {
+        return result;
+    }
+
+    // The server wakes us up after writing a completion
+    while (reap(completion) != FileSystem::Success)
+    {
+        ProcessCtl(SELF, EnterSleep, 0, 0);
+    }
+
+    return FileSystem::Success;
+}
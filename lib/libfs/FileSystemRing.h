@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIB_LIBFS_FILESYSTEMRING_H
+#define __LIB_LIBFS_FILESYSTEMRING_H
+
+#include <FreeNOS/API/ProcessID.h>
+#include <Types.h>
+#include <MemoryChannel.h>
+#include "FileSystem.h"
+
+struct FileSystemMessage;
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libfs
+ * @{
+ */
+
+/**
+ * Asynchronous submission/completion ring with a FileSystemServer.
+ *
+ * The ring consists of two MemoryChannels in a shared memory mapping
+ * with the file system server. Requests are queued on the submission channel
+ * without any IPC. A single SubmitRing request lets the server process all
+ * queued requests in one batch. The server writes a completion for each
+ * request to the completion channel, which can be reaped later.
+ *
+ * Each request is tagged with an identifier chosen by the caller,
+ * which is returned in the corresponding completion.
+ *
+ * @note Only one ring can be setup per file system per process.
+ */
+class FileSystemRing
+{
+  public:
+
+    /** VMShare tag identifier for the shared memory mapping of the ring */
+    static const Size ShareTag = 1;
+
+    /** Size of the shared memory mapping: data and feedback page of both channels */
+    static const Size ShareSize = PAGESIZE * 4;
+
+    /**
+     * Describes a completed request.
+     */
+    struct Completion
+    {
+        Size identifier;           /**@< Identifier given when the request was queued */
+        FileSystem::Result result; /**@< Result code of the request */
+        Size size;                 /**@< Number of bytes transferred */
+    };
+
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param pid ProcessID of the file system server
+     */
+    FileSystemRing(const ProcessID pid);
+
+    /**
+     * Setup the ring with the file system server.
+     *
+     * @return Result code
+     */
+    FileSystem::Result initialize();
+
+    /**
+     * Get the number of requests that did not complete yet.
+     *
+     * @return Number of requests queued, submitted or not yet reaped.
+     */
+    Size getPending() const;
+
+    /**
+     * Queue a read request.
+     *
+     * @param descriptor File descriptor of the file to read
+     * @param buf Output buffer, which must remain valid until completion
+     * @param size Maximum number of bytes to read
+     * @param offset Offset in the file to start reading
+     * @param identifier Identifier for the completion
+     *
+     * @return Result code. RetryAgain if the ring is full.
+     */
+    FileSystem::Result read(const Size descriptor,
+                            void *buf,
+                            const Size size,
+                            const Size offset,
+                            const Size identifier);
+
+    /**
+     * Queue a write request.
+     *
+     * @param descriptor File descriptor of the file to write
+     * @param buf Input buffer, which must remain valid until completion
+     * @param size Number of bytes to write
+     * @param offset Offset in the file to start writing
+     * @param identifier Identifier for the completion
+     *
+     * @return Result code. RetryAgain if the ring is full.
+     */
+    FileSystem::Result write(const Size descriptor,
+                             const void *buf,
+                             const Size size,
+                             const Size offset,
+                             const Size identifier);
+
+    /**
+     * Queue a request to retrieve file status.
+     *
+     * @param descriptor File descriptor of the file
+     * @param st Output FileStat, which must remain valid until completion
+     * @param identifier Identifier for the completion
+     *
+     * @return Result code. RetryAgain if the ring is full.
+     */
+    FileSystem::Result stat(const Size descriptor,
+                            FileSystem::FileStat *st,
+                            const Size identifier);
+
+    /**
+     * Let the server process all queued requests.
+     *
+     * @return Result code
+     */
+    FileSystem::Result submit();
+
+    /**
+     * Reap a completion, if available.
+     *
+     * @param completion Completion output
+     *
+     * @return Result code. NotFound if no completion is available.
+     */
+    FileSystem::Result reap(Completion &completion);
+
+    /**
+     * Wait until a completion is available and reap it.
+     *
+     * Queued requests are submitted first, if any.
+     *
+     * @param completion Completion output
+     *
+     * @return Result code. NotFound if no requests are pending.
+     */
+    FileSystem::Result wait(Completion &completion);
+
+  private:
+
+    /**
+     * Queue a request on the submission channel.
+     *
+     * @param descriptor File descriptor of the request
+     * @param msg Message to queue
+     *
+     * @return Result code
+     */
+    FileSystem::Result queue(const Size descriptor, FileSystemMessage &msg);
+
+  private:
+
+    /** ProcessID of the file system server */
+    const ProcessID m_pid;
+
+    /** Submission channel, produced by us */
+    MemoryChannel m_submission;
+
+    /** Completion channel, produced by the server */
+    MemoryChannel m_completion;
+
+    /** True if the ring is setup with the server */
+    bool m_initialized;
+
+    /** Number of requests queued but not yet submitted */
+    Size m_queued;
+
+    /** Number of requests not yet reaped */
+    Size m_pending;
+
+    /** Maximum number of pending requests */
+    const Size m_capacity;
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBFS_FILESYSTEMRING_H */
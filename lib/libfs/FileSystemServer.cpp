@@ -46,6 +46,12 @@ FileSystemServer::FileSystemServer(Directory *root, const char *path)
     addIPCHandler(FileSystem::MountFileSystem, &FileSystemServer::mountHandler);
     addIPCHandler(FileSystem::WaitFileSystem,  &FileSystemServer::pathHandler, false);
     addIPCHandler(FileSystem::GetFileSystems,  &FileSystemServer::getFileSystemsHandler);
+    addIPCHandler(FileSystem::ReadFileVector,  &FileSystemServer::pathHandler, false);
+    addIPCHandler(FileSystem::WriteFileVector, &FileSystemServer::pathHandler, false);
+    addIPCHandler(FileSystem::MapFile,         &FileSystemServer::pathHandler, false);
+    addIPCHandler(FileSystem::SetupRing,       &FileSystemServer::setupRingHandler);
+    addIPCHandler(FileSystem::SubmitRing,      &FileSystemServer::submitRingHandler);
+    addIPCHandler(FileSystem::TruncateFile,    &FileSystemServer::pathHandler, false);
 }
 
 FileSystemServer::~FileSystemServer()
@@ -55,6 +61,12 @@ FileSystemServer::~FileSystemServer()
         delete m_requests;
     }
 
+    for (HashIterator<u32, List<FileSystemRequest *> *> i(m_waiting); i.hasCurrent();)
+    {
+        delete i.current();
+        i.remove();
+    }
+
     clearFileCache(m_root);
 }
 
@@ -90,6 +102,7 @@ FileSystem::Result FileSystemServer::mount()
 
         // Fill the mounts table
         MemoryBlock::set(m_mounts, 0, sizeof(FileSystemMount) * MaximumFileSystemMounts);
+        ProcessCtl(SELF, RecordBootEvent, (Address) "mounted /");
         return FileSystem::Success;
     }
     // Other file systems send a request to root file system to mount.
@@ -99,6 +112,12 @@ FileSystem::Result FileSystemServer::mount()
         const FileSystem::Result result = rootfs.mountFileSystem(m_mountPath);
 
         assert(result == FileSystem::Success);
+
+        // Record the moment this file system is ready on the boot timeline
+        String event;
+        event << "mounted " << m_mountPath;
+        ProcessCtl(SELF, RecordBootEvent, (Address) *event);
+
         return result;
     }
     else
@@ -193,15 +212,16 @@ FileSystem::Result FileSystemServer::unregisterFile(const char *path)
 
 void FileSystemServer::pathHandler(FileSystemMessage *msg)
 {
+    // Only requests taken from a FileSystemRing complete on the ring
+    msg->ring = false;
+
     // Prepare request
     FileSystemRequest req(msg);
 
     // Process the request.
     if (processRequest(req) == FileSystem::RetryAgain)
     {
-        FileSystemRequest *reqCopy = new FileSystemRequest(msg);
-        assert(reqCopy != NULL);
-        m_requests->append(reqCopy);
+        waitRequest(msg);
     }
 }
 
@@ -260,7 +280,23 @@ FileSystem::Result FileSystemServer::inodeHandler(FileSystemRequest &req)
     }
     file = (*f);
 
-    if (msg->action == FileSystem::ReadFile)
+    // Vectored I/O transfers at most the total size of all I/O vectors
+    if (msg->action == FileSystem::ReadFileVector || msg->action == FileSystem::WriteFileVector)
+    {
+        if (req.getBuffer().getBuffer() == ZERO)
+        {
+            msg->result = FileSystem::InvalidArgument;
+            sendResponse(msg);
+            return msg->result;
+        }
+
+        if (msg->size > req.getBuffer().getSize())
+        {
+            msg->size = req.getBuffer().getSize();
+        }
+    }
+
+    if (msg->action == FileSystem::ReadFile || msg->action == FileSystem::ReadFileVector)
     {
         msg->result = file->read(req.getBuffer(), msg->size, msg->offset);
 
@@ -274,7 +310,7 @@ FileSystem::Result FileSystemServer::inodeHandler(FileSystemRequest &req)
 
         DEBUG(m_self << ": read = " << (int)msg->result);
     }
-    else if (msg->action == FileSystem::WriteFile)
+    else if (msg->action == FileSystem::WriteFile || msg->action == FileSystem::WriteFileVector)
     {
         if (!req.getBuffer().getCount())
         {
@@ -284,6 +320,21 @@ FileSystem::Result FileSystemServer::inodeHandler(FileSystemRequest &req)
         msg->result = file->write(req.getBuffer(), msg->size, msg->offset);
         DEBUG(m_self << ": write = " << (int)msg->result);
     }
+    else if (msg->action == FileSystem::MapFile)
+    {
+        msg->result = mapFile(file, msg);
+        DEBUG(m_self << ": map = " << (int)msg->result);
+    }
+    else if (msg->action == FileSystem::StatFile)
+    {
+        msg->result = statFile(file, msg);
+        DEBUG(m_self << ": stat = " << (int)msg->result);
+    }
+    else if (msg->action == FileSystem::TruncateFile)
+    {
+        msg->result = file->truncate(msg->size);
+        DEBUG(m_self << ": truncate = " << (int)msg->result);
+    }
     else
     {
         msg->result = FileSystem::NotSupported;
@@ -298,6 +349,85 @@ FileSystem::Result FileSystemServer::inodeHandler(FileSystemRequest &req)
     return msg->result;
 }
 
+FileSystem::Result FileSystemServer::mapFile(File *file, const FileSystemMessage *msg)
+{
+    const Address virt = (Address) msg->buffer;
+    Memory::Range range;
+    Address phys;
+
+    if (msg->size == 0 || (msg->size & ~PAGEMASK) || (msg->offset & ~PAGEMASK) || (virt & ~PAGEMASK))
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    // All pages must be available before anything is mapped
+    for (Size i = 0; i < msg->size; i += PAGESIZE)
+    {
+        const FileSystem::Result result = file->physicalAddress(msg->offset + i, phys);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+    }
+
+    range.size   = 0;
+    range.access = Memory::User | Memory::Readable;
+
+    // Map the pages read-only in the client, using as few mappings as possible
+    for (Size i = 0; i <= msg->size; i += PAGESIZE)
+    {
+        if (i < msg->size)
+        {
+            file->physicalAddress(msg->offset + i, phys);
+
+            if (range.size != 0 && range.phys + range.size == phys)
+            {
+                range.size += PAGESIZE;
+                continue;
+            }
+        }
+
+        if (range.size != 0)
+        {
+            const API::Result result = VMCtl(msg->from, MapShared, &range);
+            if (result != API::Success)
+            {
+                ERROR("failed to map file pages in PID " << msg->from << ": result = " << (int) result);
+                return result == API::AlreadyExists ? FileSystem::AlreadyExists : FileSystem::IOError;
+            }
+        }
+
+        range.virt = virt + i;
+        range.phys = phys;
+        range.size = PAGESIZE;
+    }
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result FileSystemServer::statFile(File *file, const FileSystemMessage *msg)
+{
+    FileSystem::FileStat st;
+
+    if (file->status(st) != FileSystem::Success)
+    {
+        return FileSystem::IOError;
+    }
+
+    st.pid = m_self;
+
+    // Copy to the remote process
+    const API::Result result = VMCopy(msg->from, API::Write, (Address) &st,
+                                      (Address) msg->stat, sizeof(st));
+    if (result != API::Success)
+    {
+        ERROR("VMCopy failed of FileStat for PID " << msg->from << ": result = " << (int) result);
+        return FileSystem::IOError;
+    }
+
+    return FileSystem::Success;
+}
+
 FileSystem::Result FileSystemServer::waitFileHandler(FileSystemRequest &req)
 {
     FileSystemMessage *msg = req.getMessage();
@@ -389,7 +519,10 @@ FileSystem::Result FileSystemServer::processRequest(FileSystemRequest &req)
     FileSystem::FileStat st;
 
     // Retrieve file by inode or by file path?
-    if (msg->action == FileSystem::ReadFile || msg->action == FileSystem::WriteFile)
+    if (msg->action == FileSystem::ReadFile || msg->action == FileSystem::WriteFile ||
+        msg->action == FileSystem::ReadFileVector || msg->action == FileSystem::WriteFileVector ||
+        msg->action == FileSystem::MapFile || msg->action == FileSystem::TruncateFile ||
+        (msg->ring && msg->action == FileSystem::StatFile))
     {
         return inodeHandler(req);
     }
@@ -480,33 +613,19 @@ FileSystem::Result FileSystemServer::processRequest(FileSystemRequest &req)
             break;
 
         case FileSystem::StatFile:
-            if (file->status(st) == FileSystem::Success)
-            {
-                st.pid = m_self;
-
-                // Copy to the remote process
-                const API::Result stResult = VMCopy(msg->from, API::Write, (Address) &st,
-                                                   (Address) msg->stat, sizeof(st));
-                if (stResult == API::Success)
-                {
-                    msg->result = FileSystem::Success;
-                }
-                else
-                {
-                    ERROR("VMCopy failed of FileStat for PID " << msg->from << ": result = " << (int) stResult);
-                    msg->result = FileSystem::IOError;
-                }
-            }
-            else
-            {
-                msg->result = FileSystem::IOError;
-            }
+            msg->result = statFile(file, msg);
             DEBUG(m_self << ": stat = " << (int)msg->result);
             break;
 
         case FileSystem::ReadFile:
         case FileSystem::WriteFile:
+        case FileSystem::ReadFileVector:
+        case FileSystem::WriteFileVector:
+        case FileSystem::MapFile:
         case FileSystem::WaitFile:
+        case FileSystem::SetupRing:
+        case FileSystem::SubmitRing:
+        case FileSystem::TruncateFile:
             break;
 
         case FileSystem::WaitFileSystem: {
@@ -533,7 +652,7 @@ FileSystem::Result FileSystemServer::processRequest(FileSystemRequest &req)
     return msg->result;
 }
 
-void FileSystemServer::sendResponse(FileSystemMessage *msg) const
+void FileSystemServer::sendResponse(FileSystemMessage *msg)
 {
     msg->type = ChannelMessage::Response;
 
@@ -541,7 +660,8 @@ void FileSystemServer::sendResponse(FileSystemMessage *msg) const
                     " for action = " << (int) msg->action <<
                     " with result = " << (int) msg->result);
 
-    Channel *channel = m_registry.getProducer(msg->from);
+    Channel *channel = msg->ring ? m_rings.getProducer(msg->from) :
+                                   m_registry.getProducer(msg->from);
     if (channel == ZERO)
     {
         ERROR("failed to retrieve channel for PID " << msg->from);
@@ -626,24 +746,200 @@ void FileSystemServer::getFileSystemsHandler(FileSystemMessage *msg)
     msg->result = FileSystem::Success;
 }
 
+void FileSystemServer::setupRingHandler(FileSystemMessage *msg)
+{
+    const SystemInformation info;
+    ProcessShares::MemoryShare share;
+    share.pid    = msg->from;
+    share.coreId = info.coreId;
+    share.tagId  = FileSystemRing::ShareTag;
+
+    // Retrieve the shared memory mapping created by the client
+    const API::Result result = VMShare(SELF, API::Read, &share);
+    if (result != API::Success)
+    {
+        ERROR("failed to read ring share for PID " << msg->from << ": result = " << (int) result);
+        msg->result = FileSystem::IOError;
+        return;
+    }
+
+    if (share.range.size < FileSystemRing::ShareSize)
+    {
+        ERROR("invalid ring share size for PID " << msg->from << ": " << share.range.size);
+        msg->result = FileSystem::InvalidArgument;
+        return;
+    }
+
+    msg->result = attachRing(msg->from, share.range.virt);
+}
+
+FileSystem::Result FileSystemServer::attachRing(const ProcessID pid, const Address base)
+{
+    // Replace the channels of a previous ring, if any
+    m_rings.unregisterConsumer(pid);
+    m_rings.unregisterProducer(pid);
+
+    MemoryChannel *submission = new MemoryChannel(Channel::Consumer, sizeof(FileSystemMessage));
+    assert(submission != NULL);
+    submission->setVirtual(base, base + PAGESIZE);
+
+    MemoryChannel *completion = new MemoryChannel(Channel::Producer, sizeof(FileSystemMessage));
+    assert(completion != NULL);
+    completion->setVirtual(base + (PAGESIZE * 2), base + (PAGESIZE * 3));
+
+    m_rings.registerConsumer(pid, submission);
+    m_rings.registerProducer(pid, completion);
+    return FileSystem::Success;
+}
+
+void FileSystemServer::submitRingHandler(FileSystemMessage *msg)
+{
+    Channel *channel = m_rings.getConsumer(msg->from);
+    FileSystemMessage entry;
+    Size count = 0;
+
+    if (channel == ZERO)
+    {
+        msg->result = FileSystem::NotFound;
+        return;
+    }
+
+    // Process all queued requests in one batch
+    while (channel->read(&entry) == Channel::Success)
+    {
+        entry.type = ChannelMessage::Request;
+        entry.from = msg->from;
+        entry.ring = true;
+        count++;
+
+        switch (entry.action)
+        {
+            case FileSystem::ReadFile:
+            case FileSystem::WriteFile:
+            case FileSystem::StatFile:
+            {
+                FileSystemRequest req(&entry);
+
+                if (processRequest(req) == FileSystem::RetryAgain)
+                {
+                    waitRequest(&entry);
+                }
+                break;
+            }
+
+            default:
+                entry.result = FileSystem::NotSupported;
+                sendResponse(&entry);
+                break;
+        }
+    }
+
+    msg->size   = count;
+    msg->result = FileSystem::Success;
+}
+
+void FileSystemServer::onProcessTerminated(const ProcessID pid)
+{
+    m_rings.unregisterConsumer(pid);
+    m_rings.unregisterProducer(pid);
+}
+
+void FileSystemServer::waitRequest(FileSystemMessage *msg)
+{
+    FileSystemRequest *reqCopy = new FileSystemRequest(msg);
+    assert(reqCopy != NULL);
+    Size status = 0;
+
+    switch (msg->action)
+    {
+        case FileSystem::ReadFile:
+        case FileSystem::ReadFileVector:
+            status = FileSystem::Readable;
+            break;
+
+        case FileSystem::WriteFile:
+        case FileSystem::WriteFileVector:
+            status = FileSystem::Writable;
+            break;
+
+        default:
+            break;
+    }
+
+    // Park the request on its File, if the File signals the awaited event
+    File *const *f = m_inodeMap.get(msg->inode);
+    if (f != ZERO && (*f)->isNotifying(status))
+    {
+        List<FileSystemRequest *> *const *list = m_waiting.get(msg->inode);
+
+        if (list != ZERO)
+        {
+            (*list)->append(reqCopy);
+        }
+        else
+        {
+            List<FileSystemRequest *> *requests = new List<FileSystemRequest *>();
+            assert(requests != NULL);
+            requests->append(reqCopy);
+            m_waiting.insert(msg->inode, requests);
+        }
+    }
+    else
+    {
+        m_requests->append(reqCopy);
+    }
+}
+
 bool FileSystemServer::retryRequests()
 {
-    bool restartNeeded = false;
+    bool restartNeeded = retryRequests(m_requests);
 
     DEBUG("");
 
-    for (ListIterator<FileSystemRequest *> i(m_requests); i.hasCurrent(); i++)
+    // Only retry requests parked on a File which signalled an event
+    for (HashIterator<u32, List<FileSystemRequest *> *> i(m_waiting); i.hasCurrent();)
+    {
+        File *const *f = m_inodeMap.get(i.key());
+
+        // Requests for removed files complete with NotFound
+        if (f == ZERO || (*f)->takeNotifications() != 0)
+        {
+            if (retryRequests(i.current()))
+            {
+                restartNeeded = true;
+            }
+        }
+
+        if (i.current()->count() == 0)
+        {
+            delete i.current();
+            i.remove();
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    return restartNeeded;
+}
+
+bool FileSystemServer::retryRequests(List<FileSystemRequest *> *requests)
+{
+    bool completed = false;
+
+    for (ListIterator<FileSystemRequest *> i(requests); i.hasCurrent(); i++)
     {
         FileSystem::Result result = processRequest(*i.current());
         if (result != FileSystem::RetryAgain)
         {
             delete i.current();
             i.remove();
-            restartNeeded = true;
+            completed = true;
         }
     }
 
-    return restartNeeded;
+    return completed;
 }
 
 void FileSystemServer::setRoot(Directory *newRoot)
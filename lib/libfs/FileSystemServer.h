@@ -29,6 +29,7 @@
 #include "FileSystemMessage.h"
 #include "FileSystemRequest.h"
 #include "FileSystemMount.h"
+#include "FileSystemRing.h"
 
 /**
  * @addtogroup lib
@@ -155,6 +156,21 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
      */
     void getFileSystemsHandler(FileSystemMessage *msg);
 
+    /**
+     * Attach to the FileSystemRing shared memory mapping of a client.
+     *
+     * @param msg FileSystemMessage pointer
+     */
+    void setupRingHandler(FileSystemMessage *msg);
+
+    /**
+     * Process all queued requests on the FileSystemRing of a client.
+     *
+     * @param msg FileSystemMessage pointer. On output, size contains
+     *            the number of requests taken from the ring.
+     */
+    void submitRingHandler(FileSystemMessage *msg);
+
     /**
      * Retry any pending requests
      *
@@ -162,8 +178,25 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
      */
     virtual bool retryRequests();
 
+    /**
+     * Called whenever another Process is terminated
+     *
+     * @param pid ProcessID of the terminating process
+     */
+    virtual void onProcessTerminated(const ProcessID pid);
+
   protected:
 
+    /**
+     * Attach the channels of a FileSystemRing.
+     *
+     * @param pid ProcessID of the client
+     * @param base Virtual address of the shared memory mapping
+     *
+     * @return Result code
+     */
+    FileSystem::Result attachRing(const ProcessID pid, const Address base);
+
     /**
      * Process a FileSystemRequest.
      *
@@ -172,6 +205,25 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
      */
     FileSystem::Result processRequest(FileSystemRequest &req);
 
+    /**
+     * Queue a request which cannot be completed yet.
+     *
+     * Requests which wait for an event signalled by their File
+     * are parked on that File. All others are retried on every wakeup.
+     *
+     * @param msg FileSystemMessage of the request to queue
+     */
+    void waitRequest(FileSystemMessage *msg);
+
+    /**
+     * Retry a list of pending requests.
+     *
+     * @param requests List of requests to retry
+     *
+     * @return True if any request completed, false otherwise
+     */
+    bool retryRequests(List<FileSystemRequest *> *requests);
+
     /**
      * Handle a request for a File specified by its inode
      *
@@ -181,6 +233,31 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
      */
     FileSystem::Result inodeHandler(FileSystemRequest &req);
 
+    /**
+     * Map file pages read-only into the address space of the client.
+     *
+     * Each mapped page holds a reference, such that the page stays
+     * allocated until the client releases it. The target virtual range
+     * must be unmapped or reserved by the client. On failure, pages
+     * mapped so far stay in the target range and are released with it.
+     *
+     * @param file File to map
+     * @param msg FileSystemMessage with the virtual address, size and offset to map
+     *
+     * @return Result code
+     */
+    FileSystem::Result mapFile(File *file, const FileSystemMessage *msg);
+
+    /**
+     * Copy the status of a File to the client.
+     *
+     * @param file File to retrieve status for
+     * @param msg FileSystemMessage with the FileStat output pointer
+     *
+     * @return Result code
+     */
+    FileSystem::Result statFile(File *file, const FileSystemMessage *msg);
+
     /**
      * Handle a WaitFile request
      *
@@ -195,7 +272,7 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
      *
      * @param msg The FileSystemMessage to send response for
      */
-    void sendResponse(FileSystemMessage *msg) const;
+    void sendResponse(FileSystemMessage *msg);
 
     /**
      * Try to forward the given FileSystemMessage to a mount file system.
@@ -313,8 +390,14 @@ class FileSystemServer : public ChannelServer<FileSystemServer, FileSystemMessag
     /** Table with mounted file systems (only used by the root file system). */
     FileSystemMount *m_mounts;
 
-    /** Contains ongoing requests */
+    /** Contains ongoing requests which are retried on every wakeup */
     List<FileSystemRequest *> *m_requests;
+
+    /** Ongoing requests parked on the File they wait for, by inode number */
+    HashTable<u32, List<FileSystemRequest *> *> m_waiting;
+
+    /** Submission (consumer) and completion (producer) channels of each FileSystemRing */
+    ChannelRegistry m_rings;
 };
 
 /**
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <Allocator.h>
+#include <String.h>
+#include "HeapProfileFile.h"
+
+HeapProfileFile::HeapProfileFile(const u32 inode)
+    : File(inode)
+{
+    m_access = FileSystem::OwnerR;
+}
+
+HeapProfileFile::~HeapProfileFile()
+{
+}
+
+FileSystem::Result HeapProfileFile::read(IOBuffer & buffer,
+                                         Size & size,
+                                         const Size offset)
+{
+    Allocator::ProfileSite sites[MaximumSites];
+    const Size count = Allocator::getDefault()->profile(sites, MaximumSites);
+    String output;
+
+    // Format the statistics of each allocation site
+    if (count > 0)
+    {
+        output << "CALLER";
+        output.pad(12) << "CLASS";
+        output.pad(22) << "COUNT";
+        output.pad(32) << "LIVE";
+        output.pad(42) << "PEAK\n";
+
+        for (Size i = 0; i < count; i++)
+        {
+            output << (void *) sites[i].caller;
+            output.pad(12) << sites[i].sizeClass;
+            output.pad(22) << sites[i].count;
+            output.pad(32) << sites[i].live;
+            output.pad(42) << sites[i].peak << "\n";
+        }
+    }
+
+    // Bounds checking
+    if (offset >= output.length())
+    {
+        size = 0;
+        return FileSystem::Success;
+    }
+
+    // Write to the output buffer
+    const Size bytes = output.length() - offset > size ? size : output.length() - offset;
+    size = bytes;
+
+    return buffer.write(*output + offset, bytes);
+}
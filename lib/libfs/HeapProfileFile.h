@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LIB_LIBFS_HEAPPROFILEFILE_H
+#define __LIB_LIBFS_HEAPPROFILEFILE_H
+
+#include <Types.h>
+#include "File.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libfs
+ * @{
+ */
+
+/**
+ * Provides a File abstraction of the heap profile of the current process.
+ *
+ * Each line shows the statistics of one allocation site, as recorded
+ * by the default Allocator. The file is empty if the default Allocator
+ * does not support profiling.
+ *
+ * @see Allocator::profile
+ */
+class HeapProfileFile : public File
+{
+  private:
+
+    /** Maximum number of allocation sites to show. */
+    static const Size MaximumSites = 64;
+
+  public:
+
+    /**
+     * Default constructor.
+     *
+     * @param inode Inode number for this File
+     */
+    HeapProfileFile(const u32 inode);
+
+    /**
+     * Destructor.
+     */
+    virtual ~HeapProfileFile();
+
+    /**
+     * @brief Read bytes from the file.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Maximum number of bytes to read on input.
+     *             On output, the actual number of bytes read.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result read(IOBuffer & buffer,
+                                    Size & size,
+                                    const Size offset);
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIB_LIBFS_HEAPPROFILEFILE_H */
@@ -27,6 +27,7 @@ IOBuffer::IOBuffer()
     , m_buffer(ZERO)
     , m_size(0)
     , m_count(0)
+    , m_vectorCount(0)
 {
 }
 
@@ -36,6 +37,7 @@ IOBuffer::IOBuffer(const FileSystemMessage *msg)
     , m_buffer(ZERO)
     , m_size(0)
     , m_count(0)
+    , m_vectorCount(0)
 {
     setMessage(msg);
 }
@@ -62,7 +64,53 @@ IOBuffer::~IOBuffer()
 
 void IOBuffer::setMessage(const FileSystemMessage *msg)
 {
-    if (msg->action == FileSystem::ReadFile || msg->action == FileSystem::WriteFile)
+    m_vectorCount = 0;
+
+    if (msg->action == FileSystem::ReadFileVector || msg->action == FileSystem::WriteFileVector)
+    {
+        m_message = msg;
+        m_size    = 0;
+        m_count   = 0;
+
+        if (msg->vectorCount == 0 || msg->vectorCount > FileSystem::MaximumIOVectors)
+        {
+            ERROR("invalid I/O vector count from PID " << msg->from << ": " << msg->vectorCount);
+            return;
+        }
+
+        // Retrieve the array of remote buffers
+        const API::Result result = VMCopy(msg->from, API::Read, (Address) m_vector,
+                                         (Address) msg->buffer, msg->vectorCount * sizeof(FileSystem::IOVector));
+        if (result != API::Success)
+        {
+            ERROR("failed to copy I/O vectors from PID " << msg->from << ": result = " << (int) result);
+            return;
+        }
+
+        // The remote buffers are gathered in a single local buffer of limited size
+        for (Size i = 0; i < msg->vectorCount; i++)
+        {
+            if (m_vector[i].size > FileSystem::MaximumIOVectorSize - m_size)
+            {
+                ERROR("I/O vectors from PID " << msg->from << " exceed " <<
+                      FileSystem::MaximumIOVectorSize << " bytes");
+                m_size = 0;
+                return;
+            }
+            m_size += m_vector[i].size;
+        }
+
+        m_buffer = new u8[m_size ? m_size : 1];
+        if (m_buffer == ZERO)
+        {
+            ERROR("failed to allocate " << m_size << " bytes for I/O vectors from PID " << msg->from);
+            m_size = 0;
+            return;
+        }
+        m_vectorCount = msg->vectorCount;
+        return;
+    }
+    else if (msg->action == FileSystem::ReadFile || msg->action == FileSystem::WriteFile)
     {
         // If the remote buffer is page aligned, we can directly map it (unbuffered)
         if (!isKernel && !((const ulong) msg->buffer & ~PAGEMASK))
@@ -106,6 +154,11 @@ void IOBuffer::setMessage(const FileSystemMessage *msg)
     m_count  = 0;
 }
 
+Size IOBuffer::getSize() const
+{
+    return m_size;
+}
+
 Size IOBuffer::getCount() const
 {
     return m_count;
@@ -131,7 +184,7 @@ FileSystem::Result IOBuffer::bufferedRead()
 {
     if (!m_directMapped)
     {
-        const FileSystem::Result result = read(m_buffer, m_message->size, 0);
+        const FileSystem::Result result = read(m_buffer, m_size, 0);
         if (result != FileSystem::Success)
         {
             m_count = 0;
@@ -139,7 +192,7 @@ FileSystem::Result IOBuffer::bufferedRead()
         }
     }
 
-    m_count = m_message->size;
+    m_count = m_size;
     return FileSystem::Success;
 }
 
@@ -162,6 +215,10 @@ FileSystem::Result IOBuffer::read(void *buffer, const Size size, const Size offs
         MemoryBlock::copy(buffer, m_buffer + offset, size);
         return FileSystem::Success;
     }
+    else if (m_vectorCount)
+    {
+        return copyVector(API::Read, buffer, size, offset);
+    }
 
     const API::Result result = VMCopy(m_message->from, API::Read,
                                      (Address) buffer,
@@ -186,6 +243,10 @@ FileSystem::Result IOBuffer::write(const void *buffer, const Size size, const Si
         MemoryBlock::copy(m_buffer + offset, buffer, size);
         return FileSystem::Success;
     }
+    else if (m_vectorCount)
+    {
+        return copyVector(API::Write, (void *) buffer, size, offset);
+    }
 
     const API::Result result = VMCopy(m_message->from, API::Write,
                                      (Address) buffer,
@@ -214,6 +275,46 @@ FileSystem::Result IOBuffer::flushWrite()
     }
 }
 
+FileSystem::Result IOBuffer::copyVector(const API::Operation how,
+                                       void *buffer,
+                                       const Size size,
+                                       const Size offset)
+{
+    Size vectorOffset = 0;
+    Size copied = 0;
+
+    for (Size i = 0; i < m_vectorCount && copied < size; i++)
+    {
+        const FileSystem::IOVector & vec = m_vector[i];
+        const Size position = offset + copied;
+
+        // Skip vectors which are entirely before the requested offset
+        if (position >= vectorOffset + vec.size)
+        {
+            vectorOffset += vec.size;
+            continue;
+        }
+
+        const Size skip = position - vectorOffset;
+        const Size bytes = (size - copied) < (vec.size - skip) ?
+                           (size - copied) : (vec.size - skip);
+
+        const API::Result result = VMCopy(m_message->from, how,
+                                         ((Address) buffer) + copied,
+                                          vec.address + skip, bytes);
+        if (result != API::Success)
+        {
+            ERROR("VMCopy failed for PID " << m_message->from << ": result = " << (int) result);
+            return FileSystem::IOError;
+        }
+
+        copied += bytes;
+        vectorOffset += vec.size;
+    }
+
+    return FileSystem::Success;
+}
+
 u8 IOBuffer::operator[](Size index) const
 {
     return index < m_size ? m_buffer[index] : 0;
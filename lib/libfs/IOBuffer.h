@@ -21,6 +21,8 @@
 #include <Types.h>
 #include <Macros.h>
 #include <Memory.h>
+#include <FreeNOS/User.h>
+#include "FileSystem.h"
 #include "FileSystemMessage.h"
 
 /**
@@ -55,6 +57,13 @@ class IOBuffer
      */
     virtual ~IOBuffer();
 
+    /**
+     * Get buffer size.
+     *
+     * @return Total number of bytes which can be transferred.
+     */
+    Size getSize() const;
+
     /**
      * Get byte count.
      *
@@ -155,6 +164,21 @@ class IOBuffer
 
   private:
 
+    /**
+     * Copy bytes between a local buffer and the remote I/O vectors.
+     *
+     * @param how Either API::Read to copy from the I/O vectors or API::Write to copy to them.
+     * @param buffer Local memory buffer.
+     * @param size Number of bytes to copy.
+     * @param offset Offset in bytes relative to the first I/O vector.
+     *
+     * @return Result code
+     */
+    FileSystem::Result copyVector(const API::Operation how,
+                                  void *buffer,
+                                  const Size size,
+                                  const Size offset);
+
     /**
      * @brief Current request being processed.
      *
@@ -181,6 +205,12 @@ class IOBuffer
 
     /** Bytes written to the buffer. */
     Size m_count;
+
+    /** Remote memory buffers for vectored I/O */
+    FileSystem::IOVector m_vector[FileSystem::MaximumIOVectors];
+
+    /** Number of entries in m_vector (zero if not vectored) */
+    Size m_vectorCount;
 };
 
 /**
@@ -30,3 +30,8 @@ FileSystem::Result Storage::write(const u64 offset, void *buffer, const Size siz
 {
     return FileSystem::NotSupported;
 }
+
+FileSystem::Result Storage::physicalAddress(const u64 offset, Address & phys) const
+{
+    return FileSystem::NotSupported;
+}
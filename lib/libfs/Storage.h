@@ -75,6 +75,18 @@ class Storage
      */
     virtual FileSystem::Result write(const u64 offset, void *buffer, const Size size);
 
+    /**
+     * Retrieve the physical address of the storage data.
+     *
+     * Only memory backed storage can implement this function.
+     *
+     * @param offset Offset in the storage.
+     * @param phys On output, the physical address of the byte at the given offset.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const u64 offset, Address & phys) const;
+
     /**
      * Retrieve maximum storage capacity.
      *
@@ -18,6 +18,7 @@
 #include <FreeNOS/User.h>
 #include <Log.h>
 #include <HashIterator.h>
+#include <ListIterator.h>
 #include "ChannelClient.h"
 #include "MemoryChannel.h"
 
@@ -239,6 +240,24 @@ ChannelClient::Result ChannelClient::processResponse(const ProcessID pid,
     return NotFound;
 }
 
+void ChannelClient::reset()
+{
+    const List<ProcessID> consumers = m_registry.getConsumers().keys();
+    const List<ProcessID> producers = m_registry.getProducers().keys();
+
+    for (ListIterator<ProcessID> i(consumers); i.hasCurrent(); i++)
+        m_registry.unregisterConsumer(i.current());
+
+    for (ListIterator<ProcessID> i(producers); i.hasCurrent(); i++)
+        m_registry.unregisterProducer(i.current());
+
+    // Responses to the requests of the parent are never received
+    for (Size i = 0; i < m_requests.count(); i++)
+        m_requests.get(i)->active = false;
+
+    m_pid = ProcessCtl(SELF, GetPID, 0);
+}
+
 
 Channel * ChannelClient::findConsumer(const ProcessID pid, const Size msgSize)
 {
@@ -201,6 +201,14 @@ class ChannelClient : public StrictSingleton<ChannelClient>
      */
     virtual Result syncSendReceive(void *buffer, const Size msgSize, const ProcessID pid);
 
+    /**
+     * Forget all channels and outgoing requests.
+     *
+     * Used by a cloned process, which does not inherit the
+     * shared memory channels of its parent.
+     */
+    void reset();
+
   private:
 
     /**
@@ -232,7 +240,7 @@ class ChannelClient : public StrictSingleton<ChannelClient>
     Index<Request, MaximumRequests> m_requests;
 
     /** Current Process ID */
-    const ProcessID m_pid;
+    ProcessID m_pid;
 };
 
 /**
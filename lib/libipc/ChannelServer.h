@@ -402,7 +402,12 @@ template <class Base, class MsgType> class ChannelServer
                 case ShareCreated:
                 {
                     DEBUG(m_self << ": share created for PID: " << event.share.pid);
-                    accept(event.share.pid, event.share.range);
+
+                    // Shares with other tags are not used for channels
+                    if (event.share.tagId == 0)
+                    {
+                        accept(event.share.pid, event.share.range);
+                    }
                     break;
                 }
                 case InterruptEvent:
@@ -186,9 +186,9 @@ MpiTarget::Result MpiTarget::initializeMaster(int *argc,
         programPath << programName;
     }
 
-    // Try to read the raw ELF program data (compressed)
+    // Try to map the raw ELF program data (compressed)
     BufferedFile programFile(*programPath);
-    const BufferedFile::Result readResult = programFile.read();
+    const BufferedFile::Result readResult = programFile.map();
     if (readResult != BufferedFile::Success)
     {
         ERROR("failed to read program at path '" << *programPath << "': result = " << (int) readResult);
@@ -29,6 +29,7 @@ ICMPSocket::ICMPSocket(const u32 inode,
 {
     m_icmp = icmp;
     m_gotReply = false;
+    m_notifying = FileSystem::Readable;
     MemoryBlock::set(&m_info, 0, sizeof(m_info));
 }
 
@@ -94,5 +95,6 @@ void ICMPSocket::setReply(const ICMP::Header *header)
     {
         MemoryBlock::copy(&m_reply, header, sizeof(ICMP::Header));
         m_gotReply = true;
+        notifyReadable();
     }
 }
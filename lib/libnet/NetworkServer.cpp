@@ -48,6 +48,8 @@ void NetworkServer::onProcessTerminated(const ProcessID pid)
     {
         m_device->unregisterSockets(pid);
     }
+
+    DeviceServer::onProcessTerminated(pid);
 }
 
 bool NetworkServer::retryRequests()
@@ -30,6 +30,7 @@ UDPSocket::UDPSocket(const u32 inode,
     , m_port(0)
     , m_queue(udp->getMaximumPacketSize())
 {
+    m_notifying = FileSystem::Readable;
 }
 
 UDPSocket::~UDPSocket()
@@ -170,6 +171,7 @@ FileSystem::Result UDPSocket::process(const NetworkQueue::Packet *pkt)
     buf->size = pkt->size;
     MemoryBlock::copy(buf->data, pkt->data, pkt->size);
     m_queue.push(buf);
+    notifyReadable();
 
     return FileSystem::Success;
 }
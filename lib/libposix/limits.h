@@ -20,6 +20,7 @@
 
 #include <Macros.h>
 #include <sys/types.h>
+#include <FileSystem.h>
 #include <FileSystemPath.h>
 
 /**
@@ -36,6 +37,9 @@
 /** Maximum file path length. */
 #define PATH_MAX  FileSystemPath::MaximumLength
 
+/** Maximum number of iovec structures for readv() and writev(). */
+#define IOV_MAX   FileSystem::MaximumIOVectors
+
 /**
  * @}
  * @}
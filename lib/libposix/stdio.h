@@ -54,6 +54,21 @@
  * @{
  */
 
+/** End-of-file return value. */
+#define EOF             (-1)
+
+/** Default size of stream buffers. */
+#define BUFSIZ          4096
+
+/** Fully buffered input/output. */
+#define _IOFBF          0
+
+/** Line buffered input/output. */
+#define _IOLBF          1
+
+/** Unbuffered input/output. */
+#define _IONBF          2
+
 /**
  * A structure containing information about a file.
  */
@@ -61,6 +76,36 @@ typedef struct FILE
 {
     /** File descriptor. */
     int fd;
+
+    /** Buffering mode: _IOFBF, _IOLBF or _IONBF. */
+    int mode;
+
+    /** Stream buffer, or NULL if not allocated yet. */
+    char *buffer;
+
+    /** Size of the stream buffer in bytes. */
+    Size size;
+
+    /** Index of the next byte to read from or write to the buffer. */
+    Size position;
+
+    /** Number of bytes in the buffer when reading. */
+    Size count;
+
+    /** Buffer contains output which is not written yet. */
+    bool writing;
+
+    /** Buffer was allocated by the stream itself. */
+    bool allocated;
+
+    /** End-of-file reached? */
+    bool eof;
+
+    /** Read or write error occurred? */
+    bool error;
+
+    /** Next stream in the list of open streams. */
+    struct FILE *next;
 }
 FILE;
 
@@ -164,6 +209,117 @@ extern C size_t fwrite(const void *ptr, size_t size,
  */
 extern C int fclose(FILE *stream);
 
+/**
+ * @brief Flush a stream.
+ *
+ * If stream points to an output stream, the fflush() function shall
+ * cause any unwritten data for that stream to be written to the file.
+ * If stream points to an input stream, any unread buffered data is
+ * discarded and the file offset is set to the position of the stream.
+ * If stream is a null pointer, fflush() shall perform this flushing
+ * action on all open streams.
+ *
+ * @param stream File stream to flush or NULL for all streams.
+ *
+ * @return Upon successful completion, fflush() shall return 0; otherwise,
+ *         it shall set the error indicator for the stream, return EOF,
+ *         and set errno to indicate the error.
+ */
+extern C int fflush(FILE *stream);
+
+/**
+ * @brief Assign buffering to a stream.
+ *
+ * The setvbuf() function may be used after the stream pointed to by
+ * stream is associated with an open file but before any other operation
+ * is performed on the stream. The argument mode determines how stream
+ * will be buffered: _IOFBF causes input/output to be fully buffered,
+ * _IOLBF causes output to be flushed on each newline and _IONBF causes
+ * input/output to be unbuffered. If buf is not a null pointer, the array
+ * it points to may be used instead of a buffer allocated by setvbuf().
+ *
+ * @param stream File stream to modify.
+ * @param buf Buffer to use or NULL to allocate a buffer.
+ * @param type Buffering mode.
+ * @param size Size of the buffer or zero for BUFSIZ.
+ *
+ * @return Upon successful completion, setvbuf() shall return 0.
+ *         Otherwise, it shall return a non-zero value if an invalid
+ *         value is given for type or if the request cannot be honored,
+ *         and set errno to indicate the error.
+ */
+extern C int setvbuf(FILE *stream, char *buf, int type, size_t size);
+
+/**
+ * @brief Get a byte from a stream.
+ *
+ * @param stream File stream to read from.
+ *
+ * @return Upon successful completion, fgetc() shall return the next byte
+ *         from the input stream pointed to by stream. If the end-of-file
+ *         indicator for the stream is set, or if the stream is at end-of-file
+ *         or a read error occurs, fgetc() shall return EOF.
+ */
+extern C int fgetc(FILE *stream);
+
+/**
+ * @brief Put a byte on a stream.
+ *
+ * @param c Byte to write.
+ * @param stream File stream to write to.
+ *
+ * @return Upon successful completion, fputc() shall return the value
+ *         it has written. Otherwise, it shall return EOF, the error indicator
+ *         for the stream shall be set, and errno shall be set to indicate the error.
+ */
+extern C int fputc(int c, FILE *stream);
+
+/**
+ * @brief Get a string from a stream.
+ *
+ * The fgets() function shall read bytes from stream into the array
+ * pointed to by s until n-1 bytes are read, or a newline is read and
+ * transferred to s, or an end-of-file condition is encountered.
+ * A null byte shall be written immediately after the last byte read into the array.
+ *
+ * @param s Output buffer.
+ * @param n Size of the output buffer.
+ * @param stream File stream to read from.
+ *
+ * @return Upon successful completion, fgets() shall return s. If the stream is
+ *         at end-of-file before any byte is read, or if a read error occurs,
+ *         fgets() shall return a null pointer.
+ */
+extern C char * fgets(char *s, int n, FILE *stream);
+
+/**
+ * @brief Reposition a file-position indicator in a stream.
+ *
+ * Any unwritten output is written and any unread input is discarded
+ * before the file offset is changed. The end-of-file indicator
+ * for the stream is cleared.
+ *
+ * @param stream File stream to reposition.
+ * @param offset New position relative to whence.
+ * @param whence Determines how to interpret offset, see lseek().
+ *
+ * @return The fseek() function shall return 0 if it succeeds.
+ *         Otherwise, it shall return -1 and set errno to indicate the error.
+ */
+extern C int fseek(FILE *stream, long offset, int whence);
+
+/**
+ * @brief Return a file offset in a stream.
+ *
+ * @param stream File stream to query.
+ *
+ * @return Upon successful completion, ftell() shall return the current
+ *         value of the file-position indicator for the stream measured in
+ *         bytes from the beginning of the file. Otherwise, ftell() shall
+ *         return -1, and set errno to indicate the error.
+ */
+extern C long ftell(FILE *stream);
+
 /**
  * @}
  */
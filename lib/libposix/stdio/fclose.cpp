@@ -19,13 +19,26 @@
 #include "stdio.h"
 #include "stdlib.h"
 #include "errno.h"
+#include "stream.h"
 
 int fclose(FILE *stream)
 {
+    // Write out any pending output
+    const int result = streamFlush(stream);
+    streamUnregister(stream);
+
     // Close and free
     close(stream->fd);
+    if (stream->allocated)
+        free(stream->buffer);
     free(stream);
 
+    if (result != 0)
+    {
+        errno = EIO;
+        return EOF;
+    }
+
     // Success
     errno = 0;
     return 0;
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdio.h"
+
+int fgetc(FILE *stream)
+{
+    unsigned char c;
+
+    // Single bytes are taken from the stream buffer
+    if (stream->position < stream->count && !stream->writing)
+    {
+        return (unsigned char) stream->buffer[stream->position++];
+    }
+
+    if (fread(&c, 1, 1, stream) != 1)
+    {
+        return EOF;
+    }
+
+    return c;
+}
@@ -16,31 +16,95 @@
  */
 
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h>
+#include <sys/stat.h>
 #include "stdio.h"
 #include "stdlib.h"
 #include "errno.h"
+#include "stream.h"
 
 FILE * fopen(const char *filename,
              const char *mode)
 {
+    struct stat st;
     FILE *f;
+    int fd;
 
     // Handle the file stream request
     switch (*mode)
     {
         // Read
         case 'r':
-            f = (FILE *) malloc(sizeof(FILE));
-            f->fd = open(filename, ZERO);
-            return f;
+            fd = open(filename, ZERO);
+            break;
+
+        // Write or append, creating the file if needed
+        case 'w':
+        case 'a':
+            fd = open(filename, ZERO);
+            if (fd < 0)
+            {
+                if (creat(filename, S_IRUSR | S_IWUSR) != 0)
+                    return (FILE *) NULL;
+
+                fd = open(filename, ZERO);
+            }
+            else if (*mode == 'w' && ftruncate(fd, 0) != 0)
+            {
+                // Recreate regular files which do not support truncation.
+                // Other files, such as devices, have no contents to discard.
+                if (errno != EINVAL || stat(filename, &st) != 0)
+                {
+                    close(fd);
+                    return (FILE *) NULL;
+                }
+                else if (S_ISREG(st.st_mode))
+                {
+                    close(fd);
+
+                    if (unlink(filename) != 0 || creat(filename, S_IRUSR | S_IWUSR) != 0)
+                        return (FILE *) NULL;
+
+                    fd = open(filename, ZERO);
+                }
+            }
+            else if (*mode == 'a' && stat(filename, &st) == 0)
+            {
+                lseek(fd, st.st_size, SEEK_SET);
+            }
+            break;
 
         // Unsupported
         default:
-            break;
+            errno = ENOTSUP;
+            return (FILE *) NULL;
+    }
+
+    if (fd < 0)
+    {
+        return (FILE *) NULL;
+    }
+
+    // Setup a fully buffered stream. The buffer is allocated on first use.
+    f = (FILE *) malloc(sizeof(FILE));
+    if (!f)
+    {
+        close(fd);
+        errno = ENOMEM;
+        return (FILE *) NULL;
     }
+    f->fd        = fd;
+    f->mode      = _IOFBF;
+    f->buffer    = ZERO;
+    f->size      = BUFSIZ;
+    f->position  = 0;
+    f->count     = 0;
+    f->writing   = false;
+    f->allocated = false;
+    f->eof       = false;
+    f->error     = false;
+    streamRegister(f);
 
-    // Sorry, not available yet!
-    errno = ENOTSUP;
-    return (FILE *) NULL;
+    return f;
 }
@@ -19,24 +19,61 @@
 #include <sys/types.h>
 #include "stdio.h"
 #include "stdlib.h"
+#include "string.h"
 #include "errno.h"
+#include "stream.h"
 
 size_t fread(void *ptr, size_t size,
              size_t nitems, FILE *stream)
 {
-    size_t i;
     char *buf = (char *) ptr;
+    const Size total = size * nitems;
+    Size done = 0;
 
-    // Read items
-    for (i = 0; i < nitems; i++)
+    if (total == 0)
+        return 0;
+
+    // Write out pending output before reading
+    if (stream->writing && streamFlush(stream) != 0)
+        return 0;
+
+    if (streamSetup(stream) != 0)
+        return 0;
+
+    while (done < total)
     {
-        ssize_t num = read(stream->fd, buf, size);
-        if (num < 0 || (size_t)num != size)
-            break;
+        const Size available = stream->count - stream->position;
+        const Size remaining = total - done;
 
-        buf += size;
+        // Take bytes from the buffer first
+        if (available > 0)
+        {
+            const Size num = available < remaining ? available : remaining;
+            memcpy(buf + done, stream->buffer + stream->position, num);
+            stream->position += num;
+            done += num;
+        }
+        // Large reads bypass the buffer
+        else if (remaining >= stream->size)
+        {
+            const ssize_t num = read(stream->fd, buf + done, remaining);
+            if (num <= 0)
+            {
+                if (num < 0)
+                    stream->error = true;
+                else
+                    stream->eof = true;
+                break;
+            }
+            done += num;
+        }
+        // Refill the buffer
+        else if (streamFill(stream) <= 0)
+        {
+            break;
+        }
     }
 
     // Done
-    return i;
+    return done / size;
 }
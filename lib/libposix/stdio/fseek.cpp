@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include "stdio.h"
+#include "errno.h"
+#include "stream.h"
+
+int fseek(FILE *stream, long offset, int whence)
+{
+    // Realign the file offset with the stream position
+    if (streamFlush(stream) != 0)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    if (lseek(stream->fd, offset, whence) == -1)
+    {
+        return -1;
+    }
+
+    stream->eof = false;
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include "stdio.h"
+#include "errno.h"
+#include "stream.h"
+
+long ftell(FILE *stream)
+{
+    const off_t offset = lseek(stream->fd, 0, SEEK_CUR);
+
+    if (offset == -1)
+    {
+        return -1;
+    }
+
+    // Account for buffered output and unread input
+    if (stream->writing)
+        return offset + stream->position;
+    else
+        return offset - (stream->count - stream->position);
+}
@@ -19,24 +19,78 @@
 #include <sys/types.h>
 #include "stdio.h"
 #include "stdlib.h"
+#include "string.h"
 #include "errno.h"
+#include "stream.h"
 
 size_t fwrite(const void *ptr, size_t size,
               size_t nitems, FILE *stream)
 {
-    size_t i;
-    char *buf = (char *) ptr;
+    const char *buf = (const char *) ptr;
+    const Size total = size * nitems;
+    bool newline = false;
+    Size done = 0;
 
-    // Write items
-    for (i = 0; i < nitems; i++)
+    if (total == 0)
+        return 0;
+
+    // Discard unread input before writing
+    if (!stream->writing)
+    {
+        if (streamFlush(stream) != 0)
+            return 0;
+
+        stream->writing = true;
+    }
+
+    if (streamSetup(stream) != 0)
+        return 0;
+
+    while (done < total)
+    {
+        const Size remaining = total - done;
+
+        // Large writes bypass the buffer when it is empty
+        if (stream->position == 0 && remaining >= stream->size)
+        {
+            const ssize_t num = write(stream->fd, buf + done, remaining);
+            if (num <= 0)
+            {
+                stream->error = true;
+                break;
+            }
+            done += num;
+        }
+        else
+        {
+            const Size space = stream->size - stream->position;
+            const Size num = space < remaining ? space : remaining;
+
+            memcpy(stream->buffer + stream->position, buf + done, num);
+            stream->position += num;
+            done += num;
+
+            // Write out the buffer when full
+            if (stream->position == stream->size)
+            {
+                if (streamFlush(stream) != 0)
+                    break;
+
+                stream->writing = true;
+            }
+        }
+    }
+
+    // Line buffered streams are flushed on each newline
+    if (stream->mode == _IOLBF)
     {
-        ssize_t num = write(stream->fd, buf, size);
-        if (num < 0 || (size_t)num != size)
-            break;
+        for (Size i = 0; i < done && !newline; i++)
+            newline = buf[i] == '\n';
 
-        buf += size;
+        if (newline)
+            streamFlush(stream);
     }
 
     // Done
-    return i;
+    return done / size;
 }
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stdio.h"
+#include "stdlib.h"
+#include "errno.h"
+#include "stream.h"
+
+int setvbuf(FILE *stream, char *buf, int type, size_t size)
+{
+    if (type != _IOFBF && type != _IOLBF && type != _IONBF)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Write out pending output first
+    if (streamFlush(stream) != 0)
+    {
+        errno = EIO;
+        return -1;
+    }
+
+    // Release the previous buffer
+    if (stream->allocated)
+    {
+        free(stream->buffer);
+        stream->allocated = false;
+    }
+
+    // Assign the new buffer. Without a user buffer,
+    // the stream allocates one on first use.
+    stream->mode   = type;
+    stream->buffer = type == _IONBF ? ZERO : buf;
+    stream->size   = type == _IONBF ? 0 : (size ? size : BUFSIZ);
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include "stdio.h"
+#include "stdlib.h"
+#include "errno.h"
+#include "stream.h"
+
+/** Head of the list of open streams. */
+static FILE *streams = ZERO;
+
+void streamRegister(FILE *stream)
+{
+    stream->next = streams;
+    streams = stream;
+}
+
+void streamUnregister(FILE *stream)
+{
+    for (FILE **s = &streams; *s != ZERO; s = &(*s)->next)
+    {
+        if (*s == stream)
+        {
+            *s = stream->next;
+            break;
+        }
+    }
+}
+
+int streamSetup(FILE *stream)
+{
+    if (stream->buffer != ZERO || stream->mode == _IONBF)
+    {
+        return 0;
+    }
+
+    stream->buffer = (char *) malloc(stream->size);
+    if (!stream->buffer)
+    {
+        errno = ENOMEM;
+        stream->error = true;
+        return EOF;
+    }
+
+    stream->allocated = true;
+    return 0;
+}
+
+int streamFlush(FILE *stream)
+{
+    int result = 0;
+
+    if (stream->writing)
+    {
+        Size written = 0;
+
+        while (written < stream->position)
+        {
+            const ssize_t num = write(stream->fd, stream->buffer + written,
+                                      stream->position - written);
+            if (num <= 0)
+            {
+                stream->error = true;
+                result = EOF;
+                break;
+            }
+            written += num;
+        }
+        stream->writing = false;
+    }
+    else if (stream->position < stream->count)
+    {
+        // Rewind the descriptor to the first unread byte
+        if (lseek(stream->fd, -(off_t) (stream->count - stream->position), SEEK_CUR) == -1)
+        {
+            stream->error = true;
+            result = EOF;
+        }
+    }
+
+    stream->position = 0;
+    stream->count = 0;
+    return result;
+}
+
+int streamFlushAll()
+{
+    int result = 0;
+
+    for (FILE *s = streams; s != ZERO; s = s->next)
+    {
+        if (streamFlush(s) != 0)
+        {
+            result = EOF;
+        }
+    }
+
+    return result;
+}
+
+ssize_t streamFill(FILE *stream)
+{
+    const ssize_t num = read(stream->fd, stream->buffer, stream->size);
+
+    stream->position = 0;
+    stream->count = num > 0 ? num : 0;
+
+    if (num < 0)
+    {
+        stream->error = true;
+    }
+    else if (num == 0)
+    {
+        stream->eof = true;
+    }
+
+    return num;
+}
+
+/**
+ * Write out pending output of all streams when the program terminates.
+ */
+static void __attribute__((destructor)) streamExit()
+{
+    streamFlushAll();
+}
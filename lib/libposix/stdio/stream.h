@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_STDIO_STREAM_H
+#define __LIBPOSIX_STDIO_STREAM_H
+
+#include <sys/types.h>
+#include "stdio.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Add a stream to the list of open streams.
+ *
+ * @param stream Newly opened stream.
+ */
+void streamRegister(FILE *stream);
+
+/**
+ * Remove a stream from the list of open streams.
+ *
+ * @param stream Stream being closed.
+ */
+void streamUnregister(FILE *stream);
+
+/**
+ * Allocate the stream buffer, unless unbuffered or already allocated.
+ *
+ * @param stream Stream to setup.
+ *
+ * @return Zero on success or EOF if out of memory.
+ */
+int streamSetup(FILE *stream);
+
+/**
+ * Write out pending output or discard unread input.
+ *
+ * Afterwards the buffer is empty and the file offset of the
+ * descriptor equals the position of the stream.
+ *
+ * @param stream Stream to flush.
+ *
+ * @return Zero on success or EOF if writing failed.
+ */
+int streamFlush(FILE *stream);
+
+/**
+ * Flush all open streams.
+ *
+ * @return Zero on success or EOF if any stream failed.
+ */
+int streamFlushAll();
+
+/**
+ * Read the next block of input into the stream buffer.
+ *
+ * @param stream Stream to fill.
+ *
+ * @return Number of bytes read, zero on end-of-file or -1 on error.
+ */
+ssize_t streamFill(FILE *stream);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_STDIO_STREAM_H */
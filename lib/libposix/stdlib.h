@@ -132,6 +132,40 @@ extern C void * malloc(size_t size);
  */
 extern C void free(void *ptr);
 
+/**
+ * @brief Memory reallocator
+ *
+ * The realloc() function shall deallocate the old object pointed to by ptr
+ * and return a pointer to a new object that has the size specified by size.
+ * The contents of the new object shall be the same as that of the old object
+ * prior to deallocation, up to the lesser of the new and old sizes. If ptr
+ * is a null pointer, realloc() shall be equivalent to malloc() for the
+ * specified size.
+ *
+ * @param ptr Previously allocated memory or a null pointer.
+ * @param size Number of bytes for the new object.
+ *
+ * @return Upon successful completion, realloc() shall return a pointer to
+ *         the (possibly moved) allocated space. If size is 0, the space is
+ *         freed and a null pointer is returned. Otherwise, it shall return
+ *         a null pointer and set errno to indicate the error, leaving the
+ *         old object unchanged.
+ */
+extern C void * realloc(void *ptr, size_t size);
+
+/**
+ * @brief Get the usable size of allocated memory
+ *
+ * This is a non-standard extension, compatible with GNU libc.
+ *
+ * @param ptr Previously allocated memory or a null pointer.
+ *
+ * @return Number of bytes which may be used at ptr, which is at least
+ *         the size requested when the memory was allocated. Zero if
+ *         ptr is a null pointer.
+ */
+extern C size_t malloc_usable_size(void *ptr);
+
 /**
  * @brief Random number generator
  *
@@ -16,10 +16,14 @@
  */
 
 #include <FreeNOS/User.h>
+#include "stdio.h"
 #include "stdlib.h"
 
 extern C void exit(int status)
 {
+    // Write out any buffered output
+    fflush(ZERO);
+
     // Request immediate termination
     ProcessCtl(SELF, KillPID, status);
 }
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/types.h>
+#include "stdlib.h"
+#include "errno.h"
+
+extern C void * realloc(void *ptr, size_t size)
+{
+    Allocator::Range range;
+
+    if (ptr == 0)
+    {
+        return malloc(size);
+    }
+    else if (size == 0)
+    {
+        free(ptr);
+        return 0;
+    }
+
+    range.address   = (Address) ptr;
+    range.size      = size;
+    range.alignment = 0;
+
+    if (Allocator::getDefault()->reallocate(range) != Allocator::Success)
+    {
+        errno = ENOMEM;
+        return 0;
+    }
+
+    return (void *) range.address;
+}
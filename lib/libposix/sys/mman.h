@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_SYS_MMAN_H
+#define __LIBPOSIX_SYS_MMAN_H
+
+#include <Macros.h>
+#include "types.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * @name Memory protection options
+ * @{
+ */
+
+/** Page cannot be accessed. */
+#define PROT_NONE       0
+
+/** Page can be read. */
+#define PROT_READ       (1 << 0)
+
+/** Page can be written. */
+#define PROT_WRITE      (1 << 1)
+
+/** Page can be executed. */
+#define PROT_EXEC       (1 << 2)
+
+/**
+ * @}
+ */
+
+/**
+ * @name Memory mapping flags
+ * @{
+ */
+
+/** Share changes. */
+#define MAP_SHARED      (1 << 0)
+
+/** Changes are private. */
+#define MAP_PRIVATE     (1 << 1)
+
+/** Interpret addr exactly. */
+#define MAP_FIXED       (1 << 2)
+
+/**
+ * @}
+ */
+
+/** Returned by mmap() on failure. */
+#define MAP_FAILED      ((void *) -1)
+
+/**
+ * @brief Map pages of memory.
+ *
+ * The mmap() function shall establish a mapping between an address space
+ * of a process and a file. Read-only mappings are mapped directly from
+ * the pages of the file system, if the file system supports it. Otherwise,
+ * the file contents are copied into private pages.
+ *
+ * @param addr Hint for the address of the mapping (ignored).
+ * @param len Number of bytes to map.
+ * @param prot Memory protection options, see PROT_READ, PROT_WRITE, PROT_EXEC.
+ * @param flags Either MAP_SHARED or MAP_PRIVATE.
+ * @param fildes File descriptor of the file to map.
+ * @param off Page aligned offset in the file to start mapping.
+ *
+ * @return Upon successful completion, the mmap() function shall return the
+ *         address at which the mapping was placed. Otherwise, it shall return
+ *         a value of MAP_FAILED and set errno to indicate the error.
+ *
+ * @note Shared writable mappings are not supported.
+ */
+extern C void *mmap(void *addr, size_t len, int prot, int flags, int fildes, off_t off);
+
+/**
+ * @brief Unmap pages of memory.
+ *
+ * The munmap() function shall remove any mappings for those entire pages
+ * containing any part of the address space of the process starting
+ * at addr and continuing for len bytes.
+ *
+ * @param addr Address of the mapping, as returned by mmap().
+ * @param len Number of bytes to unmap.
+ *
+ * @return Upon successful completion, munmap() shall return 0; otherwise,
+ *         it shall return -1 and set errno to indicate the error.
+ */
+extern C int munmap(void *addr, size_t len);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_SYS_MMAN_H */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <FileSystemClient.h>
+#include <MemoryBlock.h>
+#include "errno.h"
+#include "unistd.h"
+#include "sys/mman.h"
+
+void *mmap(void *addr, size_t len, int prot, int flags, int fildes, off_t off)
+{
+    const FileSystemClient filesystem;
+    Memory::Range range;
+
+    // Validate arguments
+    if (len == 0 || off < 0 || (off & ~PAGEMASK) ||
+        (flags & MAP_FIXED) || !(flags & (MAP_SHARED | MAP_PRIVATE)))
+    {
+        errno = EINVAL;
+        return MAP_FAILED;
+    }
+
+    range.size = len;
+    if (range.size & ~PAGEMASK)
+    {
+        range.size += PAGESIZE - (range.size & ~PAGEMASK);
+    }
+
+    // Try to map the pages of the file system directly, if read-only
+    if (!(prot & PROT_WRITE))
+    {
+        range.virt   = ZERO;
+        range.phys   = ZERO;
+        range.access = Memory::User | Memory::Readable;
+
+        // Reserve the virtual range first, such that no other mapping can take it
+        if (VMCtl(SELF, MapLazy, &range) == API::Success)
+        {
+            if (filesystem.mapFile(fildes, range.virt, range.size, off) == FileSystem::Success)
+            {
+                return (void *) range.virt;
+            }
+
+            // Release the reservation, including any file pages mapped so far
+            VMCtl(SELF, Release, &range);
+        }
+    }
+
+    // Writes in shared mappings cannot be propagated to the file
+    if ((prot & PROT_WRITE) && (flags & MAP_SHARED))
+    {
+        errno = ENOTSUP;
+        return MAP_FAILED;
+    }
+
+    // Fallback to a private copy of the file contents
+    range.virt   = ZERO;
+    range.phys   = ZERO;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    if (prot & PROT_EXEC)
+    {
+        range.access = (Memory::Access) (range.access | Memory::Executable);
+    }
+
+    if (VMCtl(SELF, MapSparse, &range) != API::Success)
+    {
+        errno = ENOMEM;
+        return MAP_FAILED;
+    }
+
+    // Read the file contents
+    const ssize_t bytes = pread(fildes, (void *) range.virt, len, off);
+    if (bytes < 0)
+    {
+        // errno is set by pread()
+        VMCtl(SELF, Release, &range);
+        return MAP_FAILED;
+    }
+
+    // Remainder of the mapping past end of file is zero
+    MemoryBlock::set((void *) (range.virt + bytes), 0, range.size - bytes);
+    return (void *) range.virt;
+}
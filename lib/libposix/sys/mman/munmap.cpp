@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/System.h>
+#include "errno.h"
+#include "sys/mman.h"
+
+int munmap(void *addr, size_t len)
+{
+    Memory::Range range;
+
+    if (len == 0 || ((Address) addr & ~PAGEMASK))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    range.virt = (Address) addr;
+    range.size = len;
+    if (range.size & ~PAGEMASK)
+    {
+        range.size += PAGESIZE - (range.size & ~PAGEMASK);
+    }
+
+    // File system pages hold a reference, which is dropped on release
+    if (VMCtl(SELF, Release, &range) != API::Success)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    return 0;
+}
@@ -20,6 +20,7 @@
 
 #include <Macros.h>
 #include "types.h"
+#include "uio.h"
 
 /**
  * @addtogroup lib
@@ -38,15 +39,6 @@ struct sockaddr
     u16 port;
 };
 
-/**
- * Input/Output vector for multi-packet operations
- */
-struct iovec
-{
-    void *iov_base;
-    size_t iov_len;
-};
-
 typedef Size socklen_t;
 
 /**
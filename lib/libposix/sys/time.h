@@ -15,8 +15,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef __LIB_LIBPOSIX_TIME_H
-#define __LIB_LIBPOSIX_TIME_H
+#ifndef __LIB_LIBPOSIX_SYS_TIME_H
+#define __LIB_LIBPOSIX_SYS_TIME_H
 
 #include <Macros.h>
 #include "types.h"
@@ -68,4 +68,4 @@ extern C int gettimeofday(struct timeval *tv, struct timezone *tz);
  * @}
  */
 
-#endif /* __LIB_LIBPOSIX_TIME_H */
+#endif /* __LIB_LIBPOSIX_SYS_TIME_H */
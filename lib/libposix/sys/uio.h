@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LIBPOSIX_SYS_UIO_H
+#define __LIBPOSIX_SYS_UIO_H
+
+#include <Macros.h>
+#include "types.h"
+
+/**
+ * @addtogroup lib
+ * @{
+ *
+ * @addtogroup libposix
+ * @{
+ */
+
+/**
+ * Input/Output vector for multi-buffer operations
+ */
+struct iovec
+{
+    void *iov_base;
+    size_t iov_len;
+};
+
+/**
+ * @brief Read a vector.
+ *
+ * The readv() function shall be equivalent to read(), except that it
+ * places the input data into the iovcnt buffers specified by the members
+ * of the iov array: iov[0], iov[1], ..., iov[iovcnt-1]. Each buffer is
+ * filled completely before proceeding to the next.
+ *
+ * @param fildes File descriptor.
+ * @param iov Array of buffers to fill. The sum of the buffer sizes
+ *            must not exceed FileSystem::MaximumIOVectorSize.
+ * @param iovcnt Number of entries in the iov array. Must be in the range 1 to {IOV_MAX}.
+ *
+ * @return Upon successful completion, readv() shall return the number of
+ *         bytes actually read. Otherwise, -1 shall be returned and errno set
+ *         to indicate the error.
+ */
+extern C ssize_t readv(int fildes, const struct iovec *iov, int iovcnt);
+
+/**
+ * @brief Write a vector.
+ *
+ * The writev() function shall be equivalent to write(), except that it
+ * gathers the output data from the iovcnt buffers specified by the members
+ * of the iov array: iov[0], iov[1], ..., iov[iovcnt-1].
+ *
+ * @param fildes File descriptor.
+ * @param iov Array of buffers to write. The sum of the buffer sizes
+ *            must not exceed FileSystem::MaximumIOVectorSize.
+ * @param iovcnt Number of entries in the iov array. Must be in the range 1 to {IOV_MAX}.
+ *
+ * @return Upon successful completion, writev() shall return the number of
+ *         bytes actually written. Otherwise, -1 shall be returned and errno set
+ *         to indicate the error.
+ */
+extern C ssize_t writev(int fildes, const struct iovec *iov, int iovcnt);
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __LIBPOSIX_SYS_UIO_H */
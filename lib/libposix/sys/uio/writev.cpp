@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FileSystemClient.h>
+#include "errno.h"
+#include "limits.h"
+#include "sys/uio.h"
+
+ssize_t writev(int fildes, const struct iovec *iov, int iovcnt)
+{
+    FileSystem::IOVector vec[IOV_MAX];
+    Size requested = 0, total = 0;
+
+    if (iovcnt <= 0 || iovcnt > (int) IOV_MAX)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Convert to I/O vectors for the file system
+    for (int i = 0; i < iovcnt; i++)
+    {
+        vec[i].address = (Address) iov[i].iov_base;
+        vec[i].size    = iov[i].iov_len;
+
+        // The total size is limited by the file system
+        if (vec[i].size > FileSystem::MaximumIOVectorSize - requested)
+        {
+            errno = EINVAL;
+            return -1;
+        }
+        requested += vec[i].size;
+    }
+
+    // Write all buffers using a single request
+    const FileSystemClient filesystem;
+    const FileSystem::Result result = filesystem.writeFileVector(fildes, vec, iovcnt, &total);
+
+    // Did the write succeed?
+    if (result != FileSystem::Success)
+    {
+        errno = result == FileSystem::InvalidArgument ? EINVAL : ENOENT;
+        return -1;
+    }
+
+    return total;
+}
@@ -96,6 +96,56 @@ extern C ssize_t read(int fildes, void *buf, size_t nbyte);
  */
 extern C ssize_t write(int fildes, const void *buf, size_t nbyte);
 
+/**
+ * @brief Read from a file at a given offset.
+ *
+ * The pread() function shall be equivalent to read(), except that it
+ * shall read from a given position in the file without changing the
+ * file pointer.
+ *
+ * @param fildes File descriptor.
+ * @param buf Output buffer.
+ * @param nbyte Maximum number of bytes to read.
+ * @param offset Position in the file to start reading.
+ *
+ * @return Upon successful completion, pread() shall return a non-negative
+ *         integer indicating the number of bytes actually read. Otherwise,
+ *         -1 shall be returned and errno set to indicate the error.
+ */
+extern C ssize_t pread(int fildes, void *buf, size_t nbyte, off_t offset);
+
+/**
+ * @brief Write on a file at a given offset.
+ *
+ * The pwrite() function shall be equivalent to write(), except that it
+ * writes into a given position in the file without changing the file pointer.
+ *
+ * @param fildes File descriptor.
+ * @param buf Input buffer.
+ * @param nbyte Maximum number of bytes to write.
+ * @param offset Position in the file to start writing.
+ *
+ * @return Upon successful completion, pwrite() shall return the number
+ *         of bytes actually written. Otherwise, -1 shall be returned and
+ *         errno set to indicate the error.
+ */
+extern C ssize_t pwrite(int fildes, const void *buf, size_t nbyte, off_t offset);
+
+/**
+ * @brief Truncate a file to a specified length.
+ *
+ * If the file previously was larger than length, the extra data is discarded.
+ * If the file was previously shorter than length, its size is increased and
+ * the extended area appears as if it were zero-filled.
+ *
+ * @param fildes File descriptor.
+ * @param length New length of the file in bytes.
+ *
+ * @return Upon successful completion, ftruncate() shall return 0; otherwise,
+ *         -1 shall be returned and errno set to indicate the error.
+ */
+extern C int ftruncate(int fildes, off_t length);
+
 /**
  * Close a file descriptor
  *
@@ -117,6 +167,8 @@ extern C int close(int fildes);
  * If whence is SEEK_CUR, the file offset shall be set to its current location plus offset.
  * If whence is SEEK_END, the file offset shall be set to the size of the file plus offset.
  *
+ * @note SEEK_END is not supported and fails with EINVAL.
+ *
  * @param fildes File descriptor.
  * @param offset New file offset.
  * @param whence Determines how to modify the file offset pointer.
@@ -128,6 +180,22 @@ extern C int close(int fildes);
  */
 extern C off_t lseek(int fildes, off_t offset, int whence);
 
+/**
+ * @brief Create a new process.
+ *
+ * The new process is a copy of the calling process. Memory is
+ * shared copy-on-write, such that pages are only copied when
+ * written to by either process. Shared memory channels of the
+ * calling process are not inherited.
+ *
+ * @return Upon successful completion, fork() shall return 0 to the child
+ *         process and shall return the process ID of the child process to
+ *         the parent process. Otherwise, -1 shall be returned to the parent
+ *         process, no child process shall be created, and errno shall be
+ *         set to indicate the error.
+ */
+extern C pid_t fork();
+
 /**
  * @brief Create a new process and execute program.
  *
@@ -151,6 +219,26 @@ extern C int forkexec(const char *path, const char *argv[]);
  */
 extern C int spawn(Address program, Size programSize, const char *argv[]);
 
+#ifdef __cplusplus
+
+/** Forward declaration */
+class ProgramImage;
+
+/**
+ * @brief Create a new process using a parsed program image.
+ *
+ * @param image Decompressed and parsed program
+ * @param argv Argument list pointer.
+ *
+ * @return New process ID on success and -1 on failure.
+ * @note  Errno is set with the appropriate error code on failure.
+ *
+ * @see ProgramImageCache
+ */
+extern int spawnImage(const ProgramImage *image, const char *argv[]);
+
+#endif /* __cplusplus */
+
 /**
  * @brief Get name of current host.
  *
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <ChannelClient.h>
+#include <ProcessClient.h>
+#include "unistd.h"
+#include "errno.h"
+
+pid_t fork()
+{
+    const API::Result result = ProcessCtl(SELF, Clone);
+
+    switch (result & 0xffff)
+    {
+        case API::Success:
+            break;
+
+        case API::IOError:
+            errno = EAGAIN;
+            return (pid_t) -1;
+
+        default:
+            errno = EIO;
+            return (pid_t) -1;
+    }
+
+    const pid_t pid = (pid_t) (result >> 16);
+
+    // The child must not use the identity and channels of the parent
+    if (pid == 0)
+    {
+        ProcessClient::refresh();
+        ChannelClient::instance()->reset();
+    }
+
+    return pid;
+}
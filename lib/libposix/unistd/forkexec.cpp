@@ -16,7 +16,8 @@
  */
 
 #include <FreeNOS/User.h>
-#include <Lz4Decompressor.h>
+#include <ProgramImage.h>
+#include <ProgramImageCache.h>
 #include <Types.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -26,6 +27,7 @@
 
 int forkexec(const char *path, const char *argv[])
 {
+    ProgramImageCache *cache = ProgramImageCache::instance();
     int fd, ret = 0;
     struct stat st;
 
@@ -33,6 +35,13 @@ int forkexec(const char *path, const char *argv[])
     if (stat(path, &st) != 0)
         return -1;
 
+    // Spawn directly from the cache if the program is unchanged
+    const ProgramImage *cached = cache->lookup(path, st.st_ino, st.st_size);
+    if (cached != ZERO)
+    {
+        return spawnImage(cached, argv);
+    }
+
     // Open program image
     if ((fd = open(path, O_RDONLY)) < 0)
         return -1;
@@ -47,6 +56,7 @@ int forkexec(const char *path, const char *argv[])
     // Create mapping
     if (VMCtl(SELF, MapContiguous, &compressed) != API::Success)
     {
+        close(fd);
         errno = EFAULT;
         return -1;
     }
@@ -64,58 +74,21 @@ int forkexec(const char *path, const char *argv[])
         return -1;
     }
 
-    // Initialize decompressor
-    Lz4Decompressor lz4((const void *)compressed.virt, st.st_size);
-    const Lz4Decompressor::Result result = lz4.initialize();
-    if (result != Lz4Decompressor::Success)
-    {
-        VMCtl(SELF, Release, &compressed);
-        errno = EFAULT;
-        return -1;
-    }
-
-    // Map memory buffer for the uncompressed program image
-    Memory::Range uncompressed;
-    uncompressed.virt   = ZERO;
-    uncompressed.phys   = ZERO;
-    uncompressed.size   = lz4.getUncompressedSize();
-    uncompressed.access = Memory::User|Memory::Readable|Memory::Writable;
-
-    // Create mapping
-    if (VMCtl(SELF, MapContiguous, &uncompressed) != API::Success)
-    {
-        VMCtl(SELF, Release, &compressed);
-        errno = EFAULT;
-        return -1;
-    }
-
-    // Decompress entire file
-    const Lz4Decompressor::Result readResult = lz4.read((void *)uncompressed.virt, lz4.getUncompressedSize());
-    if (readResult != Lz4Decompressor::Success)
-    {
-        VMCtl(SELF, Release, &compressed);
-        VMCtl(SELF, Release, &uncompressed);
-        errno = EFAULT;
-        return -1;
-    }
+    // Decompress and parse the program
+    ProgramImage *image = new ProgramImage();
+    const ProgramImage::Result result = image->load((const u8 *) compressed.virt, st.st_size);
 
     // Cleanup compressed program buffer
-    if (VMCtl(SELF, Release, &compressed) != API::Success)
+    if (VMCtl(SELF, Release, &compressed) != API::Success || result != ProgramImage::Success)
     {
-        VMCtl(SELF, Release, &uncompressed);
-        errno = EFAULT;
+        delete image;
+        errno = result == ProgramImage::InvalidFormat ? ENOEXEC : EFAULT;
         return -1;
     }
 
-    // Spawn the new program
-    ret = spawn(uncompressed.virt, lz4.getUncompressedSize(), argv);
+    // Keep the parsed program for the next spawn
+    cache->insert(path, st.st_ino, st.st_size, image);
 
-    // Cleanup uncompressed program buffer
-    if (VMCtl(SELF, Release, &uncompressed) != API::Success)
-    {
-        errno = EFAULT;
-        return -1;
-    }
-
-    return ret;
+    // Spawn the new program
+    return spawnImage(image, argv);
 }
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FileSystemClient.h>
+#include "errno.h"
+#include "unistd.h"
+
+int ftruncate(int fildes, off_t length)
+{
+    if (length < 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    const FileSystemClient filesystem;
+    const FileSystem::Result result = filesystem.truncateFile(fildes, length);
+
+    switch (result)
+    {
+        case FileSystem::Success:
+            return 0;
+
+        case FileSystem::NotFound:
+            errno = EBADF;
+            break;
+
+        case FileSystem::NotSupported:
+            errno = EINVAL;
+            break;
+
+        default:
+            errno = EIO;
+            break;
+    }
+
+    return -1;
+}
@@ -18,6 +18,7 @@
 #include <FileDescriptor.h>
 #include "errno.h"
 #include "unistd.h"
+#include "stdio.h"
 
 off_t lseek(int fildes, off_t offset, int whence)
 {
@@ -29,9 +30,34 @@ off_t lseek(int fildes, off_t offset, int whence)
         return -1;
     }
 
+    // Compute the new file position
+    off_t position;
+
+    switch (whence)
+    {
+        case SEEK_SET:
+            position = offset;
+            break;
+
+        case SEEK_CUR:
+            position = fd->position + offset;
+            break;
+
+        // The size of the file is not known here
+        default:
+            errno = EINVAL;
+            return -1;
+    }
+
+    if (position < 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
     // Update the file position pointer
-    fd->position = offset;
+    fd->position = position;
 
     // Done
-    return 0;
+    return position;
 }
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FileSystemClient.h>
+#include "errno.h"
+#include "unistd.h"
+
+ssize_t pread(int fildes, void *buf, size_t nbyte, off_t offset)
+{
+    if (offset < 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Read the file at the given offset
+    const FileSystemClient filesystem;
+    const FileSystem::Result result = filesystem.readFile(fildes,
+                                                         (char *)buf,
+                                                          &nbyte,
+                                                          offset);
+    // Did the read succeed?
+    if (result != FileSystem::Success)
+    {
+        errno = result == FileSystem::InvalidArgument ? EINVAL : ENOENT;
+        return -1;
+    }
+
+    return nbyte;
+}
@@ -19,6 +19,7 @@
 #include <FileSystemClient.h>
 #include <FileDescriptor.h>
 #include <ExecutableFormat.h>
+#include <ProgramImage.h>
 #include <Types.h>
 #include <Runtime.h>
 #include "limits.h"
@@ -26,57 +27,60 @@
 #include "errno.h"
 #include "unistd.h"
 
-int spawn(Address program, Size programSize, const char *argv[])
+/**
+ * Create a new process and load the given memory regions into it.
+ *
+ * @param program Base address for the region data offsets
+ * @param entry Program entry point
+ * @param regions Memory regions of the program
+ * @param numRegions Number of memory regions
+ * @param shared Optional pages to map shared per region, or ZERO to copy all regions
+ * @param argv Argument list pointer
+ *
+ * @return New process ID on success and -1 on failure
+ */
+static int spawnRegions(Address program,
+                        Address entry,
+                        const ExecutableFormat::Region *regions,
+                        Size numRegions,
+                        const Memory::Range *shared,
+                        const char *argv[])
 {
     const FileSystemClient filesystem;
-    ExecutableFormat *fmt;
-    ExecutableFormat::Region regions[16];
     Arch::MemoryMap map;
     Memory::Range range;
     uint count = 0;
     pid_t pid = 0;
-    Size numRegions = 16;
-    Address entry;
-
-    // Attempt to read executable format
-    if (ExecutableFormat::find((u8 *) program, programSize, &fmt) != ExecutableFormat::Success)
-    {
-        errno = ENOEXEC;
-        return -1;
-    }
-
-    // Find entry point
-    if (fmt->entry(&entry) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        errno = ENOEXEC;
-        return -1;
-    }
 
     // Create new process
     const ulong result = ProcessCtl(ANY, Spawn, entry);
     if ((result & 0xffff) != API::Success)
     {
-        delete fmt;
         errno = EIO;
         return -1;
     }
     pid = (result >> 16);
 
-    // Retrieve memory regions
-    if (fmt->regions(regions, &numRegions) != ExecutableFormat::Success)
-    {
-        delete fmt;
-        errno = ENOEXEC;
-        ProcessCtl(pid, KillPID);
-        return -1;
-    }
-    // Release buffers
-    delete fmt;
-
     // Map program regions into virtual memory of the new process
     for (Size i = 0; i < numRegions; i++)
     {
+        // Map prepared read-only pages shared with other instances
+        if (shared != ZERO && shared[i].size != 0)
+        {
+            range.virt   = regions[i].virt & PAGEMASK;
+            range.phys   = shared[i].phys;
+            range.size   = shared[i].size;
+            range.access = regions[i].access;
+
+            if (VMCtl(pid, MapShared, &range) != API::Success)
+            {
+                errno = EFAULT;
+                ProcessCtl(pid, KillPID);
+                return -1;
+            }
+            continue;
+        }
+
         // Setup memory range to copy region data
         range.virt   = regions[i].virt;
         range.phys   = ZERO;
@@ -92,7 +96,8 @@ int spawn(Address program, Size programSize, const char *argv[])
         }
 
         // Map inside our process
-        range.virt = ZERO;
+        range.virt   = ZERO;
+        range.access = Memory::User | Memory::Readable | Memory::Writable;
         if (VMCtl(SELF, MapContiguous, &range) != API::Success)
         {
             errno = EFAULT;
@@ -177,3 +182,38 @@ int spawn(Address program, Size programSize, const char *argv[])
     delete[] arguments;
     return pid;
 }
+
+int spawn(Address program, Size programSize, const char *argv[])
+{
+    ExecutableFormat *fmt;
+    ExecutableFormat::Region regions[16];
+    Size numRegions = 16;
+    Address entry;
+
+    // Attempt to read executable format
+    if (ExecutableFormat::find((u8 *) program, programSize, &fmt) != ExecutableFormat::Success)
+    {
+        errno = ENOEXEC;
+        return -1;
+    }
+
+    // Find entry point and memory regions
+    if (fmt->entry(&entry) != ExecutableFormat::Success ||
+        fmt->regions(regions, &numRegions) != ExecutableFormat::Success)
+    {
+        delete fmt;
+        errno = ENOEXEC;
+        return -1;
+    }
+    // Release buffers
+    delete fmt;
+
+    return spawnRegions(program, entry, regions, numRegions, ZERO, argv);
+}
+
+int spawnImage(const ProgramImage *image, const char *argv[])
+{
+    return spawnRegions((Address) image->data(), image->entry(),
+                        image->regions(), image->regionCount(),
+                        image->sharedPages(), argv);
+}
@@ -20,9 +20,15 @@
 #include <Macros.h>
 #include "ProcessClient.h"
 
-const ProcessID ProcessClient::m_pid = ProcessCtl(SELF, GetPID, 0);
+ProcessID ProcessClient::m_pid = ProcessCtl(SELF, GetPID, 0);
 
-const ProcessID ProcessClient::m_parent = ProcessCtl(SELF, GetParent, 0);
+ProcessID ProcessClient::m_parent = ProcessCtl(SELF, GetParent, 0);
+
+void ProcessClient::refresh()
+{
+    m_pid = ProcessCtl(SELF, GetPID, 0);
+    m_parent = ProcessCtl(SELF, GetParent, 0);
+}
 
 ProcessID ProcessClient::getProcessID() const
 {
@@ -73,6 +79,27 @@ ProcessClient::Result ProcessClient::processInfo(const ProcessID pid,
     return Success;
 }
 
+ProcessClient::Result ProcessClient::memoryUsage(const ProcessID pid,
+                                                 MemoryContext::Usage &usage) const
+{
+#ifndef __HOST__
+    ProcessInfo info;
+
+    const API::Result result = ProcessCtl(pid, InfoPID, (Address) &info, (Address) &usage);
+    switch (result)
+    {
+        case API::Success:
+            break;
+        case API::NotFound:
+            return NotFound;
+        default:
+            return IOError;
+    }
+#endif /* __HOST__ */
+
+    return Success;
+}
+
 ProcessClient::Result ProcessClient::processInfo(const String program,
                                                  ProcessClient::Info &info) const
 {
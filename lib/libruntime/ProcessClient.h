@@ -20,6 +20,7 @@
 
 #include <FreeNOS/User.h>
 #include <FreeNOS/ProcessManager.h>
+#include <MemoryContext.h>
 #include <Types.h>
 #include <String.h>
 
@@ -95,6 +96,16 @@ class ProcessClient
      */
     Result processInfo(const ProcessID pid, Info &info) const;
 
+    /**
+     * Get physical memory usage of a process by its ID.
+     *
+     * @param pid Process identifier of the process.
+     * @param usage Memory usage output
+     *
+     * @return Result code
+     */
+    Result memoryUsage(const ProcessID pid, MemoryContext::Usage &usage) const;
+
     /**
      * Get process information by its program name
      *
@@ -121,13 +132,21 @@ class ProcessClient
      */
     ProcessID findProcess(const String program) const;
 
+    /**
+     * Reload the cached process identifiers.
+     *
+     * Must be called by a cloned process, which inherits
+     * the identifiers of its parent.
+     */
+    static void refresh();
+
   private:
 
     /** Our own process identifier */
-    static const ProcessID m_pid;
+    static ProcessID m_pid;
 
     /** Our parent process identifier */
-    static const ProcessID m_parent;
+    static ProcessID m_parent;
 };
 
 /**
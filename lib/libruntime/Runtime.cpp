@@ -16,11 +16,13 @@
  */
 
 #include <FreeNOS/System.h>
+#include <FreeNOS/Config.h>
 #include <Types.h>
 #include <Macros.h>
 #include <Array.h>
 #include <FileSystemClient.h>
 #include <PoolAllocator.h>
+#include <SlabAllocator.h>
 #include <FileSystemMount.h>
 #include <FileDescriptor.h>
 #include <MemoryMap.h>
@@ -104,7 +106,7 @@ void setupHeap()
     Arch::MemoryMap map;
     Memory::Range heap = map.range(MemoryMap::UserHeap);
     PageAllocator *pageAlloc;
-    PoolAllocator *poolAlloc;
+    Allocator *poolAlloc;
     const Allocator::Range pageRange = { heap.virt, heap.size, PAGESIZE };
 
     // Allocate one page to store the allocators themselves
@@ -122,7 +124,11 @@ void setupHeap()
 
     // Allocate instance copy on vm pages itself
     pageAlloc = new (heap.virt) PageAllocator(pageRange);
+#if SLAB_HEAP
+    poolAlloc = new (heap.virt + sizeof(PageAllocator)) SlabAllocator(pageAlloc);
+#else
     poolAlloc = new (heap.virt + sizeof(PageAllocator)) PoolAllocator(pageAlloc);
+#endif /* SLAB_HEAP */
 
     // Set default allocator
     Allocator::setDefault(poolAlloc);
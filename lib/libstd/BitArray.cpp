@@ -22,6 +22,7 @@
 BitArray::BitArray(const Size bitCount, u8 *array)
 {
     m_array = array ? array : new u8[calculateBitmapSize(bitCount)];
+    m_summary = array ? ZERO : new u32[calculateSummarySize(bitCount)];
     m_allocated = (array == ZERO);
     m_bitCount  = bitCount;
     m_set = 0;
@@ -34,6 +35,7 @@ BitArray::~BitArray()
     if (m_allocated)
     {
         delete[] m_array;
+        delete[] m_summary;
     }
 }
 
@@ -71,6 +73,7 @@ void BitArray::set(const Size bit, const bool value)
             m_array[bit / 8] &= ~(1 << (bit % 8));
             m_set--;
         }
+        updateSummary(bit / WordBits);
     }
 }
 
@@ -88,9 +91,29 @@ bool BitArray::isSet(const Size bit) const
 
 void BitArray::setRange(const Size from, const Size to)
 {
-    for (Size i = from; i <= to; i++)
+    if (m_bitCount == 0)
     {
-        set(i, true);
+        return;
+    }
+
+    const Size last = to < m_bitCount ? to : m_bitCount - 1;
+
+    for (Size i = from; i <= last;)
+    {
+        // Fill a whole unset word at once
+        if ((i % WordBits) == 0 && i + WordBits - 1 <= last &&
+            ((u32 *) m_array)[i / WordBits] == 0)
+        {
+            ((u32 *) m_array)[i / WordBits] = ~0U;
+            m_set += WordBits;
+            updateSummary(i / WordBits);
+            i += WordBits;
+        }
+        else
+        {
+            set(i, true);
+            i++;
+        }
     }
 }
 
@@ -99,64 +122,36 @@ BitArray::Result BitArray::setNext(Size *bit,
                                    const Size start,
                                    const Size boundary)
 {
-    Size from = 0, found = 0;
+    const Size num = count ? count : 1;
+    Size i = start;
 
     // Loop BitArray for unset bits
-    for (Size i = start; i < m_bitCount;)
+    while (findUnset(i, &i))
     {
-        // Try to fast-forward 32 bits to search
-        if (m_bitCount > 32 && i < m_bitCount - 32 && ((u32 *)m_array)[i / 32] == 0xffffffff)
+        // Move up to the requested boundary
+        if (i % boundary)
         {
-            from = found = 0;
-
-            if (i & 31)
-                i += (32 - (i % 32));
-            else
-                i += 32;
+            i += boundary - (i % boundary);
             continue;
         }
-        // Try to fast-forward 8 bits to search
-        else if (m_bitCount > 8 && i < m_bitCount - 8 && m_array[i / 8] == 0xff)
-        {
-            from = found = 0;
 
-            if (i & 7)
-                i += (8 - (i % 8));
-            else
-                i += 8;
-            continue;
-        }
-        else if (!isSet(i))
+        // Are there enough bits left?
+        if (num > m_bitCount - i)
         {
-            // Remember this bit
-            if (!found)
-            {
-                if (!(i % boundary))
-                {
-                    from  = i;
-                    found = 1;
-                }
-            }
-            else
-            {
-                found++;
-            }
-
-            // Are there enough contigious bits?
-            if (found >= count)
-            {
-                setRange(from, i);
-                *bit = from;
-                return Success;
-            }
+            break;
         }
-        else
+
+        // Are there enough contigious bits?
+        const Size end = findSet(i, i + num);
+        if (end == i + num)
         {
-            from = found = 0;
+            setRange(i, end - 1);
+            *bit = i;
+            return Success;
         }
 
-        // Move to the next bit
-        i++;
+        // Continue after the set bit
+        i = end + 1;
     }
     // No unset bits left!
     return OutOfMemory;
@@ -179,10 +174,12 @@ void BitArray::setArray(u8 *map, const Size bitCount)
     if (m_array && m_allocated)
     {
         delete[] m_array;
+        delete[] m_summary;
     }
 
     // Reassign to the new map
     m_array = map;
+    m_summary = ZERO;
     m_allocated = false;
     m_set   = 0;
 
@@ -201,6 +198,11 @@ void BitArray::clear()
     // Zero it
     MemoryBlock::set(m_array, 0, calculateBitmapSize(m_bitCount));
 
+    if (m_summary)
+    {
+        MemoryBlock::set(m_summary, 0, calculateSummarySize(m_bitCount) * sizeof(u32));
+    }
+
     // Reset set count
     m_set = 0;
 }
@@ -224,3 +226,129 @@ inline Size BitArray::calculateBitmapSize(const Size bitCount) const
     else
         return bytes;
 }
+
+inline Size BitArray::calculateSummarySize(const Size bitCount) const
+{
+    const Size words = (bitCount + WordBits - 1) / WordBits;
+
+    return (words + WordBits - 1) / WordBits;
+}
+
+u32 BitArray::readWord(const Size word) const
+{
+    const Size first = word * WordBits;
+    u32 value = ~0U;
+
+    if (first + WordBits <= m_bitCount)
+    {
+        return ((const u32 *) m_array)[word];
+    }
+
+    // The last word may be partially used
+    for (Size i = first; i < m_bitCount; i++)
+    {
+        if (!isSet(i))
+        {
+            value &= ~(1U << (i - first));
+        }
+    }
+
+    return value;
+}
+
+void BitArray::updateSummary(const Size word)
+{
+    if (m_summary)
+    {
+        if (readWord(word) == ~0U)
+            m_summary[word / WordBits] |= (1U << (word % WordBits));
+        else
+            m_summary[word / WordBits] &= ~(1U << (word % WordBits));
+    }
+}
+
+Size BitArray::nextFreeWord(const Size word) const
+{
+    const Size words = (m_bitCount + WordBits - 1) / WordBits;
+    Size i = word;
+
+    // Without summary, check each word
+    if (!m_summary)
+    {
+        while (i < words && readWord(i) == ~0U)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    // Find a zero bit in the summary
+    const Size summaryWords = calculateSummarySize(m_bitCount);
+    Size s = i / WordBits;
+
+    if (s >= summaryWords)
+    {
+        return words;
+    }
+
+    u32 free = ~m_summary[s] & ~((1U << (i % WordBits)) - 1);
+
+    while (free == 0)
+    {
+        if (++s >= summaryWords)
+        {
+            return words;
+        }
+        free = ~m_summary[s];
+    }
+
+    return (s * WordBits) + __builtin_ctz(free);
+}
+
+bool BitArray::findUnset(const Size from, Size *bit) const
+{
+    const Size words = (m_bitCount + WordBits - 1) / WordBits;
+    Size word = from / WordBits;
+
+    if (from >= m_bitCount)
+    {
+        return false;
+    }
+
+    // Ignore the bits before the starting bit
+    u32 free = ~readWord(word) & ~((1U << (from % WordBits)) - 1);
+
+    while (free == 0)
+    {
+        word = nextFreeWord(word + 1);
+
+        if (word >= words)
+        {
+            return false;
+        }
+        free = ~readWord(word);
+    }
+
+    *bit = (word * WordBits) + __builtin_ctz(free);
+    return true;
+}
+
+Size BitArray::findSet(const Size from, const Size to) const
+{
+    Size word = from / WordBits;
+
+    // Ignore the bits before the starting bit
+    u32 used = readWord(word) & ~((1U << (from % WordBits)) - 1);
+
+    while (used == 0)
+    {
+        if (++word * WordBits >= to)
+        {
+            return to;
+        }
+        used = readWord(word);
+    }
+
+    const Size bit = (word * WordBits) + __builtin_ctz(used);
+    return bit < to ? bit : to;
+}
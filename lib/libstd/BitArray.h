@@ -32,9 +32,18 @@
 
 /**
  * Represents an array of bits.
+ *
+ * The bits are searched one 32-bit word at a time. When the BitArray
+ * allocates its own array, it also keeps a summary bitmap with one bit per
+ * word that is fully set, such that full words are skipped 32 at a time.
  */
 class BitArray
 {
+  private:
+
+    /** Number of bits in a word of the array and the summary. */
+    static const Size WordBits = 32;
+
   public:
 
     /**
@@ -54,6 +63,7 @@ class BitArray
      *
      * @param bitCount Number of bits to manage.
      * @param array Optional pointer to pre-allocated bits array to manage.
+     *              No summary bitmap is kept for a pre-allocated array.
      */
     BitArray(const Size bitCount, u8 *array = ZERO);
 
@@ -140,6 +150,8 @@ class BitArray
     /**
      * Use the given pointer as the BitArray buffer.
      *
+     * This also drops the summary bitmap, if any.
+     *
      * @param array New bits array pointer.
      * @param bitCount New number of bits. ZERO to keep the old value.
      */
@@ -174,6 +186,60 @@ class BitArray
      */
     Size calculateBitmapSize(const Size bitCount) const;
 
+    /**
+     * Calculate required number of words in the summary bitmap.
+     *
+     * @param bitCount Number of bits in the array.
+     *
+     * @return Size of the summary in words
+     */
+    Size calculateSummarySize(const Size bitCount) const;
+
+    /**
+     * Read a word of bits from the array.
+     *
+     * @param word Word number to read.
+     *
+     * @return Word value. Bits beyond the end of the array read as set.
+     */
+    u32 readWord(const Size word) const;
+
+    /**
+     * Update the summary bit of a word after it changed.
+     *
+     * @param word Word number which changed.
+     */
+    void updateSummary(const Size word);
+
+    /**
+     * Find the next word which has at least one unset bit.
+     *
+     * @param word Word number to start searching at.
+     *
+     * @return Word number, or a number beyond the last word if none found.
+     */
+    Size nextFreeWord(const Size word) const;
+
+    /**
+     * Find the next unset bit.
+     *
+     * @param from Bit number to start searching at.
+     * @param bit Bit number of the unset bit on output.
+     *
+     * @return True if found, false otherwise.
+     */
+    bool findUnset(const Size from, Size *bit) const;
+
+    /**
+     * Find the first set bit inside a range.
+     *
+     * @param from Bit number to start searching at.
+     * @param to End bit (exclusive). Must not exceed the array size.
+     *
+     * @return Bit number of the set bit, or the end bit if none is set.
+     */
+    Size findSet(const Size from, const Size to) const;
+
   private:
 
     /** Total number of bits in the array. */
@@ -185,6 +251,9 @@ class BitArray
     /** Array containing the bits. */
     u8 *m_array;
 
+    /** Summary with one bit per fully set word, or ZERO if not used. */
+    u32 *m_summary;
+
     /** True if m_array was allocated interally. */
     bool m_allocated;
 };
@@ -151,6 +151,12 @@ inline bool doubleEquals(double a, double b, double epsilon)
 #define USED \
     __attribute__((__used__))
 
+/**
+ * Forces a function to be inlined, also without optimization.
+ */
+#define ALWAYS_INLINE \
+    __attribute__((__always_inline__))
+
 /**
  * Ensures strict minimum memory requirements.
  *
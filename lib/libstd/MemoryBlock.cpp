@@ -27,6 +27,12 @@
 #include "Macros.h"
 #include "MemoryBlock.h"
 
+#ifdef __HOST__
+#include <malloc.h>
+#else
+#include "../liballoc/Allocator.h"
+#endif /* __HOST__ */
+
 void * MemoryBlock::set(void *dest, int ch, unsigned count)
 {
     char *temp;
@@ -113,3 +119,17 @@ bool MemoryBlock::compare(const char *p1, const char *p2, const Size count)
 
     return *ch1 == *ch2;
 }
+
+bool MemoryBlock::resize(void *addr, const Size size)
+{
+#ifdef __HOST__
+    return size <= malloc_usable_size(addr);
+#else
+    Allocator::Range range;
+    range.address   = (Address) addr;
+    range.size      = size;
+    range.alignment = 0;
+
+    return Allocator::getDefault()->reallocate(range, false) == Allocator::Success;
+#endif /* __HOST__ */
+}
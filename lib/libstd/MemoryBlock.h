@@ -93,6 +93,16 @@ class MemoryBlock
      * @return True if equal, false otherwise.
      */
     static bool compare(const char *p1, const char *p2, const Size count = 0);
+
+    /**
+     * Resize heap memory in place.
+     *
+     * @param addr Memory allocated with the new() operator.
+     * @param size New size in bytes.
+     *
+     * @return True if the memory now holds at least size bytes, false otherwise.
+     */
+    static bool resize(void *addr, const Size size);
 };
 
 /**
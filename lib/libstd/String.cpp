@@ -134,6 +134,14 @@ bool String::resize(const Size size)
     if (m_count >= size)
         m_count = size - 1;
 
+    // Resize the buffer in place, which avoids a copy if the heap has room for it
+    if (m_allocated && MemoryBlock::resize(m_string, size))
+    {
+        m_string[m_count] = ZERO;
+        m_size = size;
+        return true;
+    }
+
     // Allocate buffer
     buffer = new char[size];
     if (!buffer)
@@ -24,6 +24,12 @@
 #include "Macros.h"
 #include "MemoryBlock.h"
 
+#ifdef __HOST__
+#include <new>
+#else
+#include "../liballoc/Allocator.h"
+#endif /* __HOST__ */
+
 /**
  * @addtogroup lib
  * @{
@@ -55,7 +61,7 @@ template <class T> class Vector : public Sequence<T>
 
         m_size  = size;
         m_count = 0;
-        m_array = new T[m_size];
+        m_array = allocateArray(m_size);
     }
 
     /**
@@ -69,7 +75,7 @@ template <class T> class Vector : public Sequence<T>
 
         m_size  = a.m_size;
         m_count = a.m_count;
-        m_array = new T[m_size];
+        m_array = allocateArray(m_size);
 
         for (Size i = 0; i < m_size; i++)
             m_array[i] = a.m_array[i];
@@ -80,7 +86,7 @@ template <class T> class Vector : public Sequence<T>
      */
     virtual ~Vector()
     {
-        delete[] m_array;
+        releaseArray(m_array, m_size);
     }
 
     /**
@@ -225,22 +231,74 @@ template <class T> class Vector : public Sequence<T>
     {
         assert(size > 0);
 
-        T *arr = new T[size];
+        // Grow the array in place, if the heap has room for it
+        if (size > m_size && MemoryBlock::resize(m_array, size * sizeof(T)))
+        {
+            for (Size i = m_size; i < size; i++)
+                new ((void *) (m_array + i)) T();
+
+            m_size = size;
+            return true;
+        }
+
+        T *arr = allocateArray(size);
         if (!arr)
             return false;
 
         // Copy the old array in the new one
-        for (Size i = 0; i < m_size; i++)
+        for (Size i = 0; i < m_size && i < size; i++)
         {
             arr[i] = m_array[i];
         }
         // Clean up the old array and set the new one
-        delete[] m_array;
+        releaseArray(m_array, m_size);
         m_array = arr;
         m_size  = size;
+
+        if (m_count > m_size)
+            m_count = m_size;
+
         return true;
     }
 
+  private:
+
+    /**
+     * Allocate and construct an array of items.
+     *
+     * The items are constructed in raw memory, such that
+     * the array can be resized in place by the allocator.
+     *
+     * @param size Number of items.
+     *
+     * @return Pointer to the array or ZERO on failure.
+     */
+    static T * allocateArray(const Size size)
+    {
+        T *arr = (T *) operator new(size * sizeof(T));
+        if (!arr)
+            return ZERO;
+
+        for (Size i = 0; i < size; i++)
+            new ((void *) (arr + i)) T();
+
+        return arr;
+    }
+
+    /**
+     * Destroy and release an array of items.
+     *
+     * @param arr Pointer to the array.
+     * @param size Number of items.
+     */
+    static void releaseArray(T *arr, const Size size)
+    {
+        for (Size i = 0; i < size; i++)
+            arr[i].~T();
+
+        operator delete((void *) arr);
+    }
+
   private:
 
     /** The actual array where the data is stored. */
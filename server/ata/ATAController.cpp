@@ -15,33 +15,36 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <KernelLog.h>
+#include <Log.h>
 #include <DeviceServer.h>
+#include <MemoryBlock.h>
+#include <String.h>
 #include "ATAController.h"
 #include <Types.h>
 
-int main(int argc, char **argv)
+ATAController::ATAController(const u32 inode,
+                             DeviceServer &server,
+                             const Mode mode)
+    : Device(inode, FileSystem::BlockDeviceFile)
+    , m_server(server)
+    , m_mode(mode)
+    , m_busMaster(0)
+    , m_buffer(ZERO)
+    , m_busy(false)
+    , m_done(false)
+    , m_result(FileSystem::Success)
+    , m_lba(0)
+    , m_sectors(0)
+    , m_transferred(0)
+    , m_owner(0)
 {
-    KernelLog log;
-    DeviceServer server("/dev/ata");
-    server.registerDevice(new ATAController(server.getNextInode()), "ata0");
-
-    // Initialize
-    const FileSystem::Result result = server.initialize();
-    if (result != FileSystem::Success)
-    {
-        ERROR("failed to initialize: result = " << (int) result);
-        return 1;
-    }
-
-    // Start serving requests
-    return server.run();
+    m_identifier << "ata0";
+    m_notifying = FileSystem::Readable;
 }
 
-ATAController::ATAController(const u32 inode)
-    : Device(inode, FileSystem::BlockDeviceFile)
+ATAController::Mode ATAController::getMode() const
 {
-    m_identifier << "ata0";
+    return m_mode;
 }
 
 FileSystem::Result ATAController::initialize()
@@ -85,87 +88,427 @@ FileSystem::Result ATAController::initialize()
         IDENTIFY_TEXT_SWAP(drive->identity.serial, 20);
         IDENTIFY_TEXT_SWAP(drive->identity.model, 40);
 
+        // 48-bit LBA is supported if bit 10 of word 83 is set
+        drive->lba48   = (drive->identity.supported[1] & (1 << 10)) != 0;
+        drive->sectors = drive->lba48 ? (Size) drive->identity.sectors48 :
+                                        (Size) drive->identity.sectors28;
+
+        // Enable READ MULTIPLE with the maximum sectors per data request
+        drive->multiple = drive->identity.maxTransfer & 0xff;
+        if (drive->multiple > 1)
+        {
+            m_io.outb(ATA_BASE_CMD0 + ATA_REG_SELECT, ATA_SEL_MASTER);
+            m_io.outb(ATA_BASE_CMD0 + ATA_REG_COUNT,  drive->multiple);
+            m_io.outb(ATA_BASE_CMD0 + ATA_REG_CMD,    ATA_CMD_SET_MULTIPLE);
+
+            if (!pollReady(true))
+            {
+                WARNING("SET MULTIPLE failed: using single sector data requests");
+                drive->multiple = 1;
+            }
+        }
+        else
+        {
+            drive->multiple = 1;
+        }
+
         // Print out information
         NOTICE("ATA drive detected: SERIAL=" << drive->identity.serial <<
                " FIRMWARE=" << drive->identity.firmware <<
                " MODEL=" << drive->identity.model <<
                " MAJOR=" << drive->identity.majorRevision <<
                " MINOR=" << drive->identity.minorRevision <<
-               " SECTORS=" << drive->identity.sectors28);
+               " SECTORS=" << drive->sectors <<
+               " LBA48=" << (int) drive->lba48 <<
+               " MULTIPLE=" << drive->multiple);
         break;
     }
 
+    // Allocate the transfer buffer. DMA needs the PRDT in the first page.
+    m_dma.virt   = ZERO;
+    m_dma.phys   = ZERO;
+    m_dma.size   = PAGESIZE + (MaximumSectors * SectorSize);
+    m_dma.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    const API::Result result = VMCtl(SELF, MapContiguous, &m_dma);
+    if (result != API::Success)
+    {
+        ERROR("failed to allocate transfer buffer: result = " << (int) result);
+        return FileSystem::IOError;
+    }
+    m_buffer = (u8 *) (m_dma.virt + PAGESIZE);
+
+    if (m_mode == DirectMemoryAccess && initializeDMA() != FileSystem::Success)
+    {
+        WARNING("bus master DMA not available: using interrupt driven PIO");
+        m_mode = InterruptIO;
+    }
+
+    // Drives only raise interrupts if not polling
+    m_io.outb(ATA_BASE_CTL0, m_mode == PolledIO ? ATA_REG_INTR : 0);
+
+    NOTICE("using " << (m_mode == PolledIO ? "polled PIO" :
+                        m_mode == InterruptIO ? "interrupt driven PIO" : "bus master DMA") <<
+           " transfer mode");
     return FileSystem::Success;
 }
 
+FileSystem::Result ATAController::initializeDMA()
+{
+    // Search for the IDE controller on the PCI bus
+    for (Size bus = 0; bus < 256; bus++)
+    {
+        for (Size slot = 0; slot < 32; slot++)
+        {
+            for (Size func = 0; func < 8; func++)
+            {
+                if ((readConfig(bus, slot, func, 0) & 0xffff) == 0xffff)
+                {
+                    continue;
+                }
+
+                const u32 classCode = readConfig(bus, slot, func, PCI_REG_CLASS);
+                if ((classCode >> 24) != PCI_CLASS_STORAGE ||
+                   ((classCode >> 16) & 0xff) != PCI_SUBCLASS_IDE)
+                {
+                    continue;
+                }
+
+                // The Bus Master I/O Base must be a port I/O address
+                const u32 bar = readConfig(bus, slot, func, PCI_REG_BAR4);
+                if (!(bar & 1) || (bar & 0xfffc) == 0)
+                {
+                    return FileSystem::NotSupported;
+                }
+                m_busMaster = bar & 0xfffc;
+
+                // Enable bus mastering
+                const u32 command = readConfig(bus, slot, func, PCI_REG_COMMAND);
+                writeConfig(bus, slot, func, PCI_REG_COMMAND,
+                            (command & 0xffff) | PCI_COMMAND_IO | PCI_COMMAND_MASTER);
+
+                NOTICE("IDE controller at PCI " << bus << ":" << slot << "." << func <<
+                       " bus master I/O base " << (void *) (Address) m_busMaster);
+                return FileSystem::Success;
+            }
+        }
+    }
+
+    return FileSystem::NotFound;
+}
+
+u32 ATAController::readConfig(const u8 bus, const u8 slot, const u8 func, const u8 reg)
+{
+    m_io.outl(PCI_CONFIG_ADDR, (1U << 31) | (bus << 16) | (slot << 11) | (func << 8) | (reg & 0xfc));
+    return m_io.inl(PCI_CONFIG_DATA);
+}
+
+void ATAController::writeConfig(const u8 bus, const u8 slot, const u8 func, const u8 reg, const u32 value)
+{
+    m_io.outl(PCI_CONFIG_ADDR, (1U << 31) | (bus << 16) | (slot << 11) | (func << 8) | (reg & 0xfc));
+    m_io.outl(PCI_CONFIG_DATA, value);
+}
+
 FileSystem::Result ATAController::read(IOBuffer & buffer,
                                        Size & size,
                                        const Size offset)
 {
-    u8 sectors = CEIL(size, 512);
-    u16 block[256];
-    u32 lba     = offset / 512;
-    Size result = 0;
-    Size off = offset;
+    const u64 lba = offset / SectorSize;
+    const Size skip = offset % SectorSize;
+    Size sectors = CEIL(skip + size, SectorSize);
 
     // Verify LBA
-    if (drives.isEmpty() || drives.first()->identity.sectors28 < lba)
+    if (drives.isEmpty() || lba >= drives.first()->sectors)
     {
         return FileSystem::IOError;
     }
 
+    // Limit the number of sectors
+    if (sectors > MaximumSectors)
+    {
+        sectors = MaximumSectors;
+    }
+    if (lba + sectors > drives.first()->sectors)
+    {
+        sectors = drives.first()->sectors - lba;
+    }
+
+    // The command belongs to the first request which started it
+    const ProcessID from = buffer.getMessage()->from;
+    const bool owner = m_owner == from && m_lba == lba && m_sectors == sectors;
+
+    // Abort commands past their deadline, and release them if not consumed by the owner
+    if (m_busy)
+    {
+        m_timer.tick();
+
+        if (m_timer.isExpired(m_deadline))
+        {
+            if (!m_done)
+            {
+                WARNING("read command timed out: lba = " << (Size) m_lba << " sectors = " << m_sectors);
+                abortCommand();
+            }
+
+            if (!owner)
+            {
+                m_busy = false;
+            }
+        }
+    }
+
+    // Start the command, unless in progress
+    if (!m_busy)
+    {
+        m_busy        = true;
+        m_done        = false;
+        m_result      = FileSystem::Success;
+        m_owner       = from;
+        m_lba         = lba;
+        m_sectors     = sectors;
+        m_transferred = 0;
+        m_timer.tick();
+        m_timer.getCurrent(&m_deadline, CommandTimeout);
+        startRead(lba, sectors);
+
+        // Lost interrupts are detected by the timeout of the server
+        if (m_mode != PolledIO)
+        {
+            armTimeout();
+        }
+
+        // Wait for each data request to complete
+        if (m_mode == PolledIO)
+        {
+            while (!m_done)
+            {
+                if (!pollReady())
+                {
+                    m_result = FileSystem::IOError;
+                    m_done = true;
+                    break;
+                }
+                transferData();
+            }
+        }
+    }
+
+    // Wait for the interrupt handler to complete our command
+    if (!m_done || m_owner != from || m_lba != lba || m_sectors != sectors)
+    {
+        if (!m_done)
+        {
+            armTimeout();
+        }
+        return FileSystem::RetryAgain;
+    }
+    m_busy = false;
+
+    // Other readers may now start their command
+    notifyReadable();
+
+    if (m_result != FileSystem::Success)
+    {
+        return m_result;
+    }
+
+    // Copy to buffer
+    const Size bytes = (sectors * SectorSize) - skip < size ?
+                       (sectors * SectorSize) - skip : size;
+
+    const FileSystem::Result result = buffer.write(m_buffer + skip, bytes);
+    if (result != FileSystem::Success)
+    {
+        return result;
+    }
+
+    size = bytes;
+    return FileSystem::Success;
+}
+
+void ATAController::startRead(const u64 lba, const Size sectors)
+{
+    const ATADrive *drive = drives.first();
+    const bool lba48 = drive->lba48 && (lba + sectors) > 0x0fffffff;
+    u8 command;
+
+    // Choose the read command
+    if (m_mode == DirectMemoryAccess)
+        command = lba48 ? ATA_CMD_READ_DMA_EXT : ATA_CMD_READ_DMA;
+    else if (drive->multiple > 1)
+        command = lba48 ? ATA_CMD_READ_MULTIPLE_EXT : ATA_CMD_READ_MULTIPLE;
+    else
+        command = lba48 ? ATA_CMD_READ_EXT : ATA_CMD_READ;
+
+    // Prepare the bus master with one descriptor per page of the transfer buffer
+    if (m_mode == DirectMemoryAccess)
+    {
+        ATAPhysicalRegion *prdt = (ATAPhysicalRegion *) m_dma.virt;
+        const Size bytes = sectors * SectorSize;
+        Size i = 0;
+
+        for (Size done = 0; done < bytes; done += PAGESIZE, i++)
+        {
+            prdt[i].address = m_dma.phys + PAGESIZE + done;
+            prdt[i].size    = bytes - done < PAGESIZE ? bytes - done : PAGESIZE;
+            prdt[i].flags   = 0;
+        }
+        prdt[i - 1].flags = ATA_PRD_END;
+
+        m_io.outb(m_busMaster + ATA_BM_REG_CMD, ATA_BM_CMD_READ);
+        m_io.outb(m_busMaster + ATA_BM_REG_STATUS, ATA_BM_STATUS_ERROR | ATA_BM_STATUS_IRQ);
+        m_io.outl(m_busMaster + ATA_BM_REG_PRDT, m_dma.phys);
+    }
+
     // Perform ATA Read Command
-    m_io.outb(ATA_BASE_CMD0 + ATA_REG_SELECT, ATA_SEL_MASTER_28);
-    m_io.outb(ATA_BASE_CMD0 + ATA_REG_COUNT,  sectors);
+    if (lba48)
+    {
+        // High order bytes are written first
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_SELECT, ATA_SEL_MASTER_48);
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_COUNT,  (sectors >> 8) & 0xff);
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR0,  (lba >> 24) & 0xff);
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR1,  (lba >> 32) & 0xff);
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR2,  (lba >> 40) & 0xff);
+    }
+    else
+    {
+        m_io.outb(ATA_BASE_CMD0 + ATA_REG_SELECT, ATA_SEL_MASTER_28 | ((lba >> 24) & 0xf));
+    }
+    m_io.outb(ATA_BASE_CMD0 + ATA_REG_COUNT,  sectors & 0xff);
     m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR0,  (lba) & 0xff);
     m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR1,  (lba >> 8) & 0xff);
     m_io.outb(ATA_BASE_CMD0 + ATA_REG_ADDR2,  (lba >> 16) & 0xff);
-    m_io.outb(ATA_BASE_CMD0 + ATA_REG_CMD,    ATA_CMD_READ);
+    m_io.outb(ATA_BASE_CMD0 + ATA_REG_CMD,    command);
 
-    // Read out all requested sectors
-    while(result < size)
+    // Start the bus master transfer
+    if (m_mode == DirectMemoryAccess)
     {
-        // Poll the status register
-        pollReady(true);
+        m_io.outb(m_busMaster + ATA_BM_REG_CMD, ATA_BM_CMD_READ | ATA_BM_CMD_START);
+    }
+}
 
-        // Read out bytes
-        for (int i = 0; i < 256; i++)
-        {
-            block[i] = m_io.inw(ATA_BASE_CMD0 + ATA_REG_DATA);
-        }
+void ATAController::transferData()
+{
+    const Size remaining = m_sectors - m_transferred;
+    const Size count = remaining < drives.first()->multiple ?
+                       remaining : drives.first()->multiple;
+    u16 *data = (u16 *) (m_buffer + (m_transferred * SectorSize));
+
+    // Read out all words of the data request
+    for (Size i = 0; i < (count * SectorSize) / sizeof(u16); i++)
+    {
+        data[i] = m_io.inw(ATA_BASE_CMD0 + ATA_REG_DATA);
+    }
 
-        // Calculate maximum bytes
-        Size bytes = (size - result) < 512 - (off % 512) ?
-                     (size - result) : 512 - (off % 512);
+    m_transferred += count;
+    m_done = m_transferred == m_sectors;
+}
+
+void ATAController::resetDrive()
+{
+    // Stop the bus master
+    if (m_mode == DirectMemoryAccess)
+    {
+        m_io.outb(m_busMaster + ATA_BM_REG_CMD, 0);
+        m_io.outb(m_busMaster + ATA_BM_REG_STATUS, ATA_BM_STATUS_ERROR | ATA_BM_STATUS_IRQ);
+    }
+
+    // Software reset cancels the command on the drive
+    m_io.outb(ATA_BASE_CTL0, ATA_REG_RESET);
+    m_io.outb(ATA_BASE_CTL0, 0);
+}
+
+void ATAController::abortCommand()
+{
+    resetDrive();
 
-        // Copy to buffer
-        buffer.bufferedWrite(((u8 *)block) + (off % 512), bytes);
+    m_result = FileSystem::TimedOut;
+    m_done = true;
+}
+
+void ATAController::armTimeout()
+{
+    Timer::Info now;
 
-        // Update state
-        result += bytes;
-        off += bytes;
+    m_timer.tick();
+    m_timer.getCurrent(&now);
+
+    if (!now.frequency)
+    {
+        return;
     }
 
-    size = result;
-    return FileSystem::Success;
+    // Wake up the server once the deadline passed, such that read() aborts the command
+    const Size msecPerTick = 1000 / now.frequency;
+    const Size ticks = m_deadline.ticks > now.ticks ? m_deadline.ticks - now.ticks : 0;
+
+    m_server.setTimeout(ticks * msecPerTick);
 }
 
 FileSystem::Result ATAController::interrupt(const Size vector)
 {
-    INFO("ATA interrupted on IRQ " << vector);
+    if (m_mode == DirectMemoryAccess)
+    {
+        const u8 bmStatus = m_io.inb(m_busMaster + ATA_BM_REG_STATUS);
+
+        if (m_busy && !m_done && (bmStatus & ATA_BM_STATUS_IRQ))
+        {
+            // Stop the bus master and acknowledge the interrupt
+            m_io.outb(m_busMaster + ATA_BM_REG_CMD, 0);
+            m_io.outb(m_busMaster + ATA_BM_REG_STATUS, bmStatus);
+
+            const u8 status = m_io.inb(ATA_BASE_CMD0 + ATA_REG_STATUS);
+            if ((bmStatus & ATA_BM_STATUS_ERROR) || (status & (ATA_STATUS_ERROR | ATA_STATUS_FAULT)))
+            {
+                m_result = FileSystem::IOError;
+            }
+            m_done = true;
+        }
+    }
+    else
+    {
+        // Reading the status register acknowledges the interrupt
+        const u8 status = m_io.inb(ATA_BASE_CMD0 + ATA_REG_STATUS);
+
+        if (m_busy && !m_done)
+        {
+            if (status & (ATA_STATUS_ERROR | ATA_STATUS_FAULT))
+            {
+                m_result = FileSystem::IOError;
+                m_done = true;
+            }
+            else if (status & ATA_STATUS_DATA)
+            {
+                transferData();
+            }
+        }
+    }
+
+    if (m_done)
+    {
+        notifyReadable();
+    }
+
+    ProcessCtl(SELF, EnableIRQ, vector);
     return FileSystem::Success;
 }
 
-void ATAController::pollReady(bool noData)
+bool ATAController::pollReady(bool noData)
 {
     while (true)
     {
         u8 status = m_io.inb(ATA_BASE_CMD0 + ATA_REG_STATUS);
 
+        if (!(status & ATA_STATUS_BUSY) &&
+             (status & (ATA_STATUS_ERROR | ATA_STATUS_FAULT)))
+        {
+            return false;
+        }
+
         if (!(status & ATA_STATUS_BUSY) &&
              (status & ATA_STATUS_DATA || noData))
         {
-            break;
+            return true;
         }
     }
 }
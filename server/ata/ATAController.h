@@ -21,6 +21,8 @@
 #include <FreeNOS/User.h>
 #include <List.h>
 #include <Device.h>
+#include <DeviceServer.h>
+#include <KernelTimer.h>
 
 /**
  * @addtogroup server
@@ -47,6 +49,9 @@
 /** @brief Second ATA Bus Control I/O Base. */
 #define ATA_BASE_CTL1   0x376
 
+/** @brief Interrupt vector of the first ATA Bus. */
+#define ATA_IRQ0        14
+
 /**
  * @}
  */
@@ -130,6 +135,11 @@
  */
 #define ATA_STATUS_DATA  0x08
 
+/**
+ * @brief Drive Fault Error (does not set ERR).
+ */
+#define ATA_STATUS_FAULT 0x20
+
 /**
  * @brief Drive is preparing to accept or send data.
  * Wait until this bit clears. If it never clears, do a Software Reset.
@@ -192,6 +202,97 @@
 /** @brief Reads sectors from an ATA device. */
 #define ATA_CMD_READ     0x20
 
+/** @brief Reads sectors from an ATA device using 48-bit LBA. */
+#define ATA_CMD_READ_EXT 0x24
+
+/** @brief Reads multiple sectors per data request from an ATA device. */
+#define ATA_CMD_READ_MULTIPLE     0xc4
+
+/** @brief Reads multiple sectors per data request using 48-bit LBA. */
+#define ATA_CMD_READ_MULTIPLE_EXT 0x29
+
+/** @brief Reads sectors from an ATA device using DMA. */
+#define ATA_CMD_READ_DMA     0xc8
+
+/** @brief Reads sectors from an ATA device using DMA and 48-bit LBA. */
+#define ATA_CMD_READ_DMA_EXT 0x25
+
+/** @brief Sets the number of sectors per data request for READ MULTIPLE. */
+#define ATA_CMD_SET_MULTIPLE 0xc6
+
+/**
+ * @}
+ */
+
+/**
+ * @name ATA Bus Master Registers.
+ * @see http://wiki.osdev.org/ATA/ATAPI_using_DMA
+ * @{
+ */
+
+/** @brief Bus Master Command register (relative to the Bus Master I/O Base). */
+#define ATA_BM_REG_CMD    0
+
+/** @brief Bus Master Status register. */
+#define ATA_BM_REG_STATUS 2
+
+/** @brief Bus Master Physical Region Descriptor Table address register. */
+#define ATA_BM_REG_PRDT   4
+
+/** @brief Start/Stop the Bus Master transfer. */
+#define ATA_BM_CMD_START  0x01
+
+/** @brief Transfer direction is from the drive to memory. */
+#define ATA_BM_CMD_READ   0x08
+
+/** @brief Bus Master transfer is active. */
+#define ATA_BM_STATUS_ACTIVE 0x01
+
+/** @brief Bus Master transfer failed. */
+#define ATA_BM_STATUS_ERROR  0x02
+
+/** @brief Drive raised an interrupt. */
+#define ATA_BM_STATUS_IRQ    0x04
+
+/** @brief Marks the last entry in the Physical Region Descriptor Table. */
+#define ATA_PRD_END 0x8000
+
+/**
+ * @}
+ */
+
+/**
+ * @name PCI Configuration Space.
+ * @{
+ */
+
+/** @brief PCI configuration address port. */
+#define PCI_CONFIG_ADDR  0xcf8
+
+/** @brief PCI configuration data port. */
+#define PCI_CONFIG_DATA  0xcfc
+
+/** @brief PCI command register offset. */
+#define PCI_REG_COMMAND  0x04
+
+/** @brief PCI class code register offset. */
+#define PCI_REG_CLASS    0x08
+
+/** @brief PCI Base Address Register 4: the Bus Master I/O Base for IDE controllers. */
+#define PCI_REG_BAR4     0x20
+
+/** @brief PCI command bit for enabling I/O space access. */
+#define PCI_COMMAND_IO     0x01
+
+/** @brief PCI command bit for enabling bus mastering. */
+#define PCI_COMMAND_MASTER 0x04
+
+/** @brief PCI class code for mass storage controllers. */
+#define PCI_CLASS_STORAGE 0x01
+
+/** @brief PCI subclass code for IDE controllers. */
+#define PCI_SUBCLASS_IDE  0x01
+
 /**
  * @}
  */
@@ -253,22 +354,87 @@ typedef struct ATADrive
 
     /** Number of sectors. */
     Size sectors;
+
+    /** True if 48-bit LBA is supported. */
+    bool lba48;
+
+    /** Number of sectors per data request for READ MULTIPLE, or one if not supported. */
+    Size multiple;
 }
 ATADrive;
 
+/**
+ * @brief Physical Region Descriptor for Bus Master DMA.
+ */
+typedef struct ATAPhysicalRegion
+{
+    /** Physical address of the memory region. */
+    u32 address;
+
+    /** Size of the memory region in bytes (zero means 64KiB). */
+    u16 size;
+
+    /** Flags, where ATA_PRD_END marks the last entry. */
+    u16 flags;
+}
+ATAPhysicalRegion;
+
 /**
  * @brief AT Attachment (ATA) Host Controller Device.
+ *
+ * Reads are transferred in one of the following modes:
+ *
+ *  - PolledIO: PIO commands, waiting for each data request by polling
+ *  - InterruptIO: PIO commands, transferring each data request on interrupt
+ *  - DirectMemoryAccess: PCI bus master DMA, completing on interrupt
+ *
+ * PIO modes use READ MULTIPLE if the drive supports it, and all modes
+ * use 48-bit LBA commands for sectors beyond the range of 28-bit LBA.
  */
 class ATAController : public Device
 {
+  private:
+
+    /** Size of a sector in bytes. */
+    static const Size SectorSize = 512;
+
+    /** Maximum number of sectors per command. */
+    static const Size MaximumSectors = 256;
+
+    /** Milliseconds before an unfinished read command is aborted. */
+    static const Size CommandTimeout = 5000;
+
+  public:
+
+    /**
+     * Transfer modes.
+     */
+    enum Mode
+    {
+        PolledIO,
+        InterruptIO,
+        DirectMemoryAccess
+    };
+
   public:
 
     /**
      * Constructor
      *
      * @param inode Inode number
+     * @param server DeviceServer reference, used for timeouts
+     * @param mode Transfer mode to use
+     */
+    ATAController(const u32 inode,
+                  DeviceServer &server,
+                  const Mode mode = PolledIO);
+
+    /**
+     * Get the transfer mode.
+     *
+     * @return Transfer mode
      */
-    ATAController(const u32 inode);
+    Mode getMode() const;
 
     /**
      * Configures the ATA controller.
@@ -280,12 +446,20 @@ class ATAController : public Device
     /**
      * Read bytes from a drive attached to the ATA controller
      *
+     * At most MaximumSectors are transferred per call.
+     *
      * @param buffer Input/Output buffer to output bytes to.
      * @param size Maximum number of bytes to read on input.
      *             On output, the actual number of bytes read.
      * @param offset Offset inside the file to start reading.
      *
-     * @return Result code
+     * Only the request which started the read command consumes its result.
+     * Commands which do not complete within CommandTimeout are aborted
+     * and no longer block other requests. The server timeout is armed for
+     * the deadline, such that a lost interrupt still completes the request.
+     *
+     * @return Result code. RetryAgain while the transfer is in progress
+     *         when using interrupts, or TimedOut if the command was aborted.
      */
     virtual FileSystem::Result read(IOBuffer & buffer,
                                     Size & size,
@@ -306,16 +480,126 @@ class ATAController : public Device
      * @brief Polls the Regular Status register.
      *
      * @param noData Don't wait for the ATA_STATUS_DATA flag to set.
+     *
+     * @return False if the drive reports an error, true otherwise.
      */
-    void pollReady(bool noData = false);
+    bool pollReady(bool noData = false);
 
-  private:
+    /**
+     * Setup Bus Master DMA.
+     *
+     * Searches the PCI bus for the IDE controller and enables bus mastering.
+     *
+     * @return Result code
+     */
+    FileSystem::Result initializeDMA();
+
+    /**
+     * Read a PCI configuration register.
+     *
+     * @param bus Bus number
+     * @param slot Slot number
+     * @param func Function number
+     * @param reg Register offset
+     *
+     * @return 32-bit register value
+     */
+    u32 readConfig(const u8 bus, const u8 slot, const u8 func, const u8 reg);
+
+    /**
+     * Write a PCI configuration register.
+     *
+     * @param bus Bus number
+     * @param slot Slot number
+     * @param func Function number
+     * @param reg Register offset
+     * @param value 32-bit value to write
+     */
+    void writeConfig(const u8 bus, const u8 slot, const u8 func, const u8 reg, const u32 value);
+
+    /**
+     * Transfer one data request from the drive into the transfer buffer.
+     */
+    void transferData();
+
+    /**
+     * Abort the current read command.
+     *
+     * Resets the drive and completes the command with TimedOut.
+     */
+    void abortCommand();
+
+    /**
+     * Arm the server timeout for the deadline of the current read command.
+     */
+    void armTimeout();
+
+  protected:
+
+    /**
+     * Start a read command on the first drive.
+     *
+     * @param lba First sector to read
+     * @param sectors Number of sectors to read
+     */
+    virtual void startRead(const u64 lba, const Size sectors);
+
+    /**
+     * Stop the bus master and reset the drives on the bus.
+     */
+    virtual void resetDrive();
+
+  protected:
 
     /** @brief Drives detected on the ATA bus. */
     List<ATADrive *> drives;
 
+    /** Timer for detecting read commands which do not complete. */
+    KernelTimer m_timer;
+
+    /** Deadline of the current read command. */
+    Timer::Info m_deadline;
+
+  private:
+
+    /** DeviceServer, which wakes up on timeouts. */
+    DeviceServer &m_server;
+
     /** Port I/O object. */
     Arch::IO m_io;
+
+    /** Transfer mode. */
+    Mode m_mode;
+
+    /** I/O base of the Bus Master registers. */
+    u16 m_busMaster;
+
+    /** Physically contiguous memory for the PRDT (first page) and the transfer buffer. */
+    Memory::Range m_dma;
+
+    /** Transfer buffer. */
+    u8 *m_buffer;
+
+    /** True if a read command is in progress or completed but not yet consumed. */
+    bool m_busy;
+
+    /** True if the current read command completed. */
+    bool m_done;
+
+    /** Result of the current read command. */
+    FileSystem::Result m_result;
+
+    /** First sector of the current read command. */
+    u64 m_lba;
+
+    /** Number of sectors of the current read command. */
+    Size m_sectors;
+
+    /** Number of sectors transferred of the current read command. */
+    Size m_transferred;
+
+    /** Process which started the current read command. */
+    ProcessID m_owner;
 };
 
 /**
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <KernelLog.h>
+#include <DeviceServer.h>
+#include <String.h>
+#include "ATAController.h"
+
+int main(int argc, char **argv)
+{
+    KernelLog log;
+    DeviceServer server("/dev/ata");
+    ATAController::Mode mode = ATAController::PolledIO;
+
+    // Optionally select the transfer mode
+    if (argc > 1)
+    {
+        const String arg(argv[1], false);
+
+        if (arg.equals("pio"))
+            mode = ATAController::PolledIO;
+        else if (arg.equals("irq"))
+            mode = ATAController::InterruptIO;
+        else if (arg.equals("dma"))
+            mode = ATAController::DirectMemoryAccess;
+        else
+        {
+            ERROR("usage: " << argv[0] << " [pio|irq|dma]");
+            return 1;
+        }
+    }
+
+    ATAController *ata = new ATAController(server.getNextInode(), server, mode);
+    server.registerDevice(ata, "ata0");
+
+    // Initialize
+    const FileSystem::Result result = server.initialize();
+    if (result != FileSystem::Success)
+    {
+        ERROR("failed to initialize: result = " << (int) result);
+        return 1;
+    }
+
+    // Interrupts complete transfers, unless polling
+    if (ata->getMode() != ATAController::PolledIO)
+    {
+        server.registerInterrupt(ata, ATA_IRQ0);
+    }
+
+    // Start serving requests
+    return server.run();
+}
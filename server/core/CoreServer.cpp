@@ -273,6 +273,8 @@ CoreServer::Result CoreServer::initialize()
         }
     }
 
+    ProcessCtl(SELF, RecordBootEvent, (Address) "core loadKernel");
+
     if (loadKernel() != Core::Success)
     {
         ERROR("failed to load kernel program");
@@ -297,12 +299,16 @@ CoreServer::Result CoreServer::initialize()
         return IOError;
     }
 
+    ProcessCtl(SELF, RecordBootEvent, (Address) "core bootAll");
+
     if (bootAll() != Core::Success)
     {
         ERROR("failed to boot all cores");
         return IOError;
     }
 
+    ProcessCtl(SELF, RecordBootEvent, (Address) "core ready");
+
     if (unloadKernel() != Core::Success)
     {
         ERROR("failed to unload kernel program");
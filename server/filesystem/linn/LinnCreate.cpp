@@ -22,6 +22,8 @@
 #include <Types.h>
 #include <Macros.h>
 #include <FileSystem.h>
+#include <ByteOrder.h>
+#include <Lz4Compressor.h>
 #include "LinnCreate.h"
 #include "LinnSuperBlock.h"
 #include "LinnGroup.h"
@@ -46,6 +48,7 @@ LinnCreate::LinnCreate()
     super     = ZERO;
     input     = ZERO;
     verbose   = false;
+    compress  = false;
 }
 
 LinnInode * LinnCreate::createInode(le32 inodeNum, FileSystem::FileType type,
@@ -74,6 +77,7 @@ LinnInode * LinnCreate::createInode(le32 inodeNum, FileSystem::FileType type,
     inode->modifyTime = inode->createTime;
     inode->changeTime = inode->createTime;
     inode->links = 1;
+    inode->flags = ZERO;
 
     // Update inode BitArray, if needed
     inodeMap.setArray(BLOCKPTR(u8, group->inodeMap),
@@ -176,11 +180,100 @@ le32 LinnCreate::insertIndirect(le32 *ptr, const le32 blockIndexNumber, const Si
     }
 }
 
+le32 LinnCreate::insertBlock(char *inputFile, LinnInode *inode, const le32 blockIndex)
+{
+    // Insert the block (direct)
+    if (blockIndex < LINN_INODE_DIR_BLOCKS)
+    {
+        inode->block[blockIndex] = BLOCK(super);
+        return inode->block[blockIndex];
+    }
+    // Insert the block (indirect)
+    else if (blockIndex < LINN_INODE_DIR_BLOCKS + LINN_SUPER_NUM_PTRS(super))
+    {
+        return insertIndirect(&inode->block[LINN_INODE_IND_BLOCKS-1],
+                               blockIndex - LINN_INODE_DIR_BLOCKS, 1);
+    }
+    // Insert the block (double indirect)
+    else if (blockIndex < LINN_INODE_DIR_BLOCKS + (LINN_SUPER_NUM_PTRS(super) *
+                                                   LINN_SUPER_NUM_PTRS(super)))
+    {
+        return insertIndirect(&inode->block[LINN_INODE_DIND_BLOCKS-1],
+                               blockIndex - LINN_INODE_DIR_BLOCKS, 2);
+    }
+    // Insert the blck (triple indirect)
+    else if (blockIndex < LINN_INODE_DIR_BLOCKS + (LINN_SUPER_NUM_PTRS(super) *
+                                                   LINN_SUPER_NUM_PTRS(super) *
+                                                   LINN_SUPER_NUM_PTRS(super)))
+    {
+        return insertIndirect(&inode->block[LINN_INODE_TIND_BLOCKS-1],
+                               blockIndex - LINN_INODE_DIR_BLOCKS, 3);
+    }
+    // Maximum file capacity reached
+    else
+    {
+        printf("%s: maximum file size reached for `%s'\n",
+                prog, inputFile);
+        exit(EXIT_FAILURE);
+    }
+}
+
+u8 * LinnCreate::compressFile(const u8 *data, const Size size, Size & storedSize)
+{
+    const Size chunks = (size + LINN_INODE_CHUNK_SIZE - 1) / LINN_INODE_CHUNK_SIZE;
+    const Size tableSize = (chunks + 1) * sizeof(le32);
+    u8 *stored = new u8[tableSize + size];
+    u8 *packed = new u8[Lz4Compressor(data, size < LINN_INODE_CHUNK_SIZE ?
+                                            size : LINN_INODE_CHUNK_SIZE).getMaximumSize()];
+
+    storedSize = tableSize;
+
+    // Compress each chunk independently
+    for (Size i = 0; i < chunks; i++)
+    {
+        const Size offset = i * LINN_INODE_CHUNK_SIZE;
+        const Size chunkSize = size - offset < LINN_INODE_CHUNK_SIZE ?
+                               size - offset : LINN_INODE_CHUNK_SIZE;
+        const Lz4Compressor lz4(data + offset, chunkSize);
+        Size packedSize = lz4.getMaximumSize();
+
+        writeLe32(stored + (i * sizeof(le32)), storedSize);
+
+        // Keep the chunk uncompressed if it does not become smaller
+        if (lz4.compressBlock(packed, packedSize) == Lz4Compressor::Success &&
+            packedSize < chunkSize)
+        {
+            memcpy(stored + storedSize, packed, packedSize);
+            storedSize += packedSize;
+        }
+        else
+        {
+            memcpy(stored + storedSize, data + offset, chunkSize);
+            storedSize += chunkSize;
+        }
+    }
+    delete[] packed;
+
+    // Mark the end of the last chunk
+    writeLe32(stored + (chunks * sizeof(le32)), storedSize);
+
+    // Only use the compressed data if smaller than the original
+    if (storedSize >= size)
+    {
+        delete[] stored;
+        return ZERO;
+    }
+    return stored;
+}
+
 void LinnCreate::insertFile(char *inputFile, LinnInode *inode,
                             struct stat *st)
 {
+    const Size size = st->st_size;
+    u8 *data = new u8[size + 1];
+    u8 *stored = ZERO;
+    Size storedSize = size, total = 0;
     int fd, bytes;
-    le32 blockNr;
 
     // Open the local file
     if ((fd = open(inputFile, O_RDONLY)) < 0)
@@ -190,64 +283,57 @@ void LinnCreate::insertFile(char *inputFile, LinnInode *inode,
         exit(EXIT_FAILURE);
     }
 
-    // Read blocks from the file
-    while (inode->size < st->st_size)
+    // Read the file contents
+    while (total < size)
     {
-        // Insert the block (direct)
-        if (LINN_INODE_NUM_BLOCKS(super, inode) <
-            LINN_INODE_DIR_BLOCKS)
+        if ((bytes = read(fd, data + total, size - total)) < 0)
         {
-            blockNr = BLOCK(super);
-            inode->block[LINN_INODE_NUM_BLOCKS(super,inode)] = blockNr;
-        }
-        // Insert the block (indirect)
-        else if (LINN_INODE_NUM_BLOCKS(super, inode) <
-                 LINN_INODE_DIR_BLOCKS + LINN_SUPER_NUM_PTRS(super))
-        {
-            blockNr = insertIndirect(&inode->block[LINN_INODE_IND_BLOCKS-1],
-                                      LINN_INODE_NUM_BLOCKS(super, inode) -
-                                      LINN_INODE_DIR_BLOCKS, 1);
-        }
-        // Insert the block (double indirect)
-        else if (LINN_INODE_NUM_BLOCKS(super, inode) <
-                 LINN_INODE_DIR_BLOCKS + (LINN_SUPER_NUM_PTRS(super) *
-                                          LINN_SUPER_NUM_PTRS(super)))
-        {
-            blockNr = insertIndirect(&inode->block[LINN_INODE_DIND_BLOCKS-1],
-                                      LINN_INODE_NUM_BLOCKS(super, inode) -
-                                      LINN_INODE_DIR_BLOCKS, 2);
+            printf("%s: failed to read() `%s': %s\n",
+                    prog, inputFile, strerror(errno));
+            exit(EXIT_FAILURE);
         }
-        // Insert the blck (triple indirect)
-        else if (LINN_INODE_NUM_BLOCKS(super, inode) <
-                 LINN_INODE_DIR_BLOCKS + (LINN_SUPER_NUM_PTRS(super) *
-                                          LINN_SUPER_NUM_PTRS(super) *
-                                          LINN_SUPER_NUM_PTRS(super)))
+        else if (bytes == 0)
         {
-            blockNr = insertIndirect(&inode->block[LINN_INODE_TIND_BLOCKS-1],
-                                      LINN_INODE_NUM_BLOCKS(super, inode) -
-                                      LINN_INODE_DIR_BLOCKS, 3);
-        }
-        // Maximum file capacity reached
-        else
-        {
-            printf("%s: maximum file size reached for `%s'\n",
-                    prog, inputFile);
             break;
         }
+        total += bytes;
+    }
+    close(fd);
+
+    // Try to compress the contents
+    if (compress && total > 0 && (stored = compressFile(data, total, storedSize)) != ZERO)
+    {
+        inode->flags |= LINN_INODE_COMPRESSED;
 
-        // Read block contents
-        if ((bytes = read(fd, BLOCKPTR(u8, blockNr), super->blockSize)) < 0)
+        if (verbose)
         {
-            printf("%s: failed to read() `%s': %s\n",
-                    prog, inputFile, strerror(errno));
-            exit(EXIT_FAILURE);
+            printf("%s compressed %u -> %u bytes\n", inputFile, (uint) total, (uint) storedSize);
         }
+    }
+    else
+    {
+        storedSize = total;
+    }
 
-        // Increment size appropriately
-        inode->size += bytes;
+    // Insert the stored data into blocks
+    for (Size offset = 0; offset < storedSize; offset += super->blockSize)
+    {
+        const le32 blockNr = insertBlock(inputFile, inode, offset / super->blockSize);
+        const Size blockBytes = storedSize - offset < super->blockSize ?
+                                storedSize - offset : super->blockSize;
+
+        memcpy(BLOCKPTR(u8, blockNr), (stored ? stored : data) + offset, blockBytes);
     }
+
+    // The inode size is the uncompressed file size
+    inode->size = total;
+
     // Cleanup
-    close(fd);
+    if (stored)
+    {
+        delete[] stored;
+    }
+    delete[] data;
 }
 
 void LinnCreate::insertEntry(le32 dirInode, le32 entryInode,
@@ -495,6 +581,11 @@ void LinnCreate::setVerbose(bool newVerbose)
     this->verbose = newVerbose;
 }
 
+void LinnCreate::setCompress(bool newCompress)
+{
+    this->compress = newCompress;
+}
+
 int main(int argc, char **argv)
 {
     LinnCreate fs;
@@ -510,6 +601,7 @@ int main(int argc, char **argv)
                "\r\n"
                " -h           Show this help message.\r\n"
                " -v           Output verbose messages.\r\n"
+               " -c           Store regular files compressed with LZ4.\r\n"
                " -d DIRECTORY Insert files from the given directory into the image\r\n"
                " -e PATTERN   Exclude matching files from the created filesystem\r\n"
                " -b SIZE      Specifies the blocksize in bytes.\r\n"
@@ -536,6 +628,11 @@ int main(int argc, char **argv)
         {
             fs.setVerbose(true);
         }
+        // Compress files
+        else if (!strcmp(argv[i + 2], "-c"))
+        {
+            fs.setCompress(true);
+        }
         // Input directory
         else if (!strcmp(argv[i + 2], "-d") && i < argc - 3)
         {
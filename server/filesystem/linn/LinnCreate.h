@@ -184,6 +184,13 @@ class LinnCreate
      */
     void setVerbose(bool newVerbose);
 
+    /**
+     * Store regular files compressed.
+     *
+     * @param newCompress True to compress files, false to store them raw.
+     */
+    void setCompress(bool newCompress);
+
   private:
 
     /**
@@ -242,6 +249,29 @@ class LinnCreate
     void insertFile(char *inputFile, LinnInode *inode,
                     struct stat *st);
 
+    /**
+     * Allocates a data block for an LinnInode.
+     *
+     * @param inputFile Path to the local file, for error messages.
+     * @param inode Pointer to the inode to allocate a block for.
+     * @param blockIndex Index of the block inside the file.
+     *
+     * @return Block number of the allocated block.
+     */
+    le32 insertBlock(char *inputFile, LinnInode *inode, const le32 blockIndex);
+
+    /**
+     * Compresses file contents in independent LZ4 chunks.
+     *
+     * @param data File contents.
+     * @param size Number of bytes in the file.
+     * @param storedSize On output, number of bytes to store.
+     *
+     * @return Stored data in the LINN_INODE_COMPRESSED format or ZERO
+     *         if the compressed data is not smaller than the original.
+     */
+    u8 * compressFile(const u8 *data, const Size size, Size & storedSize);
+
     /**
      * Inserts an indirect block address.
      *
@@ -275,6 +305,9 @@ class LinnCreate
     /** Output verbose messages. */
     bool verbose;
 
+    /** Store regular files compressed. */
+    bool compress;
+
     /** List of file patterns to ignore. */
     List<String *> excludes;
 
@@ -16,6 +16,10 @@
  */
 
 #include <FreeNOS/User.h>
+#include <ByteOrder.h>
+#include <Log.h>
+#include <MemoryBlock.h>
+#include <Lz4Decompressor.h>
 #include "LinnFileSystem.h"
 #include "LinnFile.h"
 
@@ -25,21 +29,75 @@ LinnFile::LinnFile(LinnFileSystem *fs,
     : File(inode)
     , m_fs(fs)
     , m_inodeData(inodeData)
+    , m_chunk(ZERO)
+    , m_packed(ZERO)
+    , m_chunkNumber(0)
+    , m_chunkValid(false)
 {
+    MemoryBlock::set(&m_tail, 0, sizeof(m_tail));
     m_size   = m_inodeData->size;
     m_access = m_inodeData->mode;
+
+    if (m_inodeData->flags & LINN_INODE_COMPRESSED)
+    {
+        m_chunk  = new u8[LINN_INODE_CHUNK_SIZE];
+        m_packed = new u8[LINN_INODE_CHUNK_SIZE];
+    }
 }
 
 LinnFile::~LinnFile()
 {
+    if (m_chunk)
+    {
+        delete[] m_chunk;
+        delete[] m_packed;
+    }
+
+    // Mappings in other processes keep their own reference to the page
+    if (m_tail.virt)
+    {
+        VMCtl(SELF, Release, &m_tail);
+    }
 }
 
 FileSystem::Result LinnFile::read(IOBuffer & buffer,
                                   Size & size,
                                   const Size offset)
+{
+    Size bytes = size;
+
+    if (m_inodeData->flags & LINN_INODE_COMPRESSED)
+    {
+        return readCompressed(buffer, size, offset);
+    }
+
+    // Respect the inode size.
+    if (offset >= m_inodeData->size)
+    {
+        size = 0;
+        return FileSystem::Success;
+    }
+    else if (bytes > m_inodeData->size - offset)
+    {
+        bytes = m_inodeData->size - offset;
+    }
+
+    if (readStorage(buffer.getBuffer(), bytes, offset) != FileSystem::Success)
+    {
+        return FileSystem::IOError;
+    }
+    buffer.addCount(bytes);
+
+    // Success.
+    size = bytes;
+    return FileSystem::Success;
+}
+
+FileSystem::Result LinnFile::readStorage(u8 *buffer,
+                                         const Size size,
+                                         const Size offset) const
 {
     const LinnSuperBlock *sb = m_fs->getSuperBlock();
-    const Size inodeNumBlocks = LINN_INODE_NUM_BLOCKS(sb, m_inodeData);
     Size bytes = 0, blockNr = 0, blockCount;
     u64 storageOffset, copyOffset = offset;
     Size total = 0;
@@ -56,7 +114,7 @@ FileSystem::Result LinnFile::read(IOBuffer & buffer,
     copyOffset -= sb->blockSize * blockNr;
 
     // Loop all blocks.
-    while (blockNr < inodeNumBlocks && total < size && m_inodeData->size - (offset + total) > 0)
+    while (total < size)
     {
         // Calculate the offset in storage for this block.
         storageOffset = m_fs->getOffsetRange(m_inodeData, blockNr, blockCount);
@@ -64,13 +122,7 @@ FileSystem::Result LinnFile::read(IOBuffer & buffer,
         // Calculate the number of bytes to copy.
         bytes = (blockCount * sb->blockSize) - copyOffset;
 
-        // Respect the inode size.
-        if (bytes > m_inodeData->size - (offset + total))
-        {
-            bytes = m_inodeData->size - (offset + total);
-        }
-
-        // Respect the remote process buffer.
+        // Respect the output buffer.
         if (bytes > size - total)
         {
             bytes = size - total;
@@ -78,11 +130,10 @@ FileSystem::Result LinnFile::read(IOBuffer & buffer,
 
         // Fetch the next block.
         if (m_fs->getStorage()->read(storageOffset + copyOffset,
-                                     buffer.getBuffer() + total, bytes) != FileSystem::Success)
+                                     buffer + total, bytes) != FileSystem::Success)
         {
             return FileSystem::IOError;
         }
-        buffer.addCount(bytes);
 
         // Update state.
         total += bytes;
@@ -90,7 +141,181 @@ FileSystem::Result LinnFile::read(IOBuffer & buffer,
         blockNr += blockCount;
     }
 
-    // Success.
+    return FileSystem::Success;
+}
+
+FileSystem::Result LinnFile::readCompressed(IOBuffer & buffer,
+                                            Size & size,
+                                            const Size offset)
+{
+    Size total = 0;
+
+    while (total < size && offset + total < m_inodeData->size)
+    {
+        const Size position = offset + total;
+        const Size chunk = position / LINN_INODE_CHUNK_SIZE;
+        const Size chunkOffset = position % LINN_INODE_CHUNK_SIZE;
+        const Size chunkSize = m_inodeData->size - (chunk * LINN_INODE_CHUNK_SIZE) < LINN_INODE_CHUNK_SIZE ?
+                               m_inodeData->size - (chunk * LINN_INODE_CHUNK_SIZE) : LINN_INODE_CHUNK_SIZE;
+        Size bytes = chunkSize - chunkOffset;
+
+        // Respect the remote process buffer.
+        if (bytes > size - total)
+        {
+            bytes = size - total;
+        }
+
+        // Decompress the chunk, unless already loaded.
+        if (!m_chunkValid || m_chunkNumber != chunk)
+        {
+            const FileSystem::Result result = loadChunk(chunk);
+            if (result != FileSystem::Success)
+            {
+                return result;
+            }
+        }
+
+        buffer.bufferedWrite(m_chunk + chunkOffset, bytes);
+        total += bytes;
+    }
+
     size = total;
     return FileSystem::Success;
 }
+
+FileSystem::Result LinnFile::loadChunk(const Size chunk)
+{
+    const Size chunkSize = m_inodeData->size - (chunk * LINN_INODE_CHUNK_SIZE) < LINN_INODE_CHUNK_SIZE ?
+                           m_inodeData->size - (chunk * LINN_INODE_CHUNK_SIZE) : LINN_INODE_CHUNK_SIZE;
+    le32 range[2];
+
+    // Find the stored data of this chunk in the offset table.
+    if (readStorage((u8 *) range, sizeof(range), chunk * sizeof(le32)) != FileSystem::Success)
+    {
+        return FileSystem::IOError;
+    }
+
+    const Size storedOffset = readLe32(&range[0]);
+    const Size storedSize = readLe32(&range[1]) - storedOffset;
+
+    if (storedSize > chunkSize)
+    {
+        ERROR("invalid chunk " << chunk << " size " << storedSize << " in inode " << m_inode);
+        return FileSystem::IOError;
+    }
+
+    m_chunkValid = false;
+
+    // Chunks stored with their uncompressed size contain raw data.
+    if (storedSize == chunkSize)
+    {
+        if (readStorage(m_chunk, chunkSize, storedOffset) != FileSystem::Success)
+        {
+            return FileSystem::IOError;
+        }
+    }
+    else
+    {
+        if (readStorage(m_packed, storedSize, storedOffset) != FileSystem::Success)
+        {
+            return FileSystem::IOError;
+        }
+
+        const Lz4Decompressor lz4(m_packed, storedSize);
+        if (lz4.readBlock(m_chunk, chunkSize) != Lz4Decompressor::Success)
+        {
+            ERROR("failed to decompress chunk " << chunk << " in inode " << m_inode);
+            return FileSystem::IOError;
+        }
+    }
+
+    m_chunkNumber = chunk;
+    m_chunkValid = true;
+    return FileSystem::Success;
+}
+
+FileSystem::Result LinnFile::physicalAddress(const Size offset,
+                                             Address & phys)
+{
+    const LinnSuperBlock *sb = m_fs->getSuperBlock();
+    Size blockCount;
+
+    if ((offset & ~PAGEMASK) || offset >= m_inodeData->size)
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    // Compressed file data cannot be mapped
+    if (m_inodeData->flags & LINN_INODE_COMPRESSED)
+    {
+        return FileSystem::NotSupported;
+    }
+
+    // Find the storage blocks of this page
+    const u64 storageOffset = m_fs->getOffsetRange(m_inodeData, offset / sb->blockSize, blockCount);
+    const Size pageBytes = m_inodeData->size - offset < PAGESIZE ?
+                           m_inodeData->size - offset : PAGESIZE;
+
+    // All file data in the page must be stored contiguously
+    if (blockCount * sb->blockSize < pageBytes)
+    {
+        return FileSystem::NotSupported;
+    }
+
+    // The stored page may continue with data of other files
+    if (pageBytes < PAGESIZE)
+    {
+        return tailAddress(offset, phys);
+    }
+
+    const FileSystem::Result result = m_fs->getStorage()->physicalAddress(storageOffset, phys);
+    if (result != FileSystem::Success)
+    {
+        return result;
+    }
+
+    // Only page aligned data can be mapped
+    return (phys & ~PAGEMASK) ? FileSystem::NotSupported : FileSystem::Success;
+}
+
+FileSystem::Result LinnFile::tailAddress(const Size offset,
+                                         Address & phys)
+{
+    if (m_tail.virt == ZERO)
+    {
+        Memory::Range range;
+        range.virt   = ZERO;
+        range.phys   = ZERO;
+        range.size   = PAGESIZE;
+        range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+        API::Result result = VMCtl(SELF, MapContiguous, &range);
+        if (result != API::Success)
+        {
+            ERROR("failed to allocate page using VMCtl: result = " << (int) result);
+            return FileSystem::IOError;
+        }
+
+        result = VMCtl(SELF, LookupVirtual, &range);
+        if (result != API::Success)
+        {
+            ERROR("failed to lookup page address using VMCtl: result = " << (int) result);
+            VMCtl(SELF, Release, &range);
+            return FileSystem::IOError;
+        }
+
+        // Copy the remaining file data, the rest of the page is zero
+        MemoryBlock::set((void *) range.virt, 0, PAGESIZE);
+
+        if (readStorage((u8 *) range.virt, m_inodeData->size - offset, offset) != FileSystem::Success)
+        {
+            VMCtl(SELF, Release, &range);
+            return FileSystem::IOError;
+        }
+
+        m_tail = range;
+    }
+
+    phys = m_tail.phys;
+    return FileSystem::Success;
+}
@@ -69,6 +69,73 @@ class LinnFile : public File
                                     Size & size,
                                     const Size offset);
 
+    /**
+     * Retrieve the physical page containing file data.
+     *
+     * Only succeeds if the storage is memory backed and
+     * the file blocks in the page are contiguous. A partial
+     * last page is copied into a zero filled page, such that
+     * no stored data past the end of the file can be mapped.
+     *
+     * @param offset Page aligned offset inside the file.
+     * @param phys On output, the physical address of the page.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const Size offset,
+                                               Address & phys);
+
+  private:
+
+    /**
+     * Read stored file data.
+     *
+     * @param buffer Output buffer.
+     * @param size Number of bytes to read.
+     * @param offset Offset inside the stored data.
+     *
+     * @return Result code
+     */
+    FileSystem::Result readStorage(u8 *buffer,
+                                   const Size size,
+                                   const Size offset) const;
+
+    /**
+     * Read bytes from a compressed file.
+     *
+     * Only the chunks overlapping the requested range are decompressed.
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Maximum number of bytes to read on input.
+     *             On output, the actual number of bytes read.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Result code
+     */
+    FileSystem::Result readCompressed(IOBuffer & buffer,
+                                      Size & size,
+                                      const Size offset);
+
+    /**
+     * Load a chunk of a compressed file.
+     *
+     * @param chunk Chunk number.
+     *
+     * @return Result code
+     */
+    FileSystem::Result loadChunk(const Size chunk);
+
+    /**
+     * Retrieve the physical address of the copied last page.
+     *
+     * @param offset Page aligned offset of the last page inside the file.
+     * @param phys On output, the physical address of the copy.
+     *
+     * @return Result code
+     */
+    FileSystem::Result tailAddress(const Size offset,
+                                   Address & phys);
+
   private:
 
     /** Filesystem pointer. */
@@ -76,6 +143,21 @@ class LinnFile : public File
 
     /** Inode pointer. */
     LinnInode *m_inodeData;
+
+    /** Uncompressed data of the last loaded chunk, if compressed. */
+    u8 *m_chunk;
+
+    /** Compressed data of a chunk, if compressed. */
+    u8 *m_packed;
+
+    /** Number of the chunk in m_chunk. */
+    Size m_chunkNumber;
+
+    /** True if m_chunk contains valid data. */
+    bool m_chunkValid;
+
+    /** Zero filled copy of the partial last page, if mapped. */
+    Memory::Range m_tail;
 };
 
 /**
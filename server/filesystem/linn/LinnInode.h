@@ -60,6 +60,29 @@
 /** Total number of block pointers in an LinnInode. */
 #define LINN_INODE_BLOCKS       (LINN_INODE_TIND_BLOCKS + 1)
 
+/**
+ * @}
+ */
+
+/**
+ * @name Inode flags.
+ * @{
+ */
+
+/**
+ * File data is stored in independently compressed LZ4 blocks.
+ *
+ * The stored data starts with a table of little-endian 32-bit offsets,
+ * one for each chunk of LINN_INODE_CHUNK_SIZE uncompressed bytes plus
+ * one for the end of the stored data. Each chunk is an LZ4 block, or the
+ * raw data if the chunk is stored using its uncompressed size. The inode
+ * size is the uncompressed size of the file.
+ */
+#define LINN_INODE_COMPRESSED   (1 << 0)
+
+/** Uncompressed size of each chunk in a compressed file. */
+#define LINN_INODE_CHUNK_SIZE   16384
+
 /**
  * @}
  */
@@ -101,6 +124,7 @@ typedef struct LinnInode
     le32 modifyTime;    /**< Modification time. */
     le32 changeTime;    /**< Status change timestamp. */
     le16 links;         /**< Links count. */
+    le16 flags;         /**< Inode flags. */
     le32 block[LINN_INODE_BLOCKS]; /**< Pointers to blocks. */
 }
 LinnInode;
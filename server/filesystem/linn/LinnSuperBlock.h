@@ -52,7 +52,7 @@
 #define LINN_SUPER_MAJOR        1
 
 /** Current minor revision number. */
-#define LINN_SUPER_MINOR        0
+#define LINN_SUPER_MINOR        1
 
 /**
  * @}
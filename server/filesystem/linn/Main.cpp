@@ -19,6 +19,7 @@
 #include <Assert.h>
 #include <KernelLog.h>
 #include <FileStorage.h>
+#include <CachedStorage.h>
 #include <BootImageStorage.h>
 #include <BootSymbolStorage.h>
 #include "LinnFileSystem.h"
@@ -40,8 +41,21 @@ int main(int argc, char **argv)
         const String offsetStr(argv[2], false);
         const Size offset = offsetStr.toLong();
         NOTICE("file storage: " << argv[1] << " at offset " << offset);
-        storage = new FileStorage(argv[1], offset);
-        assert(storage != NULL);
+        FileStorage *file = new FileStorage(argv[1], offset);
+        assert(file != NULL);
+
+        const FileSystem::Result fileResult = file->initialize();
+        if (fileResult != FileSystem::Success)
+        {
+            FATAL("unable to open file storage '" << argv[1] << "': result = " << (int) fileResult);
+        }
+
+        // Cache the file contents to avoid an IPC request for each read
+        CachedStorage *cache = new CachedStorage(file);
+        assert(cache != NULL);
+        cache->initialize();
+
+        storage = cache;
         path = argv[3];
     }
     else
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <Log.h>
+#include <MemoryBlock.h>
+#include "TmpFile.h"
+
+u8 TmpFile::m_zeroPage[PAGESIZE];
+
+TmpFile::TmpFile(const u32 inode)
+    : File(inode, FileSystem::RegularFile)
+{
+    m_access = FileSystem::OwnerRW;
+}
+
+TmpFile::~TmpFile()
+{
+    for (Size i = 0; i < m_pages.count(); i++)
+    {
+        releasePage(i);
+    }
+}
+
+FileSystem::Result TmpFile::read(IOBuffer & buffer,
+                                 Size & size,
+                                 const Size offset)
+{
+    // Bounds checking
+    if (offset >= m_size)
+    {
+        size = 0;
+        return FileSystem::Success;
+    }
+
+    // How much bytes to copy?
+    const Size bytes = m_size - offset > size ? size : m_size - offset;
+
+    // Copy page by page
+    for (Size done = 0; done < bytes;)
+    {
+        const Size pageOffset = (offset + done) % PAGESIZE;
+        const Size chunk = PAGESIZE - pageOffset < bytes - done ?
+                           PAGESIZE - pageOffset : bytes - done;
+        const u8 *page = getPage((offset + done) / PAGESIZE, false);
+
+        const FileSystem::Result result = buffer.write(page ? page + pageOffset : m_zeroPage,
+                                                       chunk, done);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+
+        done += chunk;
+    }
+
+    size = bytes;
+    return FileSystem::Success;
+}
+
+FileSystem::Result TmpFile::write(IOBuffer & buffer,
+                                  Size & size,
+                                  const Size offset)
+{
+    // Copy page by page, allocating pages as needed
+    for (Size done = 0; done < size;)
+    {
+        const Size pageOffset = (offset + done) % PAGESIZE;
+        const Size chunk = PAGESIZE - pageOffset < size - done ?
+                           PAGESIZE - pageOffset : size - done;
+        u8 *page = getPage((offset + done) / PAGESIZE, true);
+
+        if (page == ZERO)
+        {
+            return FileSystem::IOError;
+        }
+
+        const FileSystem::Result result = buffer.read(page + pageOffset, chunk, done);
+        if (result != FileSystem::Success)
+        {
+            return result;
+        }
+
+        done += chunk;
+    }
+
+    if (offset + size > m_size)
+    {
+        m_size = offset + size;
+    }
+
+    return FileSystem::Success;
+}
+
+FileSystem::Result TmpFile::physicalAddress(const Size offset,
+                                            Address & phys)
+{
+    Memory::Range range;
+
+    if ((offset & ~PAGEMASK) || offset >= m_size)
+    {
+        return FileSystem::InvalidArgument;
+    }
+
+    // Holes are filled, such that the page can be mapped
+    u8 *page = getPage(offset / PAGESIZE, true);
+    if (page == ZERO)
+    {
+        return FileSystem::IOError;
+    }
+
+    range.virt = (Address) page;
+
+    const API::Result result = VMCtl(SELF, LookupVirtual, &range);
+    if (result != API::Success)
+    {
+        ERROR("failed to lookup page address using VMCtl: result = " << (int) result);
+        return FileSystem::IOError;
+    }
+
+    phys = range.phys;
+    return FileSystem::Success;
+}
+
+FileSystem::Result TmpFile::truncate(const Size size)
+{
+    const Size pageCount = (size + PAGESIZE - 1) / PAGESIZE;
+
+    // Release all pages beyond the new size
+    while (m_pages.count() > pageCount)
+    {
+        releasePage(m_pages.count() - 1);
+        m_pages.removeAt(m_pages.count() - 1);
+    }
+
+    // Discard data beyond the new size in the last page
+    if (size < m_size && (size % PAGESIZE))
+    {
+        u8 *page = getPage(size / PAGESIZE, false);
+        if (page != ZERO)
+        {
+            MemoryBlock::set(page + (size % PAGESIZE), 0, PAGESIZE - (size % PAGESIZE));
+        }
+    }
+
+    m_size = size;
+    return FileSystem::Success;
+}
+
+u8 * TmpFile::getPage(const Size index, const bool allocate)
+{
+    const Address *entry = m_pages.get(index);
+    Memory::Range range;
+
+    if (entry != ZERO && *entry != ZERO)
+    {
+        return (u8 *) *entry;
+    }
+    else if (!allocate)
+    {
+        return ZERO;
+    }
+
+    // Allocate a new zeroed page
+    range.virt   = ZERO;
+    range.phys   = ZERO;
+    range.size   = PAGESIZE;
+    range.access = Memory::User | Memory::Readable | Memory::Writable;
+
+    const API::Result result = VMCtl(SELF, MapContiguous, &range);
+    if (result != API::Success)
+    {
+        ERROR("failed to allocate page using VMCtl: result = " << (int) result);
+        return ZERO;
+    }
+    MemoryBlock::set((void *) range.virt, 0, PAGESIZE);
+
+    // Mark pages in between as holes
+    for (Size i = m_pages.count(); i < index; i++)
+    {
+        m_pages.insert(i, ZERO);
+    }
+
+    m_pages.insert(index, range.virt);
+    return (u8 *) range.virt;
+}
+
+void TmpFile::releasePage(const Size index)
+{
+    const Address entry = m_pages.at(index);
+    Memory::Range range;
+
+    // Pages mapped by clients stay allocated until their mappings are released
+    if (entry != ZERO)
+    {
+        range.virt = entry;
+        range.size = PAGESIZE;
+
+        const API::Result result = VMCtl(SELF, Release, &range);
+        if (result != API::Success)
+        {
+            ERROR("failed to release page using VMCtl: result = " << (int) result);
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FILESYSTEM_TMPFILE_H
+#define __FILESYSTEM_TMPFILE_H
+
+#include <File.h>
+#include <Vector.h>
+#include <Types.h>
+
+/**
+ * @addtogroup server
+ * @{
+ *
+ * @addtogroup tmpfs
+ * @{
+ */
+
+/**
+ * Regular file in the TmpFileSystem, stored in a list of memory pages.
+ *
+ * Pages are allocated on demand when written, so the file grows in
+ * constant time per page and offsets which are never written (holes)
+ * take no memory and read as zero bytes.
+ *
+ * The pages can be mapped directly into clients for zero-copy reads.
+ * Each client mapping holds its own reference to the page, such that
+ * the page is only freed when the file and all mappings released it.
+ */
+class TmpFile : public File
+{
+  public:
+
+    /**
+     * Constructor function.
+     *
+     * @param inode Inode number
+     */
+    TmpFile(const u32 inode);
+
+    /**
+     * Destructor function.
+     */
+    virtual ~TmpFile();
+
+    /**
+     * Read bytes from the file
+     *
+     * @param buffer Input/Output buffer to output bytes to.
+     * @param size Maximum number of bytes to read on input.
+     *             On output, the actual number of bytes read.
+     * @param offset Offset inside the file to start reading.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result read(IOBuffer & buffer,
+                                    Size & size,
+                                    const Size offset);
+
+    /**
+     * Write bytes to the file
+     *
+     * @param buffer Input/Output buffer to input bytes from.
+     * @param size Maximum number of bytes to write on input.
+     *             On output, the actual number of bytes written.
+     * @param offset Offset inside the file to start writing.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result write(IOBuffer & buffer,
+                                     Size & size,
+                                     const Size offset);
+
+    /**
+     * Retrieve the physical page containing file data.
+     *
+     * @param offset Page aligned offset inside the file.
+     * @param phys On output, the physical address of the page.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result physicalAddress(const Size offset,
+                                               Address & phys);
+
+    /**
+     * Change the size of the file.
+     *
+     * @param size New size of the file in bytes.
+     *
+     * @return Result code
+     */
+    virtual FileSystem::Result truncate(const Size size);
+
+  private:
+
+    /**
+     * Get the page at the given index.
+     *
+     * @param index Page index in the file
+     * @param allocate True to allocate the page if not present
+     *
+     * @return Virtual address of the page or ZERO if not present.
+     */
+    u8 * getPage(const Size index, const bool allocate);
+
+    /**
+     * Release the page at the given index.
+     *
+     * @param index Page index in the file
+     */
+    void releasePage(const Size index);
+
+  private:
+
+    /** Page entries, indexed by page number. ZERO for holes. */
+    Vector<Address> m_pages;
+
+    /** Contains zero bytes for reading holes. */
+    static u8 m_zeroPage[PAGESIZE];
+};
+
+/**
+ * @}
+ * @}
+ */
+
+#endif /* __FILESYSTEM_TMPFILE_H */
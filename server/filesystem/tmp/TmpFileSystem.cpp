@@ -17,8 +17,8 @@
 
 #include <Assert.h>
 #include <File.h>
-#include <PseudoFile.h>
 #include <Directory.h>
+#include "TmpFile.h"
 #include "TmpFileSystem.h"
 
 TmpFileSystem::TmpFileSystem(const char *path)
@@ -32,7 +32,7 @@ File * TmpFileSystem::createFile(const FileSystem::FileType type)
     switch (type)
     {
         case FileSystem::RegularFile: {
-            PseudoFile *file = new PseudoFile(getNextInode());
+            TmpFile *file = new TmpFile(getNextInode());
             assert(file != NULL);
             return file;
         }
@@ -24,6 +24,8 @@ int main(int argc, char **argv)
 
     while (true)
     {
-        idle();
+        // Prepare zeroed pages for the kernel before waiting for interrupts
+        if (PrivExec(ZeroPages) != API::Success)
+            idle();
     }
 }
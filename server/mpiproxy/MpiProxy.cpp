@@ -654,9 +654,9 @@ MpiProxy::Result MpiProxy::startRemoteProcess(const Size coreId,
     // Prepare full path to the program to start
     programPath << "/bin/" << *programArgs[0];
 
-    // Try to read the raw ELF program data (compressed)
+    // Try to map the raw ELF program data (compressed)
     BufferedFile programFile(*programPath);
-    const BufferedFile::Result readResult = programFile.read();
+    const BufferedFile::Result readResult = programFile.map();
     if (readResult != BufferedFile::Success)
     {
         ERROR("failed to read program at path '" << *programPath <<
@@ -47,6 +47,7 @@ Keyboard::Keyboard(const u32 inode)
     , shiftState(ZERO)
 {
     m_identifier << "keyboard0";
+    m_notifying = FileSystem::Readable;
 }
 
 FileSystem::Result Keyboard::initialize()
@@ -57,6 +58,7 @@ FileSystem::Result Keyboard::initialize()
 FileSystem::Result Keyboard::interrupt(const Size vector)
 {
     pending = true;
+    notifyReadable();
     return FileSystem::Success;
 }
 
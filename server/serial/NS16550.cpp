@@ -79,6 +79,7 @@ FileSystem::Result NS16550::interrupt(const Size vector)
 {
     // Mask interrupt until FIFOs are empty
     m_io.write(InterruptEnable, 0);
+    notifyReadable();
     return FileSystem::Success;
 }
 
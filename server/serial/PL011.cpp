@@ -96,6 +96,9 @@ FileSystem::Result PL011::interrupt(const Size vector)
     if (mis & PL011_MIS_TXMIS)
         m_io.write(PL011_ICR, PL011_ICR_TXIC);
 
+    // Wakeup blocked readers
+    notifyReadable();
+
     // Re-enable interrupts
     if (!isKernel)
     {
@@ -24,6 +24,7 @@ SerialDevice::SerialDevice(const u32 irq)
     , AbstractFactory<SerialDevice>()
     , m_irq(irq)
 {
+    m_notifying = FileSystem::Readable;
 }
 
 u32 SerialDevice::getIrq() const
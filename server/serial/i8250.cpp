@@ -71,6 +71,7 @@ FileSystem::Result i8250::initialize()
 
 FileSystem::Result i8250::interrupt(const Size vector)
 {
+    notifyReadable();
     ProcessCtl(SELF, EnableIRQ, m_irq);
     return FileSystem::Success;
 }
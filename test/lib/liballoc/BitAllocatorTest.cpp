@@ -321,3 +321,65 @@ TestCase(BitRelease)
     testAssert(args.address == range.address + rangeSize - chunkSize);
     return OK;
 }
+
+TestCase(BitAllocateFragmented)
+{
+    const Size chunkCount = 1024 * 256;
+    const Size usedCount = chunkCount - (chunkCount / 8);
+    const Size iterations = 16;
+    const Allocator::Range range = { 0x10000000, chunkCount * PAGESIZE, sizeof(u32) };
+    u8 *bitmap = new u8[chunkCount / 8];
+
+    // The summary bitmap is only kept for an internally allocated array
+    BitAllocator hierarchical(range, PAGESIZE);
+    BitAllocator flat(range, PAGESIZE, bitmap);
+    BitAllocator *allocators[] = { &hierarchical, &flat };
+
+    testAssert(hierarchical.m_array.m_summary != ZERO);
+    testAssert(flat.m_array.m_summary == ZERO);
+
+    for (Size i = 0; i < 2; i++)
+    {
+        BitAllocator *ba = allocators[i];
+        Allocator::Range args = { 0, usedCount * PAGESIZE, 0 };
+
+        // Fill most of the range and fragment the rest, except for the last chunks
+        testAssert(ba->allocateFrom(args, 0) == Allocator::Success);
+        testAssert(args.address == range.address);
+
+        for (Size j = usedCount + 1; j < chunkCount - 1024; j += 2)
+        {
+            testAssert(ba->allocateAt(range.address + (j * PAGESIZE)) == Allocator::Success);
+        }
+
+        // Repeatedly search from the start for a single chunk and a run of chunks
+        for (Size j = 0; j < iterations; j++)
+        {
+            Allocator::Range single = { 0, PAGESIZE, 0 };
+            Allocator::Range run = { 0, PAGESIZE * 16, PAGESIZE * 16 };
+
+            testAssert(ba->allocateFrom(single, 0) == Allocator::Success);
+            testAssert(single.address == range.address + (usedCount * PAGESIZE));
+            testAssert(ba->allocateFrom(run, 0) == Allocator::Success);
+            testAssert(run.address >= range.address + ((chunkCount - 1024) * PAGESIZE));
+            testAssert(ba->release(single.address) == Allocator::Success);
+
+            for (Size k = 0; k < 16; k++)
+            {
+                testAssert(ba->release(run.address + (k * PAGESIZE)) == Allocator::Success);
+            }
+        }
+    }
+
+    // Both must end up in the same state
+    testAssert(hierarchical.available() == flat.available());
+
+    for (Size i = 0; i < chunkCount; i += 997)
+    {
+        testAssert(hierarchical.isAllocated(range.address + (i * PAGESIZE)) ==
+                   flat.isAllocated(range.address + (i * PAGESIZE)));
+    }
+
+    delete[] bitmap;
+    return OK;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2020 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/Constant.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <Assert.h>
+#include <MemoryBlock.h>
+#include <PoolAllocator.h>
+#include <SlabAllocator.h>
+
+#if HEAP_PROFILE
+
+/**
+ * Simple wrapper around the default new/delete operators.
+ *
+ * This construction allows the host OS to use its own
+ * allocation operators, which can be validated using
+ * dynamic analysis tools like valgrind.
+ *
+ * @see http://www.valgrind.org
+ */
+class DummyParent : public Allocator
+{
+    virtual Result allocate(Range & args)
+    {
+        u8 *buf = new u8[args.size];
+        assert(buf != ZERO);
+        MemoryBlock::set(buf, 0, args.size);
+        args.address = (Address) buf;
+        return args.address != ZERO ? Success : OutOfMemory;
+    }
+
+    virtual Result release(const Address addr)
+    {
+        delete[] (u8 *) addr;
+        return Success;
+    }
+};
+
+/**
+ * Verify the heap profile statistics of a profiling allocator.
+ *
+ * @param alloc Empty allocator which records a heap profile
+ *
+ * @return Test result
+ */
+static TestResult testProfile(Allocator & alloc)
+{
+    Allocator::ProfileSite sites[4];
+    Allocator::Range args = { 0, 64, 0 };
+    Address objects[3];
+    Address other;
+
+    // No allocation sites yet
+    testAssert(alloc.profile(sites, 4) == 0);
+
+    // Allocations from the same call site share one entry
+    for (Size i = 0; i < 3; i++)
+    {
+        args.size = 64;
+        testAssert(alloc.allocate(args) == Allocator::Success);
+        objects[i] = args.address;
+    }
+    testAssert(alloc.profile(sites, 4) == 1);
+    testAssert(sites[0].caller != ZERO);
+    testAssert(sites[0].sizeClass > 64);
+    testAssert(sites[0].count == 3);
+    testAssert(sites[0].live == 192);
+    testAssert(sites[0].peak == 192);
+
+    // Another call site has its own entry
+    args.size = 16;
+    testAssert(alloc.allocate(args) == Allocator::Success);
+    other = args.address;
+    testAssert(alloc.profile(sites, 4) == 2);
+    testAssert(alloc.profile(sites, 1) == 1);
+
+    // Shrinking and releasing lowers the live bytes, but not the peak
+    args.address = objects[0];
+    args.size = 32;
+    testAssert(alloc.reallocate(args) == Allocator::Success);
+    testAssert(args.address == objects[0]);
+    testAssert(alloc.release(objects[1]) == Allocator::Success);
+    testAssert(alloc.profile(sites, 4) == 2);
+
+    for (Size i = 0; i < 2; i++)
+    {
+        if (sites[i].count == 3)
+        {
+            testAssert(sites[i].live == 96);
+            testAssert(sites[i].peak == 192);
+        }
+        else
+        {
+            testAssert(sites[i].count == 1);
+            testAssert(sites[i].live == 16);
+        }
+    }
+
+    // Releasing all objects leaves no live bytes
+    testAssert(alloc.release(objects[0]) == Allocator::Success);
+    testAssert(alloc.release(objects[2]) == Allocator::Success);
+    testAssert(alloc.release(other) == Allocator::Success);
+    testAssert(alloc.profile(sites, 4) == 2);
+    testAssert(sites[0].live == 0);
+    testAssert(sites[1].live == 0);
+    return OK;
+}
+
+#endif /* HEAP_PROFILE */
+
+TestCase(PoolProfile)
+{
+#if HEAP_PROFILE
+    DummyParent parent;
+    PoolAllocator pa(&parent);
+
+    return testProfile(pa);
+#else
+    return SKIP;
+#endif /* HEAP_PROFILE */
+}
+
+TestCase(SlabProfile)
+{
+#if HEAP_PROFILE
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+
+    return testProfile(sa);
+#else
+    return SKIP;
+#endif /* HEAP_PROFILE */
+}
@@ -317,3 +317,45 @@ TestCase(PoolObjectCount)
 
     return OK;
 }
+
+TestCase(PoolReallocate)
+{
+    DummyParent parent;
+    PoolAllocator pa(&parent);
+    Allocator::Range args = { 0, 64, 0 };
+
+    // Allocate an object in the 128 bytes pool
+    testAssert(pa.allocate(args) == Allocator::Success);
+    testAssert(pa.usableSize(args.address) == 64);
+    MemoryBlock::set((void *) args.address, 0xaa, 64);
+
+    // Grow within the same pool keeps the address
+    const Address original = args.address;
+    args.size = 96;
+    testAssert(pa.reallocate(args) == Allocator::Success);
+    testAssert(args.address == original);
+    testAssert(pa.usableSize(args.address) == 96);
+
+    // Shrinking never moves the object
+    args.size = 32;
+    testAssert(pa.reallocate(args) == Allocator::Success);
+    testAssert(args.address == original);
+
+    // Growing beyond the pool fails if moving is not allowed
+    args.size = 512;
+    testAssert(pa.reallocate(args, false) == Allocator::OutOfMemory);
+    testAssert(args.address == original);
+
+    // Otherwise the contents are copied to a larger object
+    testAssert(pa.reallocate(args) == Allocator::Success);
+    testAssert(args.address != original);
+    testAssert(pa.usableSize(args.address) == 512);
+
+    for (Size i = 0; i < 32; i++)
+    {
+        testAssert(((u8 *) args.address)[i] == 0xaa);
+    }
+
+    testAssert(pa.release(args.address) == Allocator::Success);
+    return OK;
+}
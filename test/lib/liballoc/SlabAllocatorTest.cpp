@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/Constant.h>
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <Assert.h>
+#include <MemoryBlock.h>
+#include <Vector.h>
+#include <BubbleAllocator.h>
+#include <SlabAllocator.h>
+
+/**
+ * Simple wrapper around the default new/delete operators.
+ *
+ * This construction allows the host OS to use its own
+ * allocation operators, which can be validated using
+ * dynamic analysis tools like valgrind.
+ *
+ * @see http://www.valgrind.org
+ */
+class DummyParent : public Allocator
+{
+    virtual Result allocate(Range & args)
+    {
+        u8 *buf = new u8[args.size];
+        assert(buf != ZERO);
+        MemoryBlock::set(buf, 0, args.size);
+        args.address = (Address) buf;
+        return args.address != ZERO ? Success : OutOfMemory;
+    }
+
+    virtual Result release(const Address addr)
+    {
+        delete[] (u8 *) addr;
+        return Success;
+    }
+};
+
+TestCase(SlabConstruct)
+{
+    TestInt<uint> addresses(UINT_MIN, UINT_MAX);
+    const Size rangeSize = PAGESIZE * 64;
+    const Allocator::Range range = { addresses.random(), rangeSize, sizeof(u32) };
+
+    BubbleAllocator bubble(range);
+    SlabAllocator sa(&bubble);
+
+    // Verify initial state after construction
+    testAssert(sa.parent() == &bubble);
+    testAssert(sa.base() == ZERO);
+    testAssert(sa.available() == 0);
+    testAssert(sa.size() == 0);
+    testAssert(sa.alignment() == 0);
+
+    for (Size i = 0; i <= SlabAllocator::MaximumObjectSize; i++)
+    {
+        testAssert(sa.m_slabs[i] == ZERO);
+    }
+
+    return OK;
+}
+
+TestCase(SlabUsage)
+{
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+
+    // Verify that the calculated total size and used bytes is correct
+    testAssert(sa.size() == 0);
+    testAssert(sa.available() == 0);
+
+    Allocator::Range args = { 0, sizeof(u32), 0 };
+    testAssert(sa.allocate(args) == Allocator::Success);
+
+    testAssert(sa.size() > 0);
+    testAssert(sa.available() > 0);
+    testAssert(sa.available() < sa.size());
+
+    // The first slab of a size class is kept after release
+    const Size slabSize = sa.size();
+    const Size slabAvailable = sa.available();
+    testAssert(sa.release(args.address) == Allocator::Success);
+    testAssert(sa.size() == slabSize);
+    testAssert(sa.available() > slabAvailable);
+
+    return OK;
+}
+
+TestCase(SlabInvalidArgs)
+{
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+
+    // Zero sized objects are rejected
+    Allocator::Range args = { 0, 0, 0 };
+    testAssert(sa.allocate(args) == Allocator::InvalidSize);
+
+    // Alignment is not supported
+    args.size = 64;
+    args.alignment = sizeof(u32);
+    testAssert(sa.allocate(args) == Allocator::InvalidAlignment);
+
+    // Objects beyond the largest size class cannot be allocated
+    args.size = MegaByte(128);
+    args.alignment = 0;
+    testAssert(sa.allocate(args) == Allocator::OutOfMemory);
+    testAssert(args.address == ZERO);
+    testAssert(sa.size() == 0);
+
+    return OK;
+}
+
+TestCase(SlabAllocate)
+{
+    const Size bubbleSize = PAGESIZE * 128;
+    const Address bubbleBase = (Address) (new u8[bubbleSize]);
+    const Allocator::Range bubbleRange = { bubbleBase, bubbleSize, sizeof(u32) };
+
+    BubbleAllocator bubble(bubbleRange);
+    SlabAllocator sa(&bubble);
+    Address previous = ZERO;
+
+    for (Size i = 0; i < 100; i++)
+    {
+        Allocator::Range args = { 0, 64, 0 };
+
+        // Perform the allocation
+        testAssert(sa.allocate(args) == Allocator::Success);
+        testAssert(args.alignment == 0);
+        testAssert(args.size == 64);
+        testAssert(args.address > bubbleBase);
+        testAssert(args.address < bubbleBase + bubbleSize);
+
+        // Check only the appropriate size class has a slab
+        for (Size j = 0; j <= SlabAllocator::MaximumObjectSize; j++)
+        {
+            if (j == 7) {
+                testAssert(sa.m_slabs[j] != ZERO);
+            } else {
+                testAssert(sa.m_slabs[j] == ZERO);
+            }
+        }
+
+        // Objects are handed out in increasing order
+        if (previous != ZERO)
+        {
+            testAssert(args.address == previous + (1U << 7));
+        }
+        previous = args.address;
+    }
+
+    delete[] (u8 *) bubbleBase;
+    return OK;
+}
+
+TestCase(SlabReuse)
+{
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+    Allocator::Range first = { 0, 100, 0 };
+    Allocator::Range second = { 0, 100, 0 };
+    Allocator::Range third = { 0, 100, 0 };
+
+    testAssert(sa.allocate(first) == Allocator::Success);
+    testAssert(sa.allocate(second) == Allocator::Success);
+    testAssert(first.address != second.address);
+
+    // The most recently released object is returned first
+    testAssert(sa.release(first.address) == Allocator::Success);
+    testAssert(sa.allocate(third) == Allocator::Success);
+    testAssert(third.address == first.address);
+
+    testAssert(sa.release(second.address) == Allocator::Success);
+    testAssert(sa.release(third.address) == Allocator::Success);
+    return OK;
+}
+
+TestCase(SlabFull)
+{
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+    Vector<Address> objects;
+    const Size index = 10;
+    Allocator::Range args = { 0, 512, 0 };
+
+    // Fill the first slab of the size class
+    testAssert(sa.allocate(args) == Allocator::Success);
+    objects.insert(args.address);
+
+    SlabAllocator::Slab *slab = sa.m_slabs[index];
+    testAssert(slab != ZERO);
+    testAssert(slab->count > 1);
+
+    for (Size i = 1; i < slab->count; i++)
+    {
+        testAssert(sa.allocate(args) == Allocator::Success);
+        objects.insert(args.address);
+    }
+
+    // A full slab is removed from the free list
+    testAssert(slab->used == slab->count);
+    testAssert(sa.m_slabs[index] == ZERO);
+    const Size slabSize = sa.size();
+
+    // The next allocation creates a second slab
+    testAssert(sa.allocate(args) == Allocator::Success);
+    testAssert(sa.m_slabs[index] != ZERO);
+    testAssert(sa.m_slabs[index] != slab);
+    testAssert(sa.size() == slabSize * 2);
+
+    // Releasing an object from the full slab puts it back on the list
+    testAssert(sa.release(objects[0]) == Allocator::Success);
+    testAssert(sa.m_slabs[index] == slab);
+    testAssert(slab->next != ZERO);
+
+    // An empty slab is released when the size class has other slabs
+    testAssert(sa.release(args.address) == Allocator::Success);
+    testAssert(sa.size() == slabSize);
+    testAssert(sa.m_slabs[index] == slab);
+    testAssert(slab->next == ZERO);
+
+    for (Size i = 1; i < objects.count(); i++)
+    {
+        testAssert(sa.release(objects[i]) == Allocator::Success);
+    }
+    testAssert(slab->used == 0);
+    testAssert(sa.m_slabs[index] == slab);
+
+    return OK;
+}
+
+TestCase(SlabRelease)
+{
+    const Size numObjects = 2000;
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+    Vector<u8 *> objects;
+    TestInt<uint> sizes(1, 256);
+    TestInt<Size> indexes(0, numObjects);
+
+    // Randomly allocate many objects of sizes ranging from 4 bytes to 1K
+    for (Size i = 0; i < numObjects; i++)
+    {
+        const Size objectSize = sizes.random() * sizeof(u32);
+        Allocator::Range args = { 0, objectSize, 0 };
+
+        testAssert(sa.allocate(args) == Allocator::Success);
+        testAssert(args.address != ZERO);
+        testAssert(args.size == objectSize);
+
+        // Fill the object to detect overlapping allocations
+        MemoryBlock::set((void *) args.address, i & 0xff, objectSize);
+        objects.insert((u8 *)(args.address));
+    }
+
+    // Generate index numbers in randomized order
+    indexes.unique(numObjects);
+
+    // Release all objects in randomized order
+    for (Size i = 0; i < objects.count(); i++)
+    {
+        testAssert(sa.release((Address)(objects[indexes[i]])) == Allocator::Success);
+    }
+
+    // Only a single empty slab per size class remains
+    for (Size i = 0; i <= SlabAllocator::MaximumObjectSize; i++)
+    {
+        if (sa.m_slabs[i] != ZERO)
+        {
+            testAssert(sa.m_slabs[i]->used == 0);
+            testAssert(sa.m_slabs[i]->next == ZERO);
+        }
+    }
+
+    return OK;
+}
+
+TestCase(SlabReallocate)
+{
+    DummyParent parent;
+    SlabAllocator sa(&parent);
+    Allocator::Range args = { 0, 64, 0 };
+
+    // Allocate an object in the 128 bytes size class
+    testAssert(sa.allocate(args) == Allocator::Success);
+    testAssert(sa.usableSize(args.address) == 64);
+    MemoryBlock::set((void *) args.address, 0x55, 64);
+
+    // Grow within the same size class keeps the address
+    const Address original = args.address;
+    args.size = 100;
+    testAssert(sa.reallocate(args) == Allocator::Success);
+    testAssert(args.address == original);
+    testAssert(sa.usableSize(args.address) == 100);
+
+    // Growing beyond the size class fails if moving is not allowed
+    args.size = 1000;
+    testAssert(sa.reallocate(args, false) == Allocator::OutOfMemory);
+    testAssert(args.address == original);
+
+    // Otherwise the contents are copied to a larger object
+    testAssert(sa.reallocate(args) == Allocator::Success);
+    testAssert(args.address != original);
+    testAssert(sa.usableSize(args.address) == 1000);
+
+    for (Size i = 0; i < 64; i++)
+    {
+        testAssert(((u8 *) args.address)[i] == 0x55);
+    }
+
+    testAssert(sa.release(args.address) == Allocator::Success);
+    return OK;
+}
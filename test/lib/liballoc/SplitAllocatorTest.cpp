@@ -20,6 +20,7 @@
 #include <TestRunner.h>
 #include <TestInt.h>
 #include <TestMain.h>
+#include <MemoryBlock.h>
 #include <SplitAllocator.h>
 
 TestCase(SplitConstruct)
@@ -163,9 +164,153 @@ TestCase(SplitAllocateRelease)
     testAssert(sa.allocate(args) == Allocator::Success);
     testAssert(args.size == PAGESIZE);
 
-    // With the BitAllocator, the search for the allocation address
-    // begins at the last succesfully allocated address. In this case,
-    // that is the last page.
+    // Released pages are kept in the page cache and handed
+    // out again in reverse order. In this case, that is the last page.
     testAssert(args.address == physBase + allocSize - PAGESIZE);
     return OK;
 }
+
+TestCase(SplitAllocateShared)
+{
+    TestInt<uint> physAddresses((UINT_MAX/2) + 1, UINT_MAX);
+    TestInt<uint> virtAddresses(UINT_MAX/4, UINT_MAX/2);
+    const Address physBase = physAddresses.random() & PAGEMASK;
+    const Address virtBase = virtAddresses.random() & PAGEMASK;
+    const Size allocSize = 4 * PAGESIZE;
+
+    const Allocator::Range physRange = { physBase, allocSize, PAGESIZE };
+    const Allocator::Range virtRange = { virtBase, allocSize, PAGESIZE };
+    SplitAllocator sa(physRange, virtRange, PAGESIZE);
+    Allocator::Range args = { 0, PAGESIZE, 0 };
+
+    // Free pages cannot be shared
+    testAssert(sa.getReferenceCount(physBase) == 0);
+    testAssert(sa.reference(physBase) == Allocator::InvalidAddress);
+
+    // Share a single page three times
+    testAssert(sa.allocate(args) == Allocator::Success);
+    testAssert(sa.getReferenceCount(args.address) == 1);
+    testAssert(sa.reference(args.address) == Allocator::Success);
+    testAssert(sa.reference(args.address + 16) == Allocator::Success);
+    testAssert(sa.getReferenceCount(args.address) == 3);
+    testAssert(sa.available() == allocSize - PAGESIZE);
+
+    // Page stays allocated until the last reference is released
+    testAssert(sa.release(args.address) == Allocator::Success);
+    testAssert(sa.release(args.address) == Allocator::Success);
+    testAssert(sa.isAllocated(args.address));
+    testAssert(sa.getReferenceCount(args.address) == 1);
+    testAssert(sa.available() == allocSize - PAGESIZE);
+
+    testAssert(sa.release(args.address) == Allocator::Success);
+    testAssert(!sa.isAllocated(args.address));
+    testAssert(sa.getReferenceCount(args.address) == 0);
+    testAssert(sa.available() == allocSize);
+    return OK;
+}
+
+TestCase(SplitPageCache)
+{
+    TestInt<uint> physAddresses((UINT_MAX/2) + 1, UINT_MAX);
+    TestInt<uint> virtAddresses(UINT_MAX/4, UINT_MAX/2);
+    const Address physBase = physAddresses.random() & PAGEMASK;
+    const Address virtBase = virtAddresses.random() & PAGEMASK;
+    const Size allocSize = 64 * PAGESIZE;
+
+    const Allocator::Range physRange = { physBase, allocSize, PAGESIZE };
+    const Allocator::Range virtRange = { virtBase, allocSize, PAGESIZE };
+    SplitAllocator sa(physRange, virtRange, PAGESIZE);
+    Allocator::Range args = { 0, PAGESIZE, 0 };
+
+    // The first allocation moves a batch of pages into the cache
+    testAssert(sa.allocate(args) == Allocator::Success);
+    testAssert(args.address == physBase);
+    testAssert(sa.m_pageCacheCount == SplitAllocator::PageCacheBatch - 1);
+    testAssert(sa.m_alloc.available() == allocSize - (SplitAllocator::PageCacheBatch * PAGESIZE));
+    testAssert(sa.available() == allocSize - PAGESIZE);
+
+    // Cached pages are free
+    testAssert(sa.isAllocated(physBase));
+    testAssert(!sa.isAllocated(physBase + PAGESIZE));
+    testAssert(sa.getReferenceCount(physBase + PAGESIZE) == 0);
+
+    // A released page goes back into the cache and cannot be released twice
+    testAssert(sa.release(physBase) == Allocator::Success);
+    testAssert(sa.m_pageCacheCount == SplitAllocator::PageCacheBatch);
+    testAssert(sa.release(physBase) == Allocator::InvalidAddress);
+    testAssert(sa.available() == allocSize);
+
+    // Allocating a cached page at a fixed address takes it out of the cache
+    testAssert(sa.allocate(physBase + (2 * PAGESIZE)) == Allocator::Success);
+    testAssert(sa.isAllocated(physBase + (2 * PAGESIZE)));
+    testAssert(sa.m_pageCacheCount == SplitAllocator::PageCacheBatch - 1);
+    testAssert(sa.release(physBase + (2 * PAGESIZE)) == Allocator::Success);
+
+    // Contiguous allocations can use the cached pages
+    Allocator::Range big = { 0, allocSize, PAGESIZE };
+    testAssert(sa.allocate(big) == Allocator::Success);
+    testAssert(big.address == physBase);
+    testAssert(sa.m_pageCacheCount == 0);
+    testAssert(sa.available() == 0);
+
+    // Filling the cache returns the oldest batch to the BitAllocator
+    for (Size i = 0; i < SplitAllocator::PageCacheSize + 1; i++)
+    {
+        testAssert(sa.release(physBase + (i * PAGESIZE)) == Allocator::Success);
+    }
+    testAssert(sa.m_pageCacheCount == SplitAllocator::PageCacheSize - SplitAllocator::PageCacheBatch + 1);
+    testAssert(sa.m_alloc.available() == SplitAllocator::PageCacheBatch * PAGESIZE);
+    testAssert(!sa.m_alloc.isAllocated(physBase));
+    testAssert(sa.m_alloc.isAllocated(physBase + (SplitAllocator::PageCacheBatch * PAGESIZE)));
+    testAssert(sa.available() == (SplitAllocator::PageCacheSize + 1) * PAGESIZE);
+
+    return OK;
+}
+
+TestCase(SplitZeroPool)
+{
+    static u8 memory[8 * PAGESIZE] __attribute__((aligned(PAGESIZE)));
+    const Address physBase = (Address) memory;
+    const Size allocSize = sizeof(memory);
+
+    // Identity mapped, such that zeroed pages can be inspected
+    const Allocator::Range physRange = { physBase, allocSize, PAGESIZE };
+    const Allocator::Range virtRange = { physBase, allocSize, PAGESIZE };
+    SplitAllocator sa(physRange, virtRange, PAGESIZE);
+    Allocator::Range phys = { 0, PAGESIZE, PAGESIZE };
+    Allocator::Range virt;
+
+    MemoryBlock::set(memory, 0xaa, sizeof(memory));
+
+    // Zeroing pages keeps them free
+    testAssert(sa.zeroPages(2) == 2);
+    testAssert(sa.m_zeroPoolCount == 2);
+    testAssert(sa.available() == allocSize);
+    testAssert(!sa.isAllocated(physBase));
+    testAssert(memory[0] == 0 && memory[PAGESIZE - 1] == 0);
+    testAssert(memory[PAGESIZE] == 0 && memory[(2 * PAGESIZE) - 1] == 0);
+    testAssert(memory[2 * PAGESIZE] == 0xaa);
+
+    // Zeroed allocations are taken from the pool
+    testAssert(sa.allocateZeroed(phys, virt) == Allocator::Success);
+    testAssert(phys.address == physBase + PAGESIZE);
+    testAssert(virt.address == sa.toVirtual(phys.address));
+    testAssert(sa.m_zeroPoolCount == 1);
+    testAssert(sa.isAllocated(phys.address));
+
+    // Without zeroed pages the memory is zeroed on allocation
+    testAssert(sa.allocateZeroed(phys, virt) == Allocator::Success);
+    testAssert(sa.allocateZeroed(phys, virt) == Allocator::Success);
+    testAssert(phys.address == physBase + (2 * PAGESIZE));
+    testAssert(memory[2 * PAGESIZE] == 0 && memory[(3 * PAGESIZE) - 1] == 0);
+    testAssert(memory[3 * PAGESIZE] == 0xaa);
+
+    // Zeroed pages are used when nothing else is left
+    testAssert(sa.zeroPages(64) == 5);
+    testAssert(sa.m_pageCacheCount == 0);
+    testAssert(sa.allocate(phys) == Allocator::Success);
+    testAssert(sa.m_zeroPoolCount == 4);
+    testAssert(sa.available() == 4 * PAGESIZE);
+
+    return OK;
+}
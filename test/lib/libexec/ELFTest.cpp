@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestRunner.h>
+#include <TestCase.h>
+#include <TestMain.h>
+#include <BufferedFile.h>
+#include <Lz4Decompressor.h>
+#include <ExecutableFormat.h>
+
+/**
+ * Check that a user program has separate code and writable data segments.
+ *
+ * @param path Path to the compressed program on the root filesystem
+ *
+ * @return Test result
+ */
+static TestResult checkUserSegments(const char *path)
+{
+    BufferedFile file(path);
+    ExecutableFormat *fmt;
+    ExecutableFormat::Region regions[16];
+    Size count = 16;
+    Size code = 0, data = 0;
+
+    if (file.read() != BufferedFile::Success)
+    {
+        ERROR("failed to read program " << path);
+        return SKIP;
+    }
+
+    // Programs are installed LZ4 compressed
+    Lz4Decompressor lz4(file.buffer(), file.size());
+    testAssert(lz4.initialize() == Lz4Decompressor::Success);
+
+    const Size imageSize = lz4.getUncompressedSize();
+    u8 *image = new u8[imageSize];
+    testAssert(image != ZERO);
+    testAssert(lz4.read(image, imageSize) == Lz4Decompressor::Success);
+
+    testAssert(ExecutableFormat::find(image, imageSize, &fmt) == ExecutableFormat::Success);
+    testAssert(fmt->regions(regions, &count) == ExecutableFormat::Success);
+
+    // No segment may be both writable and executable
+    for (Size i = 0; i < count; i++)
+    {
+        const bool writable   = regions[i].access & Memory::Writable;
+        const bool executable = regions[i].access & Memory::Executable;
+
+        testAssert(!(writable && executable));
+
+        if (executable)
+            code++;
+        else if (writable)
+            data++;
+    }
+    testAssert(code >= 1);
+    testAssert(data >= 1);
+
+    delete fmt;
+    delete[] image;
+    return OK;
+}
+
+TestCase(ELFUserSegmentsServer)
+{
+    return checkUserSegments("/server/serial/server");
+}
+
+TestCase(ELFUserSegmentsProgram)
+{
+    return checkUserSegments("/bin/ls/ls");
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestCase.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <Lz4Compressor.h>
+#include <Lz4Decompressor.h>
+
+/**
+ * Compress the given data and decompress it again.
+ *
+ * @param data Input data
+ * @param size Number of bytes of input
+ * @param compressedSize On output, number of compressed bytes
+ *
+ * @return True if the decompressed data equals the input
+ */
+static bool roundTrip(const u8 *data, const Size size, Size & compressedSize)
+{
+    Lz4Compressor compressor(data, size);
+    compressedSize = compressor.getMaximumSize();
+    u8 *compressed = new u8[compressedSize];
+    u8 *output = new u8[size + 1];
+    bool equal = false;
+
+    if (compressor.compressBlock(compressed, compressedSize) == Lz4Compressor::Success)
+    {
+        Lz4Decompressor decompressor(compressed, compressedSize);
+
+        if (decompressor.readBlock(output, size) == Lz4Decompressor::Success)
+        {
+            equal = MemoryBlock::compare(data, output, size);
+        }
+    }
+
+    delete[] compressed;
+    delete[] output;
+    return equal;
+}
+
+TestCase(Lz4CompressSmall)
+{
+    const u8 data[] = { 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a' };
+    Size compressedSize;
+
+    // Small inputs are stored as literals only
+    testAssert(roundTrip(data, sizeof(data), compressedSize));
+    testAssert(compressedSize == sizeof(data) + 1);
+
+    // Output buffer must have room for the worst case
+    Lz4Compressor lz4(data, sizeof(data));
+    u8 output[8];
+    Size outputSize = sizeof(output);
+    testAssert(lz4.compressBlock(output, outputSize) == Lz4Compressor::InvalidArgument);
+
+    return OK;
+}
+
+TestCase(Lz4CompressRepeated)
+{
+    const Size size = 16384;
+    u8 *data = new u8[size];
+    Size compressedSize;
+
+    // Long runs need additional length bytes for the match count
+    MemoryBlock::set(data, 'x', size);
+    testAssert(roundTrip(data, size, compressedSize));
+    testAssert(compressedSize < 128);
+
+    // Repeating pattern with a short period
+    for (Size i = 0; i < size; i++)
+        data[i] = "FreeNOS"[i % 7];
+
+    testAssert(roundTrip(data, size, compressedSize));
+    testAssert(compressedSize < size / 16);
+
+    delete[] data;
+    return OK;
+}
+
+TestCase(Lz4CompressRandom)
+{
+    TestInt<uint> ints(0, 255);
+    const Size size = 4096;
+    u8 *data = new u8[size];
+    Size compressedSize;
+
+    // Random data consists mostly of long literal runs
+    for (Size i = 0; i < size; i++)
+        data[i] = ints.random();
+
+    testAssert(roundTrip(data, size, compressedSize));
+    testAssert(compressedSize <= Lz4Compressor(data, size).getMaximumSize());
+
+    // Mix literals with matches
+    for (Size i = 0; i < size; i += 512)
+        MemoryBlock::set(data + i, 0, 100);
+
+    testAssert(roundTrip(data, size, compressedSize));
+    testAssert(compressedSize < size);
+
+    delete[] data;
+    return OK;
+}
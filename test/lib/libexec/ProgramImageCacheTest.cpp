@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/Constant.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestCase.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <ELFHeader.h>
+#include <ProgramImage.h>
+#include <ProgramImageCache.h>
+
+/** Offset of the loadable data in the test executable */
+#define TEST_DATA_OFFSET 256
+
+/** Virtual address of the loadable segment */
+#define TEST_VIRT_ADDRESS 0x80000000
+
+/**
+ * Build a minimal 32-bit ELF executable with a single loadable segment.
+ *
+ * @param image Output buffer of at least TEST_DATA_OFFSET + dataSize bytes
+ * @param dataSize Number of data bytes in the loadable segment
+ * @param flags ELF segment flags of the loadable segment
+ *
+ * @return Size of the executable in bytes
+ */
+static Size buildExecutable(u8 *image, const Size dataSize,
+                            const u32 flags = ELF_SEGMENT_FLAG_READ | ELF_SEGMENT_FLAG_WRITE)
+{
+    ELFHeader *header = (ELFHeader *) image;
+    ELFSegment *segments = (ELFSegment *) (image + sizeof(ELFHeader));
+
+    MemoryBlock::set(image, 0, TEST_DATA_OFFSET + dataSize);
+
+    header->ident[ELF_INDEX_MAGIC0] = ELF_MAGIC0;
+    header->ident[ELF_INDEX_MAGIC1] = ELF_MAGIC1;
+    header->ident[ELF_INDEX_MAGIC2] = ELF_MAGIC2;
+    header->ident[ELF_INDEX_MAGIC3] = ELF_MAGIC3;
+    header->ident[ELF_INDEX_CLASS]  = ELF_CLASS_32;
+    header->type    = ELF_TYPE_EXEC;
+    header->version = ELF_VERSION_CURRENT;
+    header->entry   = TEST_VIRT_ADDRESS + 4;
+    header->programHeaderOffset     = sizeof(ELFHeader);
+    header->programHeaderEntrySize  = sizeof(ELFSegment);
+    header->programHeaderEntryCount = 2;
+
+    // A non-loadable segment, which must be skipped
+    segments[0].type = ELF_SEGMENT_NULL;
+
+    // Loadable segment with trailing zeroed memory
+    segments[1].type           = ELF_SEGMENT_LOAD;
+    segments[1].offset         = TEST_DATA_OFFSET;
+    segments[1].virtualAddress = TEST_VIRT_ADDRESS;
+    segments[1].fileSize       = dataSize;
+    segments[1].memorySize     = dataSize * 2;
+    segments[1].flags          = flags;
+
+    for (Size i = 0; i < dataSize; i++)
+    {
+        image[TEST_DATA_OFFSET + i] = i & 0xff;
+    }
+
+    return TEST_DATA_OFFSET + dataSize;
+}
+
+/**
+ * Create a parsed program image.
+ *
+ * @param dataSize Number of data bytes in the program
+ *
+ * @return ProgramImage pointer
+ */
+static ProgramImage * createImage(const Size dataSize)
+{
+    u8 *buffer = new u8[TEST_DATA_OFFSET + dataSize];
+    ProgramImage *image = new ProgramImage();
+
+    image->parse(buffer, buildExecutable(buffer, dataSize));
+    delete[] buffer;
+    return image;
+}
+
+TestCase(ProgramImageParse)
+{
+    u8 buffer[TEST_DATA_OFFSET + 64];
+    const Size size = buildExecutable(buffer, 64);
+    ProgramImage image;
+
+    testAssert(image.parse(buffer, size) == ProgramImage::Success);
+    testAssert(image.entry() == TEST_VIRT_ADDRESS + 4);
+    testAssert(image.regionCount() == 1);
+    testAssert(image.size() == 64);
+
+    // Region data is packed at the start of the image
+    testAssert(image.regions()[0].virt == TEST_VIRT_ADDRESS);
+    testAssert(image.regions()[0].dataOffset == 0);
+    testAssert(image.regions()[0].dataSize == 64);
+    testAssert(image.regions()[0].memorySize == 128);
+    testAssert(image.regions()[0].access == (Memory::User | Memory::Readable | Memory::Writable));
+    testAssert(MemoryBlock::compare(image.data(), buffer + TEST_DATA_OFFSET, 64));
+
+    // Writable regions are not shared
+    testAssert(image.sharedPages()[0].size == 0);
+
+    // Images can only be loaded once
+    testAssert(image.parse(buffer, size) == ProgramImage::InvalidFormat);
+
+    return OK;
+}
+
+TestCase(ProgramImageShared)
+{
+    u8 buffer[TEST_DATA_OFFSET + 64];
+    const Size size = buildExecutable(buffer, 64, ELF_SEGMENT_FLAG_READ | ELF_SEGMENT_FLAG_EXEC);
+    ProgramImage image;
+
+    testAssert(image.parse(buffer, size) == ProgramImage::Success);
+    testAssert(image.regionCount() == 1);
+    testAssert(image.regions()[0].access == (Memory::User | Memory::Readable | Memory::Executable));
+
+    // Read-only regions are prepared in whole pages
+    const Memory::Range *pages = image.sharedPages();
+    testAssert(pages[0].size == PAGESIZE);
+    testAssert(pages[0].virt != ZERO);
+    testAssert(pages[0].access == (Memory::User | Memory::Readable));
+    testAssert(image.size() == PAGESIZE);
+    testAssert(MemoryBlock::compare((const void *) pages[0].virt, buffer + TEST_DATA_OFFSET, 64));
+
+    for (Size i = 64; i < PAGESIZE; i++)
+    {
+        testAssert(((const u8 *) pages[0].virt)[i] == 0);
+    }
+
+    return OK;
+}
+
+TestCase(ProgramImageInvalid)
+{
+    u8 buffer[TEST_DATA_OFFSET + 64];
+    const Size size = buildExecutable(buffer, 64);
+
+    // Not an executable
+    ProgramImage garbage;
+    MemoryBlock::set(buffer, 0xff, sizeof(ELFHeader));
+    testAssert(garbage.parse(buffer, size) == ProgramImage::InvalidFormat);
+
+    // Segment data outside of the executable
+    ProgramImage truncated;
+    buildExecutable(buffer, 64);
+    testAssert(truncated.parse(buffer, size - 1) == ProgramImage::InvalidFormat);
+
+    // Not LZ4 compressed
+    ProgramImage uncompressed;
+    testAssert(uncompressed.load(buffer, size) == ProgramImage::InvalidFormat);
+
+    return OK;
+}
+
+TestCase(ProgramImageCacheLookup)
+{
+    ProgramImageCache cache(4096);
+    ProgramImage *image = createImage(64);
+
+    testAssert(cache.lookup("/bin/ls", 1, 320) == ZERO);
+
+    cache.insert("/bin/ls", 1, 320, image);
+    testAssert(cache.count() == 1);
+    testAssert(cache.size() == 64);
+    testAssert(cache.lookup("/bin/ls", 1, 320) == image);
+    testAssert(cache.lookup("/bin/cat", 1, 320) == ZERO);
+
+    // A modified file invalidates the cached image
+    testAssert(cache.lookup("/bin/ls", 1, 321) == ZERO);
+    testAssert(cache.count() == 0);
+    testAssert(cache.size() == 0);
+
+    // Replacing the image for the same path
+    cache.insert("/bin/ls", 2, 320, createImage(32));
+    cache.insert("/bin/ls", 3, 320, createImage(16));
+    testAssert(cache.count() == 1);
+    testAssert(cache.size() == 16);
+    testAssert(cache.lookup("/bin/ls", 2, 320) == ZERO);
+
+    return OK;
+}
+
+TestCase(ProgramImageCacheEvict)
+{
+    ProgramImageCache cache(256);
+
+    cache.insert("/bin/a", 1, 1, createImage(100));
+    cache.insert("/bin/b", 2, 1, createImage(100));
+    testAssert(cache.count() == 2);
+
+    // Using an image makes it the most recently used
+    testAssert(cache.lookup("/bin/a", 1, 1) != ZERO);
+
+    // Exceeding the budget evicts the least recently used image
+    cache.insert("/bin/c", 3, 1, createImage(100));
+    testAssert(cache.count() == 2);
+    testAssert(cache.size() == 200);
+    testAssert(cache.lookup("/bin/b", 2, 1) == ZERO);
+    testAssert(cache.lookup("/bin/a", 1, 1) != ZERO);
+    testAssert(cache.lookup("/bin/c", 3, 1) != ZERO);
+
+    // An image larger than the budget is still kept
+    cache.insert("/bin/d", 4, 1, createImage(512));
+    testAssert(cache.count() == 1);
+    testAssert(cache.lookup("/bin/d", 4, 1) != ZERO);
+
+    // Number of images is limited as well
+    cache.clear();
+    testAssert(cache.count() == 0);
+    ProgramImageCache small(1024 * 1024);
+    for (Size i = 0; i < 12; i++)
+    {
+        char path[] = "/bin/x";
+        path[5] = 'a' + i;
+        small.insert(path, i, 1, createImage(8));
+    }
+    testAssert(small.count() == 8);
+    testAssert(small.lookup("/bin/a", 0, 1) == ZERO);
+    testAssert(small.lookup("/bin/l", 11, 1) != ZERO);
+
+    return OK;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestInt.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <CachedStorage.h>
+
+/**
+ * Memory backed storage which counts I/O requests
+ */
+class MemoryStorage : public Storage
+{
+  public:
+
+    MemoryStorage()
+        : m_reads(0)
+        , m_writes(0)
+        , m_lastWriteSize(0)
+    {
+        for (Size i = 0; i < sizeof(m_data); i++)
+            m_data[i] = i & 0xff;
+    }
+
+    virtual FileSystem::Result initialize()
+    {
+        return FileSystem::Success;
+    }
+
+    virtual FileSystem::Result read(const u64 offset, void *buffer, const Size size) const
+    {
+        MemoryStorage *self = (MemoryStorage *) this;
+        self->m_reads++;
+        MemoryBlock::copy(buffer, m_data + offset, size);
+        return FileSystem::Success;
+    }
+
+    virtual FileSystem::Result write(const u64 offset, void *buffer, const Size size)
+    {
+        m_writes++;
+        m_lastWriteSize = size;
+        MemoryBlock::copy(m_data + offset, buffer, size);
+        return FileSystem::Success;
+    }
+
+    virtual u64 capacity() const
+    {
+        return sizeof(m_data);
+    }
+
+    u8 m_data[1000];
+    Size m_reads;
+    Size m_writes;
+    Size m_lastWriteSize;
+};
+
+TestCase(CachedStorageRead)
+{
+    MemoryStorage mem;
+    CachedStorage cache(&mem, 4, 128);
+    u8 buf[200];
+
+    testAssert(cache.initialize() == FileSystem::Success);
+    testAssert(cache.capacity() == 1000);
+
+    // Unaligned read spanning three pages
+    testAssert(cache.read(100, buf, 200) == FileSystem::Success);
+    testAssert(mem.m_reads == 3);
+    for (Size i = 0; i < sizeof(buf); i++)
+        testAssert(buf[i] == ((100 + i) & 0xff));
+
+    // Served from the cache
+    testAssert(cache.read(128, buf, 10) == FileSystem::Success);
+    testAssert(mem.m_reads == 3);
+    testAssert(buf[0] == 128);
+
+    // Last page is partial
+    testAssert(cache.read(990, buf, 10) == FileSystem::Success);
+    testAssert(mem.m_reads == 4);
+    testAssert(buf[9] == (999 & 0xff));
+
+    // Least recently used page (offset 0) is replaced
+    testAssert(cache.read(512, buf, 1) == FileSystem::Success);
+    testAssert(mem.m_reads == 5);
+    testAssert(cache.read(0, buf, 1) == FileSystem::Success);
+    testAssert(mem.m_reads == 6);
+
+    return OK;
+}
+
+TestCase(CachedStorageWriteBack)
+{
+    MemoryStorage mem;
+    CachedStorage cache(&mem, 8, 128);
+    u8 buf[384];
+
+    testAssert(cache.initialize() == FileSystem::Success);
+    MemoryBlock::set(buf, 0xaa, sizeof(buf));
+
+    // Full pages are written without reading them first
+    testAssert(cache.write(128, buf, 256) == FileSystem::Success);
+    testAssert(mem.m_reads == 0);
+    testAssert(mem.m_writes == 0);
+    testAssert(mem.m_data[128] == 128);
+
+    // Partial page is read first
+    testAssert(cache.write(400, buf, 10) == FileSystem::Success);
+    testAssert(mem.m_reads == 1);
+
+    // Reads return the written data
+    testAssert(cache.read(250, buf, 1) == FileSystem::Success);
+    testAssert(buf[0] == 0xaa);
+
+    // Consecutive pages are written back in one request
+    testAssert(cache.flush() == FileSystem::Success);
+    testAssert(mem.m_writes == 1);
+    testAssert(mem.m_lastWriteSize == 384);
+    testAssert(mem.m_data[127] == 127);
+    testAssert(mem.m_data[128] == 0xaa);
+    testAssert(mem.m_data[383] == 0xaa);
+    testAssert(mem.m_data[399] == (399 & 0xff));
+    testAssert(mem.m_data[400] == 0xaa);
+    testAssert(mem.m_data[410] == (410 & 0xff));
+
+    // Nothing left to write
+    testAssert(cache.flush() == FileSystem::Success);
+    testAssert(mem.m_writes == 1);
+
+    return OK;
+}
+
+TestCase(CachedStorageEvictDirty)
+{
+    MemoryStorage mem;
+    CachedStorage cache(&mem, 2, 128);
+    u8 buf[128];
+
+    testAssert(cache.initialize() == FileSystem::Success);
+    MemoryBlock::set(buf, 0x55, sizeof(buf));
+
+    // Fill the cache with dirty pages
+    testAssert(cache.write(0, buf, 128) == FileSystem::Success);
+    testAssert(cache.write(512, buf, 128) == FileSystem::Success);
+    testAssert(mem.m_writes == 0);
+
+    // Replacing a dirty page writes back all dirty pages
+    testAssert(cache.read(256, buf, 1) == FileSystem::Success);
+    testAssert(mem.m_writes == 2);
+    testAssert(mem.m_data[0] == 0x55);
+    testAssert(mem.m_data[512] == 0x55);
+
+    return OK;
+}
@@ -89,6 +89,72 @@ class DummyFileSystem : public FileSystemServer
 
 u8 DummyFileSystem::m_pages[PAGESIZE * 2 * 4];
 
+/**
+ * File which blocks readers until data is available
+ */
+class BlockingFile : public File
+{
+  public:
+
+    BlockingFile(const u32 inode, const bool notifying)
+        : File(inode)
+        , m_available(false)
+        , m_reads(0)
+    {
+        m_notifying = notifying ? FileSystem::Readable : 0;
+    }
+
+    virtual FileSystem::Result read(IOBuffer & buffer,
+                                    Size & size,
+                                    const Size offset)
+    {
+        m_reads++;
+
+        if (!m_available)
+        {
+            return FileSystem::RetryAgain;
+        }
+
+        size = 0;
+        return FileSystem::Success;
+    }
+
+    bool m_available;
+    Size m_reads;
+};
+
+/**
+ * File which provides physical pages for mapping
+ */
+class PageFile : public File
+{
+  public:
+
+    PageFile(const u32 inode, const Size size)
+        : File(inode)
+        , m_lookups(0)
+    {
+        m_size = size;
+    }
+
+    virtual FileSystem::Result physicalAddress(const Size offset,
+                                               Address & phys)
+    {
+        m_lookups++;
+
+        if (offset >= m_size)
+        {
+            return FileSystem::InvalidArgument;
+        }
+
+        phys = PhysicalBase + offset;
+        return FileSystem::Success;
+    }
+
+    static const Address PhysicalBase = 0x100000;
+    Size m_lookups;
+};
+
 TestCase(FileSystemServerConstruct)
 {
     Directory *root = new Directory(1);
@@ -277,6 +343,154 @@ TestCase(FileSystemServerWriteFile)
     return OK;
 }
 
+TestCase(FileSystemServerReadWriteFileVector)
+{
+    DummyFileSystem fs(new Directory(1), "/mnt");
+
+    // Add the file
+    const u32 inode = fs.getNextInode();
+    File *file = new PseudoFile(inode);
+    testAssert(fs.registerFile(file, "myfile.txt") == FileSystem::Success);
+
+    // Write the file using two buffers
+    String part1("some"), part2("thing");
+    FileSystem::IOVector vec[2];
+    vec[0].address = (Address) *part1;
+    vec[0].size    = part1.length();
+    vec[1].address = (Address) *part2;
+    vec[1].size    = part2.length();
+
+    FileSystemMessage msg;
+    msg.from        = fs.m_pid;
+    msg.action      = FileSystem::WriteFileVector;
+    msg.inode       = inode;
+    msg.buffer      = (char *) vec;
+    msg.size        = part1.length() + part2.length();
+    msg.offset      = 0;
+    msg.vectorCount = 2;
+    fs.pathHandler(&msg);
+
+    // Receive response
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::Success);
+    testAssert(msg.size == 9);
+
+    // Read it back into three buffers
+    char buf1[3], buf2[4], buf3[16];
+    MemoryBlock::set(buf3, 0, sizeof(buf3));
+    vec[0].address = (Address) buf1;
+    vec[0].size    = sizeof(buf1);
+    vec[1].address = (Address) buf2;
+    vec[1].size    = sizeof(buf2);
+    FileSystem::IOVector readVec[3];
+    readVec[0] = vec[0];
+    readVec[1] = vec[1];
+    readVec[2].address = (Address) buf3;
+    readVec[2].size    = sizeof(buf3) - 1;
+
+    msg.action      = FileSystem::ReadFileVector;
+    msg.buffer      = (char *) readVec;
+    msg.size        = sizeof(buf1) + sizeof(buf2) + sizeof(buf3) - 1;
+    msg.vectorCount = 3;
+    fs.pathHandler(&msg);
+
+    // Receive response
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::Success);
+    testAssert(msg.size == 9);
+
+    // Verify content
+    testAssert(MemoryBlock::compare(buf1, "som", sizeof(buf1)));
+    testAssert(MemoryBlock::compare(buf2, "ethi", sizeof(buf2)));
+    testString(buf3, "ng");
+
+    // Invalid vector count must be rejected
+    msg.vectorCount = FileSystem::MaximumIOVectors + 1;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    // Vectors larger than the maximum total size must be rejected
+    readVec[2].size = FileSystem::MaximumIOVectorSize;
+    msg.buffer      = (char *) readVec;
+    msg.vectorCount = 3;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    // Sizes which wrap around must be rejected
+    readVec[1].size = ~0U;
+    readVec[2].size = 2;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    return OK;
+}
+
+TestCase(FileSystemServerMapFile)
+{
+    DummyFileSystem fs(new Directory(1), "/mnt");
+
+    // Add a file with physical pages and one without
+    const u32 inode = fs.getNextInode();
+    PageFile *file = new PageFile(inode, PAGESIZE * 2);
+    testAssert(fs.registerFile(file, "pages.bin") == FileSystem::Success);
+
+    const u32 plainInode = fs.getNextInode();
+    testAssert(fs.registerFile(new PseudoFile(plainInode), "plain.txt") == FileSystem::Success);
+
+    // Map the whole file
+    FileSystemMessage msg;
+    msg.from   = fs.m_pid;
+    msg.action = FileSystem::MapFile;
+    msg.inode  = inode;
+    msg.buffer = (char *) (PAGESIZE * 16);
+    msg.size   = PAGESIZE * 2;
+    msg.offset = 0;
+    fs.pathHandler(&msg);
+
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::Success);
+    testAssert(file->m_lookups == 4);
+
+    // Unaligned address, size or offset must be rejected
+    msg.buffer = (char *) (PAGESIZE * 16 + 1);
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    msg.buffer = (char *) (PAGESIZE * 16);
+    msg.size   = PAGESIZE + 1;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    msg.size   = PAGESIZE;
+    msg.offset = 1;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+
+    // Nothing is mapped if a page is beyond the end of the file
+    file->m_lookups = 0;
+    msg.size   = PAGESIZE * 3;
+    msg.offset = 0;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::InvalidArgument);
+    testAssert(file->m_lookups == 3);
+
+    // Files without physical pages cannot be mapped
+    msg.inode = plainInode;
+    msg.size  = PAGESIZE;
+    fs.pathHandler(&msg);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.result == FileSystem::NotSupported);
+
+    return OK;
+}
+
 TestCase(FileSystemServerDeleteFile)
 {
     DummyFileSystem fs(new Directory(1), "/mnt");
@@ -321,3 +535,141 @@ TestCase(FileSystemServerDeleteFile)
 
     return OK;
 }
+
+TestCase(FileSystemServerRing)
+{
+    DummyFileSystem fs(new Directory(1), "/mnt");
+    static u8 ringPages[FileSystemRing::ShareSize];
+    const Address base = (Address) ringPages;
+    MemoryChannel submission(Channel::Producer, sizeof(FileSystemMessage));
+    MemoryChannel completion(Channel::Consumer, sizeof(FileSystemMessage));
+
+    // Submitting without a ring fails
+    FileSystemMessage msg;
+    msg.from   = fs.m_pid;
+    msg.action = FileSystem::SubmitRing;
+    fs.submitRingHandler(&msg);
+    testAssert(msg.result == FileSystem::NotFound);
+
+    // Setup the ring
+    MemoryBlock::set(ringPages, 0, sizeof(ringPages));
+    testAssert(fs.attachRing(fs.m_pid, base) == FileSystem::Success);
+    submission.setVirtual(base, base + PAGESIZE);
+    completion.setVirtual(base + (PAGESIZE * 2u), base + (PAGESIZE * 3u));
+
+    // Add the file
+    const u32 inode = fs.getNextInode();
+    File *file = new PseudoFile(inode, "mydata");
+    testAssert(fs.registerFile(file, "myfile.txt") == FileSystem::Success);
+
+    // Queue a read, a stat and an unsupported request
+    char buf[128];
+    FileSystem::FileStat st;
+    FileSystemMessage entry;
+    entry.type       = ChannelMessage::Request;
+    entry.action     = FileSystem::ReadFile;
+    entry.identifier = 1;
+    entry.inode      = inode;
+    entry.buffer     = buf;
+    entry.size       = sizeof(buf);
+    entry.offset     = 2;
+    testAssert(submission.write(&entry) == Channel::Success);
+
+    entry.action     = FileSystem::StatFile;
+    entry.identifier = 2;
+    entry.stat       = &st;
+    testAssert(submission.write(&entry) == Channel::Success);
+
+    entry.action     = FileSystem::DeleteFile;
+    entry.identifier = 3;
+    testAssert(submission.write(&entry) == Channel::Success);
+
+    // Process all requests in one batch
+    fs.submitRingHandler(&msg);
+    testAssert(msg.result == FileSystem::Success);
+    testAssert(msg.size == 3);
+
+    // Reap completions
+    testAssert(completion.read(&entry) == Channel::Success);
+    testAssert(entry.identifier == 1);
+    testAssert(entry.result == FileSystem::Success);
+    testAssert(entry.size == 4);
+    buf[entry.size] = 0;
+    testString(buf, "data");
+
+    testAssert(completion.read(&entry) == Channel::Success);
+    testAssert(entry.identifier == 2);
+    testAssert(entry.result == FileSystem::Success);
+    testAssert(st.inode == inode);
+    testAssert(st.size == 6);
+
+    testAssert(completion.read(&entry) == Channel::Success);
+    testAssert(entry.identifier == 3);
+    testAssert(entry.result == FileSystem::NotSupported);
+
+    // Nothing was sent on the regular channel
+    testAssert(completion.read(&entry) == Channel::NotFound);
+    testAssert(fs.m_clientConsumer->read(&entry) == Channel::NotFound);
+
+    return OK;
+}
+
+TestCase(FileSystemServerWaitQueue)
+{
+    DummyFileSystem fs(new Directory(1), "/mnt");
+    char buf[16];
+
+    // Add a file which notifies readers and one which does not
+    BlockingFile *notifying = new BlockingFile(fs.getNextInode(), true);
+    testAssert(fs.registerFile(notifying, "notifying") == FileSystem::Success);
+    BlockingFile *polled = new BlockingFile(fs.getNextInode(), false);
+    testAssert(fs.registerFile(polled, "polled") == FileSystem::Success);
+
+    // Read from both files
+    FileSystemMessage msg;
+    msg.from   = fs.m_pid;
+    msg.action = FileSystem::ReadFile;
+    msg.buffer = buf;
+    msg.size   = sizeof(buf);
+    msg.offset = 0;
+    msg.inode  = notifying->getInode();
+    fs.pathHandler(&msg);
+    msg.inode  = polled->getInode();
+    fs.pathHandler(&msg);
+
+    // Requests are parked on the notifying file only
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::NotFound);
+    testAssert(fs.m_requests->count() == 1);
+    testAssert(fs.m_waiting.count() == 1);
+    testAssert(fs.m_waiting.get(notifying->getInode()) != ZERO);
+    testAssert(notifying->m_reads == 1);
+    testAssert(polled->m_reads == 1);
+
+    // Without notification only the polled file is retried
+    notifying->m_available = true;
+    testAssert(fs.retryRequests() == false);
+    testAssert(notifying->m_reads == 1);
+    testAssert(polled->m_reads == 2);
+
+    // Notify completes the parked request
+    notifying->notifyReadable();
+    testAssert(fs.retryRequests() == true);
+    testAssert(notifying->m_reads == 2);
+    testAssert(fs.m_waiting.count() == 0);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.inode == notifying->getInode());
+    testAssert(msg.result == FileSystem::Success);
+
+    // Notification is consumed by the retry
+    testAssert(notifying->takeNotifications() == 0);
+
+    // Complete the polled request
+    polled->m_available = true;
+    testAssert(fs.retryRequests() == true);
+    testAssert(fs.m_requests->count() == 0);
+    testAssert(fs.m_clientConsumer->read(&msg) == Channel::Success);
+    testAssert(msg.inode == polled->getInode());
+    testAssert(msg.result == FileSystem::Success);
+
+    return OK;
+}
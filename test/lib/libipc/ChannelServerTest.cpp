@@ -192,6 +192,7 @@ TestCase(ChannelServerReadChannels)
     ProcessEvent event;
     event.type = ShareCreated;
     event.share.pid = pid;
+    event.share.tagId = 0;
     event.share.range.virt = (Address) &pages;
     testAssert(server.m_kernelProducer.write(&event) == MemoryChannel::Success);
     testAssert(server.m_kernelProducer.flush() == MemoryChannel::Success);
@@ -274,6 +275,7 @@ TestCase(ChannelServerShareCreated)
     ProcessEvent event;
     event.type = ShareCreated;
     event.share.pid = pid;
+    event.share.tagId = 0;
     event.share.range.virt = addr;
     testAssert(server.m_kernelProducer.write(&event) == MemoryChannel::Success);
     testAssert(server.m_kernelProducer.flush() == MemoryChannel::Success);
@@ -364,6 +366,7 @@ TestCase(ChannelServerProcessTerminated)
     ProcessEvent event;
     event.type = ShareCreated;
     event.share.pid = pid;
+    event.share.tagId = 0;
     event.share.range.virt = addr;
     testAssert(server.m_kernelProducer.write(&event) == MemoryChannel::Success);
     testAssert(server.m_kernelProducer.flush() == MemoryChannel::Success);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/** Value in the data section, modified after fork */
+static volatile int data = 0x1234;
+
+/** Value in the bss section, modified after fork */
+static volatile int bss;
+
+/** Number of heap bytes modified after fork */
+#define HEAP_SIZE 8192
+
+/**
+ * Check and modify memory in the child process.
+ *
+ * @param heap Heap buffer filled with 'a' before the fork
+ * @param stack Stack variable set before the fork
+ *
+ * @return Exit status: zero on success, or the number of the failed check
+ */
+static int child(volatile char *heap, volatile int *stack)
+{
+    // The parent may already have written its own values
+    if (data != 0x1234 || bss != 0)
+        return 1;
+    if (heap[0] != 'a' || heap[HEAP_SIZE - 1] != 'a')
+        return 2;
+    if (*stack != 100)
+        return 3;
+
+    data  = 0x5678;
+    bss   = 2;
+    *stack = 200;
+    for (Size i = 0; i < HEAP_SIZE; i++)
+        heap[i] = 'c';
+
+    // Only the child sees its own writes
+    if (data != 0x5678 || bss != 2 || *stack != 200)
+        return 4;
+    if (heap[0] != 'c' || heap[HEAP_SIZE - 1] != 'c')
+        return 5;
+
+    return 0;
+}
+
+TestCase(ForkReturnValues)
+{
+    const pid_t parent = getpid();
+    const pid_t pid = fork();
+    int status = -1;
+
+    testAssert(pid != (pid_t) -1);
+
+    // The child gets zero and its own process ID
+    if (pid == 0)
+        exit(getpid() != parent && getppid() == parent ? 0 : 1);
+
+    testAssert(pid != parent);
+    testAssert(getpid() == parent);
+    testAssert(waitpid(pid, &status, 0) == pid);
+    testAssert(WEXITSTATUS(status) == 0);
+    return OK;
+}
+
+TestCase(ForkCopyOnWrite)
+{
+    volatile char *heap = new char[HEAP_SIZE];
+    volatile int stack = 100;
+    int status = -1;
+
+    testAssert(heap != NULL);
+    for (Size i = 0; i < HEAP_SIZE; i++)
+        heap[i] = 'a';
+    data = 0x1234;
+    bss  = 0;
+
+    const pid_t pid = fork();
+    testAssert(pid != (pid_t) -1);
+
+    if (pid == 0)
+        exit(child(heap, &stack));
+
+    // Write before the child finished
+    data  = 0x4321;
+    bss   = 1;
+    stack = 300;
+    for (Size i = 0; i < HEAP_SIZE; i++)
+        heap[i] = 'p';
+
+    testAssert(waitpid(pid, &status, 0) == pid);
+    testAssert(WEXITSTATUS(status) == 0);
+
+    // Writes of the child are not visible to the parent
+    testAssert(data == 0x4321);
+    testAssert(bss == 1);
+    testAssert(stack == 300);
+    for (Size i = 0; i < HEAP_SIZE; i++)
+        testAssert(heap[i] == 'p');
+
+    delete[] heap;
+    return OK;
+}
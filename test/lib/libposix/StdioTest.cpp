@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TestCase.h>
+#include <TestRunner.h>
+#include <TestMain.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/** Path of the file used by the stdio tests. */
+static const char *path = "/tmp/StdioTest.txt";
+
+/**
+ * Get the size of the test file.
+ *
+ * @return Size in bytes or -1 on failure
+ */
+static long fileSize()
+{
+    struct stat st;
+
+    if (stat(path, &st) != 0)
+        return -1;
+
+    return st.st_size;
+}
+
+/**
+ * Create the test file with the given contents.
+ *
+ * @param text Contents of the file
+ *
+ * @return True on success, false otherwise
+ */
+static bool createFile(const char *text)
+{
+    FILE *f = fopen(path, "w");
+
+    if (!f)
+        return false;
+
+    const size_t len = strlen(text);
+    const bool ok = fwrite(text, 1, len, f) == len;
+
+    return fclose(f) == 0 && ok;
+}
+
+TestCase(StdioFullyBuffered)
+{
+    char buf[256];
+    FILE *f = fopen(path, "w");
+    testAssert(f != NULL);
+    testAssert(setvbuf(f, buf, _IOFBF, sizeof(buf)) == 0);
+
+    // Output stays in the buffer until flushed
+    testAssert(fwrite("hello\n", 1, 6, f) == 6);
+    testAssert(fileSize() == 0);
+    testAssert(fflush(f) == 0);
+    testAssert(fileSize() == 6);
+
+    // Output is written when the buffer overflows
+    for (Size i = 0; i <= sizeof(buf); i++)
+        testAssert(fputc('x', f) == 'x');
+    testAssert(fileSize() > 6);
+
+    testAssert(fclose(f) == 0);
+    testAssert(fileSize() == 6 + sizeof(buf) + 1);
+    testAssert(unlink(path) == 0);
+    return OK;
+}
+
+TestCase(StdioLineBuffered)
+{
+    char buf[256];
+    FILE *f = fopen(path, "w");
+    testAssert(f != NULL);
+    testAssert(setvbuf(f, buf, _IOLBF, sizeof(buf)) == 0);
+
+    // Output is written at the end of each line
+    testAssert(fwrite("ab", 1, 2, f) == 2);
+    testAssert(fileSize() == 0);
+    testAssert(fputc('\n', f) == '\n');
+    testAssert(fileSize() == 3);
+
+    testAssert(fclose(f) == 0);
+    testAssert(unlink(path) == 0);
+    return OK;
+}
+
+TestCase(StdioUnbuffered)
+{
+    FILE *f = fopen(path, "w");
+    testAssert(f != NULL);
+    testAssert(setvbuf(f, ZERO, _IONBF, 0) == 0);
+
+    // Each byte is written immediately
+    testAssert(fputc('a', f) == 'a');
+    testAssert(fileSize() == 1);
+    testAssert(fwrite("bc", 1, 2, f) == 2);
+    testAssert(fileSize() == 3);
+
+    // Invalid buffering modes are rejected
+    testAssert(setvbuf(f, ZERO, 12345, 0) != 0);
+
+    testAssert(fclose(f) == 0);
+    testAssert(unlink(path) == 0);
+    return OK;
+}
+
+TestCase(StdioSeekTell)
+{
+    testAssert(createFile("0123456789"));
+
+    FILE *f = fopen(path, "r");
+    testAssert(f != NULL);
+    testAssert(ftell(f) == 0);
+
+    // The position accounts for input read ahead in the buffer
+    testAssert(fgetc(f) == '0');
+    testAssert(ftell(f) == 1);
+
+    testAssert(fseek(f, 5, SEEK_SET) == 0);
+    testAssert(ftell(f) == 5);
+    testAssert(fgetc(f) == '5');
+    testAssert(ftell(f) == 6);
+
+    testAssert(fseek(f, -4, SEEK_CUR) == 0);
+    testAssert(ftell(f) == 2);
+    testAssert(fgetc(f) == '2');
+
+    // Reading past the end
+    testAssert(fseek(f, 9, SEEK_SET) == 0);
+    testAssert(fgetc(f) == '9');
+    testAssert(fgetc(f) == EOF);
+
+    // Seeking clears the end-of-file indicator
+    testAssert(fseek(f, 0, SEEK_SET) == 0);
+    testAssert(fgetc(f) == '0');
+
+    testAssert(fclose(f) == 0);
+    testAssert(unlink(path) == 0);
+    return OK;
+}
+
+TestCase(StdioGets)
+{
+    char line[64];
+    testAssert(createFile("first\nsecond\nx"));
+
+    FILE *f = fopen(path, "r");
+    testAssert(f != NULL);
+
+    // Lines include the newline
+    testAssert(fgets(line, sizeof(line), f) == line);
+    testAssert(strcmp(line, "first\n") == 0);
+
+    // Long lines are split at the buffer size
+    testAssert(fgets(line, 4, f) == line);
+    testAssert(strcmp(line, "sec") == 0);
+    testAssert(fgets(line, sizeof(line), f) == line);
+    testAssert(strcmp(line, "ond\n") == 0);
+
+    // The last line has no newline
+    testAssert(fgets(line, sizeof(line), f) == line);
+    testAssert(strcmp(line, "x") == 0);
+    testAssert(fgets(line, sizeof(line), f) == NULL);
+
+    testAssert(fclose(f) == 0);
+    testAssert(unlink(path) == 0);
+    return OK;
+}
+
+TestCase(StdioOpenModes)
+{
+    char line[64];
+    testAssert(createFile("old contents"));
+    testAssert(fileSize() == 12);
+
+    // Write mode discards the previous contents
+    FILE *f = fopen(path, "w");
+    testAssert(f != NULL);
+    testAssert(fileSize() == 0);
+    testAssert(fwrite("new", 1, 3, f) == 3);
+    testAssert(fclose(f) == 0);
+
+    // Append mode writes at the end
+    f = fopen(path, "a");
+    testAssert(f != NULL);
+    testAssert(fwrite("er", 1, 2, f) == 2);
+    testAssert(fclose(f) == 0);
+
+    f = fopen(path, "r");
+    testAssert(f != NULL);
+    testAssert(fgets(line, sizeof(line), f) == line);
+    testAssert(strcmp(line, "newer") == 0);
+    testAssert(fclose(f) == 0);
+
+    testAssert(unlink(path) == 0);
+    testAssert(fopen(path, "r") == NULL);
+    return OK;
+}
@@ -20,6 +20,7 @@
 #include <TestInt.h>
 #include <TestMain.h>
 #include <BitArray.h>
+#include <Vector.h>
 
 TestCase(BitArrayConstruct)
 {
@@ -329,3 +330,91 @@ TestCase(BitArraySetArray)
     testAssert(!ba2.m_allocated);
     return OK;
 }
+
+TestCase(BitArraySummary)
+{
+    BitArray ba(32 * 100 + 5);
+    Size bit;
+
+    // Only words which are fully set are marked in the summary
+    ba.setRange(0, (32 * 40) - 2);
+    testAssert(ba.m_summary != ZERO);
+    testAssert(ba.m_summary[0] == 0xffffffff);
+    testAssert(ba.m_summary[1] == 0x7f);
+    testAssert(ba.count(true) == (32 * 40) - 1);
+
+    // Setting the last bit completes the word
+    ba.set((32 * 40) - 1);
+    testAssert(ba.m_summary[1] == 0xff);
+
+    // Unsetting a bit clears the summary again
+    ba.unset(32 * 33);
+    testAssert(ba.m_summary[1] == 0xfd);
+
+    // The search skips full words and finds the single unset bit
+    testAssert(ba.setNext(&bit, 1, 32) == BitArray::Success);
+    testAssert(bit == 32 * 33);
+    testAssert(ba.m_summary[1] == 0xff);
+
+    // A run must start after the full words
+    testAssert(ba.setNext(&bit, 40, 0, 8) == BitArray::Success);
+    testAssert(bit == 32 * 40);
+
+    // The last, partially used word is full when its used bits are set
+    ba.setRange(32 * 100, 32 * 100 + 4);
+    testAssert(ba.m_summary[3] & (1 << 4));
+    testAssert(ba.setNext(&bit, 1, 32 * 100) == BitArray::OutOfMemory);
+
+    // Clearing resets the summary
+    ba.clear();
+    for (Size i = 0; i < ba.calculateSummarySize(ba.size()); i++)
+    {
+        testAssert(ba.m_summary[i] == 0);
+    }
+    return OK;
+}
+
+TestCase(BitArraySetNextCompare)
+{
+    const Size bitCount = 4096 + 17;
+    TestInt<Size> indexes(0, bitCount - 1);
+    TestInt<Size> counts(1, 70);
+    TestInt<Size> boundaries(1, 8);
+    u8 *external = new u8[(bitCount / 8) + 1];
+    BitArray hierarchical(bitCount), flat(bitCount, external);
+
+    // Set the same random bits in both arrays
+    for (Size i = 0; i < bitCount / 2; i++)
+    {
+        const Size idx = indexes.random();
+        hierarchical.set(idx);
+        flat.set(idx);
+    }
+
+    // With or without summary, the search must give the same results
+    for (Size i = 0; i < 200; i++)
+    {
+        const Size count = counts.random();
+        const Size boundary = boundaries.random();
+        const Size start = indexes.random();
+        Size bit1 = 0, bit2 = 0;
+
+        const BitArray::Result r1 = hierarchical.setNext(&bit1, count, start, boundary);
+        const BitArray::Result r2 = flat.setNext(&bit2, count, start, boundary);
+        testAssert(r1 == r2);
+
+        if (r1 == BitArray::Success)
+        {
+            testAssert(bit1 == bit2);
+            testAssert(bit1 >= start);
+            testAssert((bit1 % boundary) == 0);
+
+            for (Size j = 0; j < count; j++)
+                testAssert(hierarchical.isSet(bit1 + j));
+        }
+    }
+    testAssert(hierarchical.count(true) == flat.count(true));
+
+    delete[] external;
+    return OK;
+}
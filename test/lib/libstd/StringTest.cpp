@@ -135,6 +135,33 @@ TestCase(StringResize)
     return OK;
 }
 
+TestCase(StringResizeInPlace)
+{
+    TestChar<char *> strings(64, 64);
+    String s(strings.random(), true);
+    const char *buffer = s.m_string;
+
+    // Check the initial String
+    testString(s.m_string, strings[0]);
+    testAssert(s.m_allocated);
+    testAssert(s.m_count == 64);
+    testAssert(s.m_size == 65);
+
+    // Growing by a single byte fits in the heap block of the buffer
+    testAssert(s.resize(66));
+    testAssert(s.m_string == buffer);
+    testString(s.m_string, strings[0]);
+    testAssert(s.m_count == 64);
+    testAssert(s.m_size == 66);
+
+    // Growing beyond the heap block moves the buffer
+    testAssert(s.resize(4096));
+    testString(s.m_string, strings[0]);
+    testAssert(s.m_count == 64);
+    testAssert(s.m_size == 4096);
+    return OK;
+}
+
 TestCase(StringResizeChop)
 {
     String s = "1234567890";
@@ -94,6 +94,38 @@ TestCase(VectorResize)
     return OK;
 }
 
+TestCase(VectorResizeInPlace)
+{
+    TestInt<uint> bytes(0, 255);
+    Vector<u8> a(65);
+
+    // Fill the vector completely
+    for (Size i = 0; i < 65; i++)
+        testAssert(a.insert(bytes.random()) == (int) i);
+
+    // Growing by a single byte fits in the heap block of the array
+    const u8 *array = a.vector();
+    testAssert(a.resize(66));
+    testAssert(a.vector() == array);
+    testAssert(a.size() == 66);
+    testAssert(a.count() == 65);
+    testAssert(a.vector()[65] == 0);
+
+    // The contents of the array must be untouched
+    for (Size i = 0; i < 65; i++)
+        testAssert(a.at(i) == bytes[i]);
+
+    // Growing beyond the heap block moves the array
+    testAssert(a.resize(4096));
+    testAssert(a.size() == 4096);
+    testAssert(a.count() == 65);
+
+    for (Size i = 0; i < 65; i++)
+        testAssert(a.at(i) == bytes[i]);
+
+    return OK;
+}
+
 TestCase(VectorPutMultiple)
 {
     TestInt<uint> sizes(32, 128);
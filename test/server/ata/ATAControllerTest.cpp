@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <TestRunner.h>
+#include <TestCase.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <DeviceServer.h>
+#include <IOBuffer.h>
+#include <FileSystemMessage.h>
+#include "ATAController.h"
+
+/**
+ * DeviceServer which records its timeouts.
+ */
+class TimeoutServer : public DeviceServer
+{
+  public:
+
+    TimeoutServer()
+        : DeviceServer("/dev/atatest")
+        , timeouts(0)
+    {
+    }
+
+    /** Sleep until woken up by an interrupt or timeout */
+    void sleep()
+    {
+        sleepUntilWakeup();
+    }
+
+    /** Number of timeouts */
+    Size timeouts;
+
+  protected:
+
+    virtual void timeout()
+    {
+        timeouts++;
+        DeviceServer::timeout();
+    }
+};
+
+/**
+ * ATA controller with a drive which never raises the interrupt of a command.
+ */
+class LostInterruptController : public ATAController
+{
+  public:
+
+    LostInterruptController(DeviceServer &server)
+        : ATAController(1, server, InterruptIO)
+        , started(0)
+        , resets(0)
+    {
+        ATADrive *drive = new ATADrive;
+        MemoryBlock::set(drive, 0, sizeof(*drive));
+        drive->sectors  = 1024;
+        drive->multiple = 1;
+        drives.append(drive);
+    }
+
+    /** Move the deadline of the current command */
+    void setDeadline(const Size msec)
+    {
+        m_timer.tick();
+        m_timer.getCurrent(&m_deadline, msec);
+    }
+
+    /** Number of commands started */
+    Size started;
+
+    /** Number of drive resets */
+    Size resets;
+
+  protected:
+
+    virtual void startRead(const u64 lba, const Size sectors)
+    {
+        started++;
+    }
+
+    virtual void resetDrive()
+    {
+        resets++;
+    }
+};
+
+/**
+ * Read the first sector on behalf of a process.
+ *
+ * @param ata Controller to read from
+ * @param from Process which sends the request
+ *
+ * @return Result code
+ */
+static FileSystem::Result readSector(ATAController & ata, const ProcessID from)
+{
+    static u8 data[513];
+    FileSystemMessage msg;
+    Size size = 512;
+
+    // Unaligned remote buffer, such that the data is gathered in a local buffer
+    MemoryBlock::set(&msg, 0, sizeof(msg));
+    msg.from   = from;
+    msg.action = FileSystem::ReadFile;
+    msg.buffer = (char *) data + 1;
+    msg.size   = size;
+
+    IOBuffer buffer(&msg);
+    return ata.read(buffer, size, 0);
+}
+
+TestCase(ATALostInterrupt)
+{
+    TimeoutServer server;
+    LostInterruptController ata(server);
+    const ProcessID owner = ProcessCtl(SELF, GetPID);
+    const ProcessID other = owner + 1;
+
+    // Start the command, which never completes
+    testAssert(readSector(ata, owner) == FileSystem::RetryAgain);
+    testAssert(ata.started == 1);
+
+    // Other requests wait for the command, which re-arms the server timeout
+    ata.setDeadline(50);
+    testAssert(readSector(ata, other) == FileSystem::RetryAgain);
+    testAssert(ata.started == 1);
+    testAssert(ata.resets == 0);
+
+    // The server wakes up without an interrupt
+    for (Size i = 0; i < 100 && server.timeouts == 0; i++)
+    {
+        server.sleep();
+    }
+    testAssert(server.timeouts == 1);
+
+    // The retried request aborts the command
+    testAssert(readSector(ata, owner) == FileSystem::TimedOut);
+    testAssert(ata.resets == 1);
+
+    // The next request starts a new command
+    testAssert(readSector(ata, other) == FileSystem::RetryAgain);
+    testAssert(ata.started == 2);
+    return OK;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2026 Niek Linnenbank
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <FreeNOS/User.h>
+#include <TestRunner.h>
+#include <TestCase.h>
+#include <TestMain.h>
+#include <MemoryBlock.h>
+#include <ByteOrder.h>
+#include <Log.h>
+#include <Storage.h>
+#include <IOBuffer.h>
+#include <FileSystemMessage.h>
+#include <Lz4Compressor.h>
+#include "LinnFileSystem.h"
+#include "LinnFile.h"
+
+/** Block size of the test filesystem */
+#define TEST_BLOCK_SIZE 1024
+
+/** Number of blocks in the test filesystem */
+#define TEST_BLOCK_COUNT 16
+
+/** Block number of the group descriptor table */
+#define TEST_GROUPS_BLOCK 2
+
+/** Block number of the inode table */
+#define TEST_INODES_BLOCK 3
+
+/** First block number of the file data */
+#define TEST_DATA_BLOCK 4
+
+/** Uncompressed size of the test file */
+#define TEST_FILE_SIZE 2048
+
+/**
+ * Storage of a filesystem image in memory.
+ */
+class MemoryStorage : public Storage
+{
+  public:
+
+    MemoryStorage(u8 *image, const Size size)
+        : m_image(image)
+        , m_size(size)
+    {
+    }
+
+    virtual FileSystem::Result initialize()
+    {
+        return FileSystem::Success;
+    }
+
+    virtual FileSystem::Result read(const u64 offset, void *buffer, const Size size) const
+    {
+        if (offset > m_size || size > m_size - offset)
+            return FileSystem::IOError;
+
+        MemoryBlock::copy(buffer, m_image + offset, size);
+        return FileSystem::Success;
+    }
+
+    virtual u64 capacity() const
+    {
+        return m_size;
+    }
+
+  private:
+
+    /** Filesystem image */
+    u8 *m_image;
+
+    /** Size of the image in bytes */
+    const Size m_size;
+};
+
+/** Filesystem image with a compressed file in the data blocks */
+static u8 image[TEST_BLOCK_SIZE * TEST_BLOCK_COUNT];
+
+/** Uncompressed contents of the test file */
+static u8 contents[TEST_FILE_SIZE];
+
+/**
+ * Build a filesystem image with a single compressed chunk.
+ *
+ * @param inode Output inode of the compressed file
+ *
+ * @return Number of compressed bytes in the chunk
+ */
+static Size buildImage(LinnInode *inode)
+{
+    LinnSuperBlock *super = (LinnSuperBlock *) (image + LINN_SUPER_OFFSET);
+    LinnGroup *group = (LinnGroup *) (image + (TEST_GROUPS_BLOCK * TEST_BLOCK_SIZE));
+    u8 *data = image + (TEST_DATA_BLOCK * TEST_BLOCK_SIZE);
+    le32 *offsets = (le32 *) data;
+
+    MemoryBlock::set(image, 0, sizeof(image));
+    MemoryBlock::set(inode, 0, sizeof(*inode));
+
+    // Superblock with a single group
+    super->magic0          = LINN_SUPER_MAGIC0;
+    super->magic1          = LINN_SUPER_MAGIC1;
+    super->blockSize       = TEST_BLOCK_SIZE;
+    super->blocksPerGroup  = TEST_BLOCK_COUNT;
+    super->blocksCount     = TEST_BLOCK_COUNT;
+    super->inodesPerGroup  = 8;
+    super->inodesCount     = 8;
+    super->groupsTable     = TEST_GROUPS_BLOCK;
+    group->inodeTable      = TEST_INODES_BLOCK;
+
+    // The root directory inode is empty
+    ((LinnInode *) (image + (TEST_INODES_BLOCK * TEST_BLOCK_SIZE)))->type = FileSystem::DirectoryFile;
+
+    // Compressible file contents
+    for (Size i = 0; i < sizeof(contents); i++)
+        contents[i] = (i / 64) + (i % 8);
+
+    // Chunk offset table followed by the compressed chunk
+    Lz4Compressor lz4(contents, sizeof(contents));
+    Size compressedSize = (TEST_BLOCK_COUNT - TEST_DATA_BLOCK) * TEST_BLOCK_SIZE - (sizeof(le32) * 2);
+
+    if (lz4.compressBlock(data + (sizeof(le32) * 2), compressedSize) != Lz4Compressor::Success)
+        return 0;
+
+    writeLe32(&offsets[0], sizeof(le32) * 2);
+    writeLe32(&offsets[1], (sizeof(le32) * 2) + compressedSize);
+
+    inode->type  = FileSystem::RegularFile;
+    inode->size  = TEST_FILE_SIZE;
+    inode->flags = LINN_INODE_COMPRESSED;
+
+    for (Size i = 0; i < LINN_INODE_DIR_BLOCKS; i++)
+        inode->block[i] = TEST_DATA_BLOCK + i;
+
+    return compressedSize;
+}
+
+/**
+ * Read the whole test file.
+ *
+ * @param file File to read
+ * @param output Output buffer of TEST_FILE_SIZE bytes
+ *
+ * @return Result code
+ */
+static FileSystem::Result readFile(LinnFile & file, u8 *output)
+{
+    FileSystemMessage msg;
+    Size size = TEST_FILE_SIZE;
+
+    // Unaligned remote buffer, such that the data is gathered in a local buffer
+    MemoryBlock::set(&msg, 0, sizeof(msg));
+    msg.from   = ProcessCtl(SELF, GetPID);
+    msg.action = FileSystem::ReadFile;
+    msg.buffer = (char *) output + 1;
+    msg.size   = size;
+
+    IOBuffer buffer(&msg);
+    const FileSystem::Result result = file.read(buffer, size, 0);
+    if (result == FileSystem::Success)
+    {
+        if (size != TEST_FILE_SIZE)
+            return FileSystem::IOError;
+
+        MemoryBlock::copy(output, buffer.getBuffer(), size);
+    }
+
+    return result;
+}
+
+TestCase(LinnFileReadCompressed)
+{
+    LinnInode inode;
+    u8 output[TEST_FILE_SIZE];
+
+    testAssert(buildImage(&inode) > 0);
+
+    MemoryStorage storage(image, sizeof(image));
+    LinnFileSystem fs("/linntest", &storage);
+    LinnFile file(&fs, 1, &inode);
+
+    testAssert(readFile(file, output) == FileSystem::Success);
+    testAssert(MemoryBlock::compare(output, contents, sizeof(contents)));
+    return OK;
+}
+
+TestCase(LinnFileReadTruncated)
+{
+    LinnInode inode;
+    u8 output[TEST_FILE_SIZE];
+    le32 *offsets = (le32 *) (image + (TEST_DATA_BLOCK * TEST_BLOCK_SIZE));
+    const Size compressedSize = buildImage(&inode);
+
+    testAssert(compressedSize > 1);
+
+    // Mask error output
+    Log::instance()->setMinimumLogLevel(Log::Critical);
+
+    // Drop the last byte of the compressed chunk
+    writeLe32(&offsets[1], (sizeof(le32) * 2) + compressedSize - 1);
+
+    MemoryStorage storage(image, sizeof(image));
+    LinnFileSystem fs("/linntest", &storage);
+    LinnFile file(&fs, 1, &inode);
+
+    testAssert(readFile(file, output) == FileSystem::IOError);
+    return OK;
+}
+
+TestCase(LinnFileReadCorrupt)
+{
+    LinnInode inode;
+    u8 output[TEST_FILE_SIZE];
+    u8 *chunk = image + (TEST_DATA_BLOCK * TEST_BLOCK_SIZE) + (sizeof(le32) * 2);
+
+    testAssert(buildImage(&inode) > 0);
+
+    // Mask error output
+    Log::instance()->setMinimumLogLevel(Log::Critical);
+
+    // One literal followed by a match far before the start of the output
+    chunk[0] = 0x1f;
+    chunk[1] = 0xaa;
+    chunk[2] = 0xff;
+    chunk[3] = 0xff;
+    chunk[4] = 0x00;
+
+    MemoryStorage storage(image, sizeof(image));
+    LinnFileSystem fs("/linntest", &storage);
+    LinnFile file(&fs, 1, &inode);
+
+    testAssert(readFile(file, output) == FileSystem::IOError);
+    return OK;
+}
@@ -29,6 +29,7 @@
 #include <ProcessClient.h>
 #include <RecoveryClient.h>
 #include <FileSystemClient.h>
+#include <MemoryBlock.h>
 
 TestCase(TmpFileSystemReadWrite)
 {
@@ -82,6 +83,91 @@ TestCase(TmpFileSystemReadWrite)
     return OK;
 }
 
+TestCase(TmpFileSystemSparseTruncate)
+{
+    const char *path = "/tmp/sparse.txt";
+    const char *data = "end";
+    const FileSystemClient fs;
+    char buf[128];
+    Size sz = String::length(data);
+    Size descriptor = 3;
+    FileSystem::FileStat st;
+
+    // Create new file
+    testAssert(fs.createFile(path, FileSystem::RegularFile, FileSystem::OwnerRW) == FileSystem::Success);
+    testAssert(fs.openFile(path, descriptor) == FileSystem::Success);
+
+    // Write beyond the end of the file, leaving a hole
+    testAssert(fs.writeFile(descriptor, data, &sz, 10000) == FileSystem::Success);
+    testAssert(sz == String::length(data));
+    testAssert(fs.statFile(path, &st) == FileSystem::Success);
+    testAssert(st.size == 10003);
+
+    // The hole reads as zero bytes
+    sz = sizeof(buf);
+    testAssert(fs.readFile(descriptor, buf, &sz, 4000) == FileSystem::Success);
+    testAssert(sz == sizeof(buf));
+    for (Size i = 0; i < sz; i++)
+    {
+        testAssert(buf[i] == 0);
+    }
+
+    // Read the data after the hole
+    sz = sizeof(buf);
+    testAssert(fs.readFile(descriptor, buf, &sz, 10000) == FileSystem::Success);
+    testAssert(sz == String::length(data));
+    buf[sz] = ZERO;
+    testString(buf, data);
+
+    // Shrink the file
+    testAssert(fs.truncateFile(descriptor, 5000) == FileSystem::Success);
+    testAssert(fs.statFile(path, &st) == FileSystem::Success);
+    testAssert(st.size == 5000);
+
+    // Grow the file again: the data written before is discarded
+    testAssert(fs.truncateFile(descriptor, 10003) == FileSystem::Success);
+    sz = sizeof(buf);
+    testAssert(fs.readFile(descriptor, buf, &sz, 10000) == FileSystem::Success);
+    testAssert(sz == String::length(data));
+    testAssert(buf[0] == 0 && buf[1] == 0 && buf[2] == 0);
+
+    // Cleanup
+    testAssert(fs.deleteFile(path) == FileSystem::Success);
+    return OK;
+}
+
+TestCase(TmpFileSystemMapFile)
+{
+    const char *path = "/tmp/mapped.txt";
+    const char *data = "mapped data";
+    const FileSystemClient fs;
+    Size sz = String::length(data);
+    Size descriptor = 3;
+    Memory::Range range;
+
+    // Create new file
+    testAssert(fs.createFile(path, FileSystem::RegularFile, FileSystem::OwnerRW) == FileSystem::Success);
+    testAssert(fs.openFile(path, descriptor) == FileSystem::Success);
+    testAssert(fs.writeFile(descriptor, data, &sz, 0) == FileSystem::Success);
+
+    // Map the first page of the file
+    range.virt   = ZERO;
+    range.phys   = ZERO;
+    range.size   = PAGESIZE;
+    range.access = Memory::User | Memory::Readable;
+    testAssert(VMCtl(SELF, MapLazy, &range) == API::Success);
+    testAssert(fs.mapFile(descriptor, range.virt, PAGESIZE, 0) == FileSystem::Success);
+    testAssert(MemoryBlock::compare((const void *) range.virt, data, String::length(data)));
+
+    // The page remains valid after the file is deleted
+    testAssert(fs.deleteFile(path) == FileSystem::Success);
+    testAssert(MemoryBlock::compare((const void *) range.virt, data, String::length(data)));
+
+    // Releasing the mapping frees the page
+    testAssert(VMCtl(SELF, Release, &range) == API::Success);
+    return OK;
+}
+
 TestCase(TmpFileSystemRestart)
 {
     // Find PID first